@@ -0,0 +1,243 @@
+/**
+*	@file : AddressableMinMaxHeap.h
+*	@author :  Haaris Chaudhry
+*	@date : Mar 9, 2017
+*	Purpose: A min-max heap whose values can be reached after they were inserted.  insert returns a
+*          Handle, and the value behind it can be read, given a new key or erased in O(log n) while it
+*          is anywhere in the heap.
+*
+*          Every value is stored next to the number of its handle slot, and the heap's Store writes the
+*          value's new heap index into that slot on every move, put and exchange the engine makes, so
+*          handles stay valid however the sift routines shuffle the array.  A handle slot is reused
+*          once its value leaves the heap, the slot's generation tells the old handle apart.
+*/
+
+#ifndef ADDRESSABLE_MIN_MAX_HEAP_H
+#define ADDRESSABLE_MIN_MAX_HEAP_H
+
+#include "MinMaxHeapEngine.h"
+#include <functional>
+#include <memory>
+#include <vector>
+
+template <class T, class Compare = std::less<T>, class Allocator = std::allocator<T> >
+class AddressableMinMaxHeap
+{
+public:
+    typedef T value_type;
+    typedef Compare value_compare;
+    typedef Allocator allocator_type;
+
+    /**
+    * Refers to one inserted value until it leaves the heap
+    */
+    class Handle
+    {
+    public:
+        /**
+        * @return A handle that refers to no value
+        */
+        Handle();
+
+        bool operator==( const Handle& aOther ) const;
+        bool operator!=( const Handle& aOther ) const;
+
+    private:
+        friend class AddressableMinMaxHeap;
+
+        Handle( long aSlot, long aGeneration );
+
+        long mSlot;         //!< The handle slot, -1 for no value
+        long mGeneration;   //!< The slot's generation when the handle was issued
+    };
+
+    /**
+    * Constructor for the AddressableMinMaxHeap
+    * @param aSize The initial capacity of the heap
+    * @param aCompare The strict weak ordering used to compare values
+    * @return An empty heap able to hold aSize values before growing
+    */
+    explicit AddressableMinMaxHeap( long aSize = 0, const Compare& aCompare = Compare() );
+
+    /**
+    * The insertion function, also heapifies the value
+    * @param aValue The value to be inserted
+    * @return The handle of the value
+    */
+    Handle insert( const T& aValue );
+
+    Handle insert( T&& aValue );
+
+    /**
+    * Deletes the minimum value, its handle becomes stale
+    * @return The value that was deleted (throws PrecondViolatedExcep if the heap is empty)
+    */
+    T deleteMin();
+
+    /**
+    * Deletes the maximum value, its handle becomes stale
+    * @return The value that was deleted (throws PrecondViolatedExcep if the heap is empty)
+    */
+    T deleteMax();
+
+    /**
+    * Reads the minimum value without removing it
+    * @return The minimum value (throws PrecondViolatedExcep if the heap is empty)
+    */
+    const T& peekMin() const;
+
+    /**
+    * Reads the maximum value without removing it
+    * @return The maximum value (throws PrecondViolatedExcep if the heap is empty)
+    */
+    const T& peekMax() const;
+
+    /**
+    * @return The handle of the minimum value (throws PrecondViolatedExcep if the heap is empty)
+    */
+    Handle minHandle() const;
+
+    /**
+    * @return The handle of the maximum value (throws PrecondViolatedExcep if the heap is empty)
+    */
+    Handle maxHandle() const;
+
+    /**
+    * @return True if aHandle still refers to a value in the heap
+    */
+    bool contains( const Handle& aHandle ) const;
+
+    /**
+    * Reads the value behind a handle
+    * @return The value (throws PrecondViolatedExcep if the handle is stale)
+    */
+    const T& value( const Handle& aHandle ) const;
+
+    /**
+    * Replaces the value behind a handle and moves it up or down to its new spot, O(log n).
+    * The key may go either way, the value is trickled down through its own kind of level and then
+    * bubbled up along the min or max levels above wherever it stopped.
+    * @param aHandle The value to change, it keeps its handle (throws PrecondViolatedExcep if stale)
+    * @param aValue The new value
+    */
+    void updateKey( const Handle& aHandle, T aValue );
+
+    /**
+    * Deletes the value behind a handle, O(log n)
+    * @param aHandle The value to delete, the handle becomes stale (throws PrecondViolatedExcep if stale)
+    * @return The value that was deleted
+    */
+    T erase( const Handle& aHandle );
+
+    /**
+    * Function that indicates if the heap is empty
+    * @return True if empty, false if not
+    */
+    bool isEmpty() const;
+
+    /**
+    * @return The number of values in the heap
+    */
+    long size() const;
+
+    /**
+    * Makes sure the heap can hold at least aCapacity values without growing
+    * @param aCapacity The requested capacity
+    */
+    void reserve( long aCapacity );
+
+    /**
+    * Removes every value, every handle becomes stale
+    */
+    void clear();
+
+private:
+    /**
+    * A value and the handle slot that follows it around
+    */
+    struct Entry
+    {
+        Entry( T&& aValue, long aSlot );
+
+        T mValue;
+        long mSlot;
+    };
+
+    /**
+    * Where a handle's value is, and how often the slot was reused
+    */
+    struct Slot
+    {
+        long mPosition;     //!< The heap index of the value, 0 while the slot is free
+        long mGeneration;   //!< Incremented every time the slot is freed
+    };
+
+    typedef typename std::allocator_traits<Allocator>::template rebind_alloc<Entry> EntryAllocator;
+    typedef typename std::allocator_traits<Allocator>::template rebind_alloc<Slot> SlotAllocator;
+
+    /**
+    * The engine's view of the heap. Every write updates the position of the value's handle slot.
+    */
+    class Store
+    {
+    public:
+        typedef T Key;
+        typedef Entry Held;
+
+        Store( Entry* aArray, Slot* aSlots, const Compare& aCompare );
+
+        const T& key( long aIndex ) const;
+        const T& keyOf( const Entry& aHeld ) const;
+        bool less( const T& aLeft, const T& aRight ) const;
+        Entry take( long aIndex );
+        void move( long aFrom, long aTo );
+        void put( long aIndex, Entry&& aHeld );
+        void exchange( long aIndex, Entry& aHeld );
+
+    private:
+        Entry* mArray;          //!< The first entry, heap index i lives in entry i - 1
+        Slot* mSlots;           //!< The handle slots
+        const Compare& mCompare;
+    };
+
+    AddressableMinMaxHeap( const AddressableMinMaxHeap& );
+    AddressableMinMaxHeap& operator=( const AddressableMinMaxHeap& );
+
+    /**
+    * Appends a value with a fresh handle and bubbles it up
+    */
+    Handle push( T&& aValue );
+
+    /**
+    * @return The heap index of a live handle (throws PrecondViolatedExcep naming aOperation if stale)
+    */
+    long positionOf( const Handle& aHandle, const char* aOperation ) const;
+
+    /**
+    * Removes the value at a heap index, carrying the last value into its hole
+    */
+    T removeAt( long aIndex );
+
+    /**
+    * Trickles the value at aIndex down, then bubbles it up from wherever it stopped
+    */
+    void sift( long aIndex );
+
+    /**
+    * Frees the handle slot of a value that left the heap
+    */
+    void release( long aSlot );
+
+    /**
+    * @return The engine's view of the heap
+    */
+    Store store() const;
+
+    Compare mCompare;                               //!< The ordering of the heap values
+    std::vector<Entry, EntryAllocator> mEntries;    //!< The heap array
+    std::vector<Slot, SlotAllocator> mSlots;        //!< One per handle ever needed at once
+    std::vector<long> mFreeSlots;                   //!< Slots whose values left the heap
+};
+
+#include "AddressableMinMaxHeap.hpp"
+#endif // !ADDRESSABLE_MIN_MAX_HEAP_H
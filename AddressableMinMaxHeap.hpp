@@ -0,0 +1,340 @@
+/**
+*	@file : AddressableMinMaxHeap.hpp
+*	@author :  Haaris Chaudhry
+*	@date : Mar 9, 2017
+*	Purpose: Implementation of the AddressableMinMaxHeap class template.
+*/
+
+#include "PrecondViolatedExcep.h"
+#include <string>
+#include <utility>
+
+template <class T, class Compare, class Allocator>
+AddressableMinMaxHeap<T, Compare, Allocator>::Handle::Handle() :
+    mSlot( -1 ),
+    mGeneration( 0 )
+{
+}
+
+template <class T, class Compare, class Allocator>
+AddressableMinMaxHeap<T, Compare, Allocator>::Handle::Handle( long aSlot, long aGeneration ) :
+    mSlot( aSlot ),
+    mGeneration( aGeneration )
+{
+}
+
+template <class T, class Compare, class Allocator>
+bool AddressableMinMaxHeap<T, Compare, Allocator>::Handle::operator==( const Handle& aOther ) const
+{
+    return ( mSlot == aOther.mSlot && mGeneration == aOther.mGeneration );
+}
+
+template <class T, class Compare, class Allocator>
+bool AddressableMinMaxHeap<T, Compare, Allocator>::Handle::operator!=( const Handle& aOther ) const
+{
+    return !( *this == aOther );
+}
+
+template <class T, class Compare, class Allocator>
+AddressableMinMaxHeap<T, Compare, Allocator>::Entry::Entry( T&& aValue, long aSlot ) :
+    mValue( std::move( aValue ) ),
+    mSlot( aSlot )
+{
+}
+
+template <class T, class Compare, class Allocator>
+AddressableMinMaxHeap<T, Compare, Allocator>::Store::Store( Entry* aArray, Slot* aSlots, const Compare& aCompare ) :
+    mArray( aArray ),
+    mSlots( aSlots ),
+    mCompare( aCompare )
+{
+}
+
+template <class T, class Compare, class Allocator>
+const T& AddressableMinMaxHeap<T, Compare, Allocator>::Store::key( long aIndex ) const
+{
+    return mArray[aIndex - 1].mValue;
+}
+
+template <class T, class Compare, class Allocator>
+const T& AddressableMinMaxHeap<T, Compare, Allocator>::Store::keyOf( const Entry& aHeld ) const
+{
+    return aHeld.mValue;
+}
+
+template <class T, class Compare, class Allocator>
+bool AddressableMinMaxHeap<T, Compare, Allocator>::Store::less( const T& aLeft, const T& aRight ) const
+{
+    return mCompare( aLeft, aRight );
+}
+
+// A value in the hole keeps its old position until it is put down again
+template <class T, class Compare, class Allocator>
+typename AddressableMinMaxHeap<T, Compare, Allocator>::Entry AddressableMinMaxHeap<T, Compare, Allocator>::Store::take( long aIndex )
+{
+    return std::move( mArray[aIndex - 1] );
+}
+
+template <class T, class Compare, class Allocator>
+void AddressableMinMaxHeap<T, Compare, Allocator>::Store::move( long aFrom, long aTo )
+{
+    mArray[aTo - 1] = std::move( mArray[aFrom - 1] );
+    mSlots[mArray[aTo - 1].mSlot].mPosition = aTo;
+}
+
+template <class T, class Compare, class Allocator>
+void AddressableMinMaxHeap<T, Compare, Allocator>::Store::put( long aIndex, Entry&& aHeld )
+{
+    mArray[aIndex - 1] = std::move( aHeld );
+    mSlots[mArray[aIndex - 1].mSlot].mPosition = aIndex;
+}
+
+template <class T, class Compare, class Allocator>
+void AddressableMinMaxHeap<T, Compare, Allocator>::Store::exchange( long aIndex, Entry& aHeld )
+{
+    using std::swap;
+    swap( mArray[aIndex - 1], aHeld );
+    mSlots[mArray[aIndex - 1].mSlot].mPosition = aIndex;
+}
+
+template <class T, class Compare, class Allocator>
+AddressableMinMaxHeap<T, Compare, Allocator>::AddressableMinMaxHeap( long aSize, const Compare& aCompare ) :
+    mCompare( aCompare )
+{
+    reserve( aSize );
+}
+
+template <class T, class Compare, class Allocator>
+typename AddressableMinMaxHeap<T, Compare, Allocator>::Handle AddressableMinMaxHeap<T, Compare, Allocator>::insert( const T& aValue )
+{
+    return push( T( aValue ) );
+}
+
+template <class T, class Compare, class Allocator>
+typename AddressableMinMaxHeap<T, Compare, Allocator>::Handle AddressableMinMaxHeap<T, Compare, Allocator>::insert( T&& aValue )
+{
+    return push( std::move( aValue ) );
+}
+
+template <class T, class Compare, class Allocator>
+typename AddressableMinMaxHeap<T, Compare, Allocator>::Handle AddressableMinMaxHeap<T, Compare, Allocator>::push( T&& aValue )
+{
+    long slot = 0;
+
+    if( mFreeSlots.empty() )
+    {
+        Slot fresh = { 0, 0 };
+        mSlots.push_back( fresh );
+        slot = static_cast<long>( mSlots.size() ) - 1;
+    }
+    else
+    {
+        slot = mFreeSlots.back();
+        mFreeSlots.pop_back();
+    }
+
+    try
+    {
+        mEntries.emplace_back( std::move( aValue ), slot );
+    }
+    catch( ... )
+    {
+        mFreeSlots.push_back( slot );
+        throw;
+    }
+
+    long numNodes = size();
+    mSlots[slot].mPosition = numNodes;
+    Store heapStore = store();
+    MinMaxHeapEngine::bubbleUp( heapStore, numNodes );
+    return Handle( slot, mSlots[slot].mGeneration );
+}
+
+template <class T, class Compare, class Allocator>
+T AddressableMinMaxHeap<T, Compare, Allocator>::deleteMin()
+{
+    if( isEmpty() )
+    {
+        throw PrecondViolatedExcep( "deleteMin attempted on an empty heap" );
+    }
+
+    return removeAt( 1 );
+}
+
+template <class T, class Compare, class Allocator>
+T AddressableMinMaxHeap<T, Compare, Allocator>::deleteMax()
+{
+    if( isEmpty() )
+    {
+        throw PrecondViolatedExcep( "deleteMax attempted on an empty heap" );
+    }
+
+    return removeAt( MinMaxHeapEngine::maxIndex( store(), size() ) );
+}
+
+template <class T, class Compare, class Allocator>
+const T& AddressableMinMaxHeap<T, Compare, Allocator>::peekMin() const
+{
+    if( isEmpty() )
+    {
+        throw PrecondViolatedExcep( "peekMin attempted on an empty heap" );
+    }
+
+    return mEntries[0].mValue;
+}
+
+template <class T, class Compare, class Allocator>
+const T& AddressableMinMaxHeap<T, Compare, Allocator>::peekMax() const
+{
+    if( isEmpty() )
+    {
+        throw PrecondViolatedExcep( "peekMax attempted on an empty heap" );
+    }
+
+    return mEntries[MinMaxHeapEngine::maxIndex( store(), size() ) - 1].mValue;
+}
+
+template <class T, class Compare, class Allocator>
+typename AddressableMinMaxHeap<T, Compare, Allocator>::Handle AddressableMinMaxHeap<T, Compare, Allocator>::minHandle() const
+{
+    if( isEmpty() )
+    {
+        throw PrecondViolatedExcep( "minHandle attempted on an empty heap" );
+    }
+
+    long slot = mEntries[0].mSlot;
+    return Handle( slot, mSlots[slot].mGeneration );
+}
+
+template <class T, class Compare, class Allocator>
+typename AddressableMinMaxHeap<T, Compare, Allocator>::Handle AddressableMinMaxHeap<T, Compare, Allocator>::maxHandle() const
+{
+    if( isEmpty() )
+    {
+        throw PrecondViolatedExcep( "maxHandle attempted on an empty heap" );
+    }
+
+    long slot = mEntries[MinMaxHeapEngine::maxIndex( store(), size() ) - 1].mSlot;
+    return Handle( slot, mSlots[slot].mGeneration );
+}
+
+template <class T, class Compare, class Allocator>
+bool AddressableMinMaxHeap<T, Compare, Allocator>::contains( const Handle& aHandle ) const
+{
+    return ( aHandle.mSlot >= 0 && aHandle.mSlot < static_cast<long>( mSlots.size() )
+             && mSlots[aHandle.mSlot].mGeneration == aHandle.mGeneration && mSlots[aHandle.mSlot].mPosition != 0 );
+}
+
+template <class T, class Compare, class Allocator>
+long AddressableMinMaxHeap<T, Compare, Allocator>::positionOf( const Handle& aHandle, const char* aOperation ) const
+{
+    if( !contains( aHandle ) )
+    {
+        throw PrecondViolatedExcep( std::string( aOperation ) + " attempted with a stale handle" );
+    }
+
+    return mSlots[aHandle.mSlot].mPosition;
+}
+
+template <class T, class Compare, class Allocator>
+const T& AddressableMinMaxHeap<T, Compare, Allocator>::value( const Handle& aHandle ) const
+{
+    return mEntries[positionOf( aHandle, "value" ) - 1].mValue;
+}
+
+template <class T, class Compare, class Allocator>
+void AddressableMinMaxHeap<T, Compare, Allocator>::updateKey( const Handle& aHandle, T aValue )
+{
+    long index = positionOf( aHandle, "updateKey" );
+    mEntries[index - 1].mValue = std::move( aValue );
+    sift( index );
+}
+
+template <class T, class Compare, class Allocator>
+T AddressableMinMaxHeap<T, Compare, Allocator>::erase( const Handle& aHandle )
+{
+    return removeAt( positionOf( aHandle, "erase" ) );
+}
+
+// The last value is carried into the hole, which may be anywhere in the tree, so unlike a pop it can
+// belong above the hole as well as below it
+template <class T, class Compare, class Allocator>
+T AddressableMinMaxHeap<T, Compare, Allocator>::removeAt( long aIndex )
+{
+    Store heapStore = store();
+    long numNodes = size();
+    Entry removed = heapStore.take( aIndex );
+
+    if( aIndex == numNodes )
+    {
+        mEntries.pop_back();
+    }
+    else
+    {
+        Entry last = heapStore.take( numNodes );
+        mEntries.pop_back();
+        heapStore.put( aIndex, std::move( last ) );
+        sift( aIndex );
+    }
+
+    release( removed.mSlot );
+    return std::move( removed.mValue );
+}
+
+// Trickling down first leaves the value either where it was, if it was already in order with its
+// descendants, or on a level of its kind whose parent bounds it, so the bubble up from there can only
+// move it along the min or max levels above and never has to push a value back down
+template <class T, class Compare, class Allocator>
+void AddressableMinMaxHeap<T, Compare, Allocator>::sift( long aIndex )
+{
+    Store heapStore = store();
+    long slot = mEntries[aIndex - 1].mSlot;
+    MinMaxHeapEngine::trickleDown( heapStore, aIndex, size() );
+    MinMaxHeapEngine::bubbleUp( heapStore, mSlots[slot].mPosition );
+}
+
+template <class T, class Compare, class Allocator>
+void AddressableMinMaxHeap<T, Compare, Allocator>::release( long aSlot )
+{
+    mSlots[aSlot].mPosition = 0;
+    mSlots[aSlot].mGeneration++;
+    mFreeSlots.push_back( aSlot );
+}
+
+template <class T, class Compare, class Allocator>
+bool AddressableMinMaxHeap<T, Compare, Allocator>::isEmpty() const
+{
+    return mEntries.empty();
+}
+
+template <class T, class Compare, class Allocator>
+long AddressableMinMaxHeap<T, Compare, Allocator>::size() const
+{
+    return static_cast<long>( mEntries.size() );
+}
+
+template <class T, class Compare, class Allocator>
+void AddressableMinMaxHeap<T, Compare, Allocator>::reserve( long aCapacity )
+{
+    mEntries.reserve( aCapacity );
+    mSlots.reserve( aCapacity );
+    mFreeSlots.reserve( aCapacity );
+}
+
+template <class T, class Compare, class Allocator>
+void AddressableMinMaxHeap<T, Compare, Allocator>::clear()
+{
+    for( size_t i = 0; i < mEntries.size(); i++ )
+    {
+        release( mEntries[i].mSlot );
+    }
+
+    mEntries.clear();
+}
+
+// The Store writes through the arrays, the const members only ever read through it
+template <class T, class Compare, class Allocator>
+typename AddressableMinMaxHeap<T, Compare, Allocator>::Store AddressableMinMaxHeap<T, Compare, Allocator>::store() const
+{
+    return Store( const_cast<Entry*>( mEntries.data() ), const_cast<Slot*>( mSlots.data() ), mCompare );
+}
@@ -0,0 +1,157 @@
+/**
+*	@file : AddressableMinMaxHeapTest.cpp
+*	@author :  Haaris Chaudhry
+*	@date : Mar 9, 2017
+*	Purpose: Checks AddressableMinMaxHeap against a list of live handles and their values through random
+*          inserts, deletes from both ends, key updates in both directions and erases by handle, and
+*          that a handle goes stale once its value leaves, even after its slot is reused.
+*/
+
+#include "AddressableMinMaxHeap.h"
+#include "MinMaxTest.h"
+#include <algorithm>
+#include <random>
+#include <string>
+#include <utility>
+#include <vector>
+
+namespace
+{
+    typedef AddressableMinMaxHeap<long> Heap;
+    typedef std::vector<std::pair<Heap::Handle, long> > Live;
+
+    bool byValue( const std::pair<Heap::Handle, long>& aLeft, const std::pair<Heap::Handle, long>& aRight )
+    {
+        return aLeft.second < aRight.second;
+    }
+
+    void checkReference( const MinMaxTest::Run& aRun, const Heap& aHeap, const Live& aLive )
+    {
+        if( !MINMAX_CHECK_EQUAL( aRun, aHeap.size(), static_cast<long>( aLive.size() ) ) )
+        {
+            return;
+        }
+
+        for( size_t i = 0; i < aLive.size(); i++ )
+        {
+            if( !MINMAX_CHECK_STEP( aRun, aHeap.contains( aLive[i].first ) ) || !MINMAX_CHECK_EQUAL( aRun, aHeap.value( aLive[i].first ), aLive[i].second ) )
+            {
+                return;
+            }
+        }
+
+        if( !aLive.empty() )
+        {
+            MINMAX_CHECK_EQUAL( aRun, aHeap.peekMin(), std::min_element( aLive.begin(), aLive.end(), byValue )->second )
+                && MINMAX_CHECK_EQUAL( aRun, aHeap.peekMax(), std::max_element( aLive.begin(), aLive.end(), byValue )->second )
+                && MINMAX_CHECK_EQUAL( aRun, aHeap.value( aHeap.minHandle() ), aHeap.peekMin() )
+                && MINMAX_CHECK_EQUAL( aRun, aHeap.value( aHeap.maxHandle() ), aHeap.peekMax() );
+        }
+    }
+
+    void runAgainstReference( long aRange, unsigned long aSeed )
+    {
+        Heap heap;
+        Live live;
+        std::vector<Heap::Handle> gone;
+
+        MinMaxTest::runSteps( "range " + std::to_string( aRange ), aSeed, 5000, [&]( std::mt19937& aRandom, const MinMaxTest::Run& aRun )
+        {
+            long choice = static_cast<long>( aRandom() % 12 );
+            long value = static_cast<long>( aRandom() % aRange );
+
+            if( choice < 4 || live.empty() )
+            {
+                live.push_back( std::make_pair( heap.insert( value ), value ) );
+            }
+            else if( choice < 8 )
+            {
+                // Half the updates move the key down and half move it up
+                Live::iterator target = live.begin() + static_cast<long>( aRandom() % live.size() );
+                target->second += ( choice < 6 ) ? -value : value;
+                heap.updateKey( target->first, target->second );
+            }
+            else if( choice < 10 )
+            {
+                Live::iterator target = live.begin() + static_cast<long>( aRandom() % live.size() );
+                long expected = target->second;
+                gone.push_back( target->first );
+                live.erase( target );
+
+                if( !MINMAX_CHECK_EQUAL( aRun, heap.erase( gone.back() ), expected ) )
+                {
+                    return;
+                }
+            }
+            else
+            {
+                Live::iterator end = ( choice == 10 ) ? std::min_element( live.begin(), live.end(), byValue )
+                                                      : std::max_element( live.begin(), live.end(), byValue );
+                long removed = ( choice == 10 ) ? heap.deleteMin() : heap.deleteMax();
+
+                if( !MINMAX_CHECK_EQUAL( aRun, removed, end->second ) )
+                {
+                    return;
+                }
+
+                // Equal values may leave in either order, the one that left is no longer contained
+                for( Live::iterator it = live.begin(); it != live.end(); ++it )
+                {
+                    if( it->second == removed && !heap.contains( it->first ) )
+                    {
+                        end = it;
+                        break;
+                    }
+                }
+
+                gone.push_back( end->first );
+                live.erase( end );
+            }
+
+            checkReference( aRun, heap, live );
+        } );
+
+        bool allStale = true;
+
+        for( size_t i = 0; i < gone.size(); i++ )
+        {
+            allStale = allStale && !heap.contains( gone[i] );
+        }
+
+        MINMAX_CHECK( allStale );
+    }
+}
+
+int main()
+{
+    runAgainstReference( 1L << 30, 2017 );
+    runAgainstReference( 20, 2018 );
+    runAgainstReference( 1, 2019 );
+
+    // An erased value's slot is handed to the next insert, the old handle must not see the new value
+    Heap heap;
+    Heap::Handle first = heap.insert( 10 );
+    Heap::Handle second = heap.insert( 20 );
+    MINMAX_CHECK( heap.erase( first ) == 10 );
+    Heap::Handle reused = heap.insert( 30 );
+    MINMAX_CHECK( !heap.contains( first ) );
+    MINMAX_CHECK( heap.contains( reused ) && heap.value( reused ) == 30 );
+    MINMAX_CHECK( first != reused );
+    MINMAX_CHECK_THROWS( heap.value( first ) );
+    MINMAX_CHECK_THROWS( heap.updateKey( first, 5 ) );
+    MINMAX_CHECK_THROWS( heap.erase( first ) );
+    MINMAX_CHECK( heap.peekMin() == 20 && heap.peekMax() == 30 );
+
+    heap.updateKey( second, 40 );
+    MINMAX_CHECK( heap.maxHandle() == second && heap.minHandle() == reused );
+    heap.updateKey( second, 0 );
+    MINMAX_CHECK( heap.minHandle() == second && heap.maxHandle() == reused );
+
+    MINMAX_CHECK( !heap.contains( Heap::Handle() ) );
+    heap.clear();
+    MINMAX_CHECK( heap.isEmpty() && !heap.contains( second ) && !heap.contains( reused ) );
+    MINMAX_CHECK_THROWS( heap.deleteMin() );
+    MINMAX_CHECK_THROWS( heap.maxHandle() );
+
+    return MinMaxTest::report( "AddressableMinMaxHeapTest" );
+}
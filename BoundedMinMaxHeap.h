@@ -0,0 +1,138 @@
+/**
+*	@file : BoundedMinMaxHeap.h
+*	@author :  Haaris Chaudhry
+*	@date : Mar 9, 2017
+*	Purpose: A MinMaxHeap that never holds more than a fixed number of values.  Once it is full every
+*          insert evicts one value according to the retention policy, through pushPopMin or
+*          pushPopMax, so the insert and the eviction together cost a single trickle down at most,
+*          and none at all when the new value is the one evicted.  The array is reserved up front,
+*          so inserts never allocate.
+*/
+
+#ifndef BOUNDED_MIN_MAX_HEAP_H
+#define BOUNDED_MIN_MAX_HEAP_H
+
+#include "MinMaxHeap.h"
+#include <functional>
+#include <memory>
+
+template <class T, class Compare = std::less<T>, class Allocator = std::allocator<T> >
+class BoundedMinMaxHeap
+{
+public:
+    typedef T value_type;
+    typedef Compare value_compare;
+    typedef Allocator allocator_type;
+
+    /**
+    * Which values a full heap keeps
+    */
+    enum Retention
+    {
+        KEEP_LARGEST,   //!< Evicts the minimum, a top-K
+        KEEP_SMALLEST,  //!< Evicts the maximum, a bottom-K
+        KEEP_MIDDLE     //!< Evicts the minimum and the maximum in turn, trimming both tails evenly
+    };
+
+    /**
+    * Constructor for the BoundedMinMaxHeap
+    * @param aBound The most values the heap holds, at least 1 (throws PrecondViolatedExcep otherwise)
+    * @param aRetention Which values to keep once the heap is full
+    * @param aCompare The strict weak ordering used to compare values
+    * @return An empty heap with room for aBound values
+    */
+    BoundedMinMaxHeap( long aBound, Retention aRetention, const Compare& aCompare = Compare() );
+
+    /**
+    * Inserts a value, evicting one if the heap is full, possibly aValue itself
+    * @param aValue The value to be inserted
+    */
+    void insert( T aValue );
+
+    /**
+    * Inserts a value, evicting one if the heap is full, possibly aValue itself
+    * @param aValue The value to be inserted
+    * @param aEvicted Receives the evicted value
+    * @return True if a value was evicted
+    */
+    bool insert( T aValue, T& aEvicted );
+
+    /**
+    * Deletes the minimum value
+    * @return The value that was deleted (throws PrecondViolatedExcep if the heap is empty)
+    */
+    T deleteMin();
+
+    /**
+    * Deletes the maximum value
+    * @return The value that was deleted (throws PrecondViolatedExcep if the heap is empty)
+    */
+    T deleteMax();
+
+    /**
+    * Reads the minimum value without removing it
+    * @return The minimum value (throws PrecondViolatedExcep if the heap is empty)
+    */
+    const T& peekMin() const;
+
+    /**
+    * Reads the maximum value without removing it
+    * @return The maximum value (throws PrecondViolatedExcep if the heap is empty)
+    */
+    const T& peekMax() const;
+
+    /**
+    * @return The retained values, for the read only MinMaxHeap operations
+    */
+    const MinMaxHeap<T, Compare, Allocator>& heap() const;
+
+    /**
+    * Function that indicates if the heap is empty
+    * @return True if empty, false if not
+    */
+    bool isEmpty() const;
+
+    /**
+    * Function that indicates if the next insert evicts
+    * @return True if full, false if not
+    */
+    bool isFull() const;
+
+    /**
+    * @return The number of values in the heap
+    */
+    long size() const;
+
+    /**
+    * @return The most values the heap holds
+    */
+    long bound() const;
+
+    /**
+    * @return Which values a full heap keeps
+    */
+    Retention retention() const;
+
+    /**
+    * Removes every value, the bound and the reserved array are kept
+    */
+    void clear();
+
+private:
+    BoundedMinMaxHeap( const BoundedMinMaxHeap& );
+    BoundedMinMaxHeap& operator=( const BoundedMinMaxHeap& );
+
+    /**
+    * Inserts into a full heap
+    * @return The value evicted
+    */
+    T evict( T&& aValue );
+
+    MinMaxHeap<T, Compare, Allocator> mHeap;    //!< The retained values
+    long mBound;                                //!< The most values mHeap holds
+    Retention mRetention;                       //!< Which values are kept
+    bool mEvictMax;                             //!< For KEEP_MIDDLE, the side the next eviction takes
+};
+
+#include "BoundedMinMaxHeap.hpp"
+#endif // !BOUNDED_MIN_MAX_HEAP_H
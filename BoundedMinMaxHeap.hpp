@@ -0,0 +1,134 @@
+/**
+*	@file : BoundedMinMaxHeap.hpp
+*	@author :  Haaris Chaudhry
+*	@date : Mar 9, 2017
+*	Purpose: Implementation of the BoundedMinMaxHeap class template.
+*/
+
+#include "PrecondViolatedExcep.h"
+#include <utility>
+
+template <class T, class Compare, class Allocator>
+BoundedMinMaxHeap<T, Compare, Allocator>::BoundedMinMaxHeap( long aBound, Retention aRetention, const Compare& aCompare ) :
+    mHeap( ( aBound > 0 ) ? aBound : 0, aCompare ),
+    mBound( aBound ),
+    mRetention( aRetention ),
+    mEvictMax( false )
+{
+    if( mBound < 1 )
+    {
+        throw PrecondViolatedExcep( "Bounded heap needs a bound of at least 1" );
+    }
+}
+
+template <class T, class Compare, class Allocator>
+void BoundedMinMaxHeap<T, Compare, Allocator>::insert( T aValue )
+{
+    if( mHeap.size() < mBound )
+    {
+        mHeap.insert( std::move( aValue ) );
+    }
+    else
+    {
+        evict( std::move( aValue ) );
+    }
+}
+
+template <class T, class Compare, class Allocator>
+bool BoundedMinMaxHeap<T, Compare, Allocator>::insert( T aValue, T& aEvicted )
+{
+    if( mHeap.size() < mBound )
+    {
+        mHeap.insert( std::move( aValue ) );
+        return false;
+    }
+
+    aEvicted = evict( std::move( aValue ) );
+    return true;
+}
+
+// A KEEP_MIDDLE eviction counts for its side even when the new value is the one handed back, so the
+// two tails lose values in strict turns
+template <class T, class Compare, class Allocator>
+T BoundedMinMaxHeap<T, Compare, Allocator>::evict( T&& aValue )
+{
+    switch( mRetention )
+    {
+    case KEEP_LARGEST:
+        return mHeap.pushPopMin( std::move( aValue ) );
+
+    case KEEP_SMALLEST:
+        return mHeap.pushPopMax( std::move( aValue ) );
+
+    default:
+        mEvictMax = !mEvictMax;
+        return mEvictMax ? mHeap.pushPopMax( std::move( aValue ) ) : mHeap.pushPopMin( std::move( aValue ) );
+    }
+}
+
+template <class T, class Compare, class Allocator>
+T BoundedMinMaxHeap<T, Compare, Allocator>::deleteMin()
+{
+    return mHeap.deleteMin();
+}
+
+template <class T, class Compare, class Allocator>
+T BoundedMinMaxHeap<T, Compare, Allocator>::deleteMax()
+{
+    return mHeap.deleteMax();
+}
+
+template <class T, class Compare, class Allocator>
+const T& BoundedMinMaxHeap<T, Compare, Allocator>::peekMin() const
+{
+    return mHeap.peekMin();
+}
+
+template <class T, class Compare, class Allocator>
+const T& BoundedMinMaxHeap<T, Compare, Allocator>::peekMax() const
+{
+    return mHeap.peekMax();
+}
+
+template <class T, class Compare, class Allocator>
+const MinMaxHeap<T, Compare, Allocator>& BoundedMinMaxHeap<T, Compare, Allocator>::heap() const
+{
+    return mHeap;
+}
+
+template <class T, class Compare, class Allocator>
+bool BoundedMinMaxHeap<T, Compare, Allocator>::isEmpty() const
+{
+    return mHeap.isEmpty();
+}
+
+template <class T, class Compare, class Allocator>
+bool BoundedMinMaxHeap<T, Compare, Allocator>::isFull() const
+{
+    return ( mHeap.size() >= mBound );
+}
+
+template <class T, class Compare, class Allocator>
+long BoundedMinMaxHeap<T, Compare, Allocator>::size() const
+{
+    return mHeap.size();
+}
+
+template <class T, class Compare, class Allocator>
+long BoundedMinMaxHeap<T, Compare, Allocator>::bound() const
+{
+    return mBound;
+}
+
+template <class T, class Compare, class Allocator>
+typename BoundedMinMaxHeap<T, Compare, Allocator>::Retention BoundedMinMaxHeap<T, Compare, Allocator>::retention() const
+{
+    return mRetention;
+}
+
+template <class T, class Compare, class Allocator>
+void BoundedMinMaxHeap<T, Compare, Allocator>::clear()
+{
+    mHeap.clear();
+    mEvictMax = false;
+}
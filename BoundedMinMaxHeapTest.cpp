@@ -0,0 +1,138 @@
+/**
+*	@file : BoundedMinMaxHeapTest.cpp
+*	@author :  Haaris Chaudhry
+*	@date : Mar 9, 2017
+*	Purpose: Checks every BoundedMinMaxHeap retention policy against a std::multiset that is trimmed the
+*          same way, including the value each insert evicts.
+*/
+
+#include "BoundedMinMaxHeap.h"
+#include "MinMaxTest.h"
+#include <iterator>
+#include <random>
+#include <set>
+#include <string>
+#include <vector>
+
+namespace
+{
+    typedef BoundedMinMaxHeap<long> Heap;
+
+    // The reference keeps every value and trims it to the bound, the way the policy says
+    struct Reference
+    {
+        Reference( long aBound, Heap::Retention aRetention ) : mBound( aBound ), mRetention( aRetention ), mEvictMax( false ) {}
+
+        bool insert( long aValue, long& aEvicted )
+        {
+            mValues.insert( aValue );
+
+            if( static_cast<long>( mValues.size() ) <= mBound )
+            {
+                return false;
+            }
+
+            bool evictMax = ( mRetention == Heap::KEEP_SMALLEST );
+
+            if( mRetention == Heap::KEEP_MIDDLE )
+            {
+                mEvictMax = !mEvictMax;
+                evictMax = mEvictMax;
+            }
+
+            std::multiset<long>::iterator evicted = evictMax ? std::prev( mValues.end() ) : mValues.begin();
+            aEvicted = *evicted;
+            mValues.erase( evicted );
+            return true;
+        }
+
+        std::multiset<long> mValues;
+        long mBound;
+        Heap::Retention mRetention;
+        bool mEvictMax;
+    };
+
+    void runAgainstReference( long aBound, Heap::Retention aRetention, long aRange, unsigned long aSeed )
+    {
+        Heap heap( aBound, aRetention );
+        Reference reference( aBound, aRetention );
+        std::string name = "bound " + std::to_string( aBound ) + ", retention " + std::to_string( aRetention ) + ", range " + std::to_string( aRange );
+
+        bool passed = MinMaxTest::runSteps( name, aSeed, 5000, [&]( std::mt19937& aRandom, const MinMaxTest::Run& aRun )
+        {
+            long choice = static_cast<long>( aRandom() % 20 );
+            long value = static_cast<long>( aRandom() % aRange );
+
+            if( choice < 2 && !reference.mValues.empty() )
+            {
+                if( !MINMAX_CHECK_DELETE( aRun, heap, reference.mValues, choice == 1 ) )
+                {
+                    return;
+                }
+            }
+            else
+            {
+                long evicted = 0;
+                long expectedEvicted = 0;
+                bool didEvict = heap.insert( value, evicted );
+
+                if( !MINMAX_CHECK_EQUAL( aRun, didEvict, reference.insert( value, expectedEvicted ) ) || ( didEvict && !MINMAX_CHECK_EQUAL( aRun, evicted, expectedEvicted ) ) )
+                {
+                    return;
+                }
+            }
+
+            MINMAX_CHECK_ENDS( aRun, heap, reference.mValues ) && MINMAX_CHECK_EQUAL( aRun, heap.isFull(), heap.size() == aBound );
+        } );
+
+        if( passed )
+        {
+            std::vector<long> drained;
+
+            while( !heap.isEmpty() )
+            {
+                drained.push_back( heap.deleteMin() );
+            }
+
+            MINMAX_CHECK( drained == std::vector<long>( reference.mValues.begin(), reference.mValues.end() ) );
+        }
+    }
+}
+
+int main()
+{
+    std::mt19937 random( 2017 );
+    const Heap::Retention retentions[] = { Heap::KEEP_LARGEST, Heap::KEEP_SMALLEST, Heap::KEEP_MIDDLE };
+    const long bounds[] = { 1, 2, 7, 100 };
+    const long ranges[] = { 1L << 30, 10 };
+
+    for( int r = 0; r < 3; r++ )
+    {
+        for( size_t b = 0; b < sizeof( bounds ) / sizeof( bounds[0] ); b++ )
+        {
+            for( size_t k = 0; k < sizeof( ranges ) / sizeof( ranges[0] ); k++ )
+            {
+                runAgainstReference( bounds[b], retentions[r], ranges[k], random() );
+            }
+        }
+    }
+
+    // A top-3 keeps the three largest, the insert that is itself too small is the one handed back
+    Heap top( 3, Heap::KEEP_LARGEST );
+    long evicted = 0;
+
+    for( long value = 1; value <= 5; value++ )
+    {
+        top.insert( value );
+    }
+
+    MINMAX_CHECK( top.insert( 0, evicted ) && evicted == 0 );
+    MINMAX_CHECK( top.peekMin() == 3 && top.peekMax() == 5 && top.size() == 3 );
+
+    top.clear();
+    MINMAX_CHECK( top.isEmpty() && top.bound() == 3 && top.retention() == Heap::KEEP_LARGEST );
+    MINMAX_CHECK_THROWS( top.deleteMax() );
+    MINMAX_CHECK_THROWS( Heap( 0, Heap::KEEP_MIDDLE ) );
+
+    return MinMaxTest::report( "BoundedMinMaxHeapTest" );
+}
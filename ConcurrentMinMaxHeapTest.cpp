@@ -0,0 +1,170 @@
+/**
+*	@file : ConcurrentMinMaxHeapTest.cpp
+*	@author :  Haaris Chaudhry
+*	@date : Mar 9, 2017
+*	Purpose: Checks that the concurrent heaps neither lose nor duplicate a value: several threads
+*          insert distinct values and pop from both ends at once, then every value has to have been
+*          popped exactly once, for FlatCombiningMinMaxHeap and ShardedMinMaxHeap in both of its
+*          modes.  Also checks that a FlatCombiningMinMaxHeap whose comparator throws hands the
+*          exception to the caller and keeps working.
+*/
+
+#include "FlatCombiningMinMaxHeap.h"
+#include "ShardedMinMaxHeap.h"
+#include "MinMaxTest.h"
+#include <algorithm>
+#include <cstdio>
+#include <functional>
+#include <random>
+#include <string>
+#include <thread>
+#include <vector>
+
+namespace
+{
+    const long kNumThreads = 4;
+    const long kValuesPerThread = 5000;
+
+    // Each thread inserts its own values, and after every insert pops from a random end about half
+    // the time, keeping what it popped
+    template <class Heap>
+    void work( Heap& aHeap, long aThread, std::vector<long>& aPopped )
+    {
+        std::mt19937 random( static_cast<unsigned long>( 2017 + aThread ) );
+
+        for( long i = 0; i < kValuesPerThread; i++ )
+        {
+            aHeap.insert( aThread * kValuesPerThread + i );
+
+            long value = 0;
+            unsigned long choice = random() % 4;
+
+            if( ( choice == 0 && aHeap.tryPopMin( value ) ) || ( choice == 1 && aHeap.tryPopMax( value ) ) )
+            {
+                aPopped.push_back( value );
+            }
+        }
+    }
+
+    // aExact is false for heaps whose pops may miss the extreme, their drain is not checked for order
+    template <class Heap>
+    void checkConservation( Heap& aHeap, const std::string& aName, bool aExact )
+    {
+        std::vector<std::vector<long> > popped( kNumThreads );
+        std::vector<std::thread> threads;
+
+        for( long t = 0; t < kNumThreads; t++ )
+        {
+            threads.push_back( std::thread( work<Heap>, std::ref( aHeap ), t, std::ref( popped[t] ) ) );
+        }
+
+        for( long t = 0; t < kNumThreads; t++ )
+        {
+            threads[t].join();
+        }
+
+        // What is left comes out in order once no other thread is running
+        std::vector<long> all;
+        long value = 0;
+        bool ordered = true;
+
+        while( aHeap.tryPopMin( value ) )
+        {
+            ordered = ordered && ( !aExact || all.empty() || all.back() <= value );
+            all.push_back( value );
+        }
+
+        for( long t = 0; t < kNumThreads; t++ )
+        {
+            all.insert( all.end(), popped[t].begin(), popped[t].end() );
+        }
+
+        std::sort( all.begin(), all.end() );
+        long missing = 0;
+
+        for( long i = 0; i < kNumThreads * kValuesPerThread; i++ )
+        {
+            missing += std::binary_search( all.begin(), all.end(), i ) ? 0 : 1;
+        }
+
+        long duplicated = static_cast<long>( all.size() - ( std::unique( all.begin(), all.end() ) - all.begin() ) );
+
+        if( missing != 0 || duplicated != 0 || !ordered )
+        {
+            std::printf( "%s: %ld values missing, %ld duplicated, drain %s\n", aName.c_str(), missing, duplicated, ordered ? "ordered" : "not ordered" );
+        }
+
+        MINMAX_CHECK( missing == 0 && duplicated == 0 && ordered );
+        MINMAX_CHECK( aHeap.isEmpty() );
+    }
+
+    // Throws while sThrowing is set
+    struct ThrowingLess
+    {
+        static bool sThrowing;
+
+        bool operator()( long aLeft, long aRight ) const
+        {
+            if( sThrowing )
+            {
+                throw PrecondViolatedExcep( "comparator failed" );
+            }
+
+            return aLeft < aRight;
+        }
+    };
+
+    bool ThrowingLess::sThrowing = false;
+}
+
+int main()
+{
+    FlatCombiningMinMaxHeap<long> combining;
+    checkConservation( combining, "FlatCombiningMinMaxHeap", true );
+
+    FlatCombiningMinMaxHeap<long> oneSlot( 1 );
+    checkConservation( oneSlot, "FlatCombiningMinMaxHeap, one slot", true );
+
+    ShardedMinMaxHeap<long> relaxed( 0, ShardedMinMaxHeap<long>::RELAXED );
+    checkConservation( relaxed, "ShardedMinMaxHeap, RELAXED", false );
+
+    ShardedMinMaxHeap<long> exact( 0, ShardedMinMaxHeap<long>::EXACT );
+    checkConservation( exact, "ShardedMinMaxHeap, EXACT", true );
+
+    ShardedMinMaxHeap<long> oneShard( 1, ShardedMinMaxHeap<long>::RELAXED );
+    checkConservation( oneShard, "ShardedMinMaxHeap, one shard", true );
+
+    // Relaxed pops measure themselves, and every sampled pop counts
+    ShardedMinMaxHeap<long>::Relaxation relaxation = relaxed.relaxation();
+    MINMAX_CHECK( relaxation.mSampled > 0 && relaxation.mMissed <= relaxation.mSampled && relaxation.mMaxRankError < relaxed.numShards() );
+    relaxed.resetRelaxation();
+    MINMAX_CHECK( relaxed.relaxation().mSampled == 0 );
+    MINMAX_CHECK_THROWS( exact.popMin() );
+
+    // A failed pass fails its request and frees the combiner, so the next request goes through
+    FlatCombiningMinMaxHeap<long, ThrowingLess> throwing;
+    throwing.insert( 3 );
+    throwing.insert( 1 );
+    throwing.insert( 2 );
+    ThrowingLess::sThrowing = true;
+    MINMAX_CHECK_THROWS( throwing.insert( 4 ) );
+    ThrowingLess::sThrowing = false;
+    throwing.insert( 5 );
+    MINMAX_CHECK( throwing.popMin() == 1 );
+    MINMAX_CHECK( throwing.popMax() == 5 );
+
+    ThrowingLess::sThrowing = true;
+    MINMAX_CHECK_THROWS( throwing.popMin() );
+    ThrowingLess::sThrowing = false;
+    throwing.insert( 6 );
+    MINMAX_CHECK( throwing.popMax() == 6 );
+
+    while( !throwing.isEmpty() )
+    {
+        throwing.popMin();
+    }
+
+    MINMAX_CHECK_THROWS( throwing.popMax() );
+
+    return MinMaxTest::report( "ConcurrentMinMaxHeapTest" );
+}
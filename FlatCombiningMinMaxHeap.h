@@ -0,0 +1,198 @@
+/**
+*	@file : FlatCombiningMinMaxHeap.h
+*	@author :  Haaris Chaudhry
+*	@date : Mar 9, 2017
+*	Purpose: A concurrent MinMaxHeap with exact semantics, built on flat combining.  A thread does not
+*          lock the heap itself: it publishes its request in a slot and waits.  Whichever thread
+*          manages to become the combiner applies every published request in one pass, inserts first
+*          through the bulk insertRange path and then the pops in slot order, and hands each result
+*          back through its slot.  The heap array is only ever touched by the current combiner, so
+*          its cache lines stay on one core while the other threads spin on their own slots.
+*
+*          Every pass is applied as one atomic batch, so a pop always returns the exact global
+*          minimum or maximum of the heap as it stands after the batch's inserts.
+*
+*          If a pass throws, from an allocation, a move or the comparator, every request of the pass
+*          that was not answered yet fails: its owner rethrows the exception.  An insert that failed
+*          may or may not have reached the heap.  The heap stays usable.
+*/
+
+#ifndef FLAT_COMBINING_MIN_MAX_HEAP_H
+#define FLAT_COMBINING_MIN_MAX_HEAP_H
+
+#include "MinMaxHeap.h"
+#include <atomic>
+#include <exception>
+#include <functional>
+#include <memory>
+#include <vector>
+
+template <class T, class Compare = std::less<T>, class Allocator = std::allocator<T> >
+class FlatCombiningMinMaxHeap
+{
+public:
+    typedef T value_type;
+    typedef Compare value_compare;
+    typedef Allocator allocator_type;
+
+    /**
+    * Constructor for the FlatCombiningMinMaxHeap
+    * @param aNumSlots The number of request slots, 0 for four per hardware thread. More threads than
+    *        slots still work, they take turns on the slots.
+    * @param aCompare The strict weak ordering used to compare values
+    * @return An empty heap
+    */
+    explicit FlatCombiningMinMaxHeap( long aNumSlots = 0, const Compare& aCompare = Compare() );
+
+    /**
+    * The destructor
+    */
+    ~FlatCombiningMinMaxHeap();
+
+    /**
+    * Inserts a value, safe to call from any thread. Rethrows the exception of a failed pass.
+    * @param aValue The value to be inserted
+    */
+    void insert( const T& aValue );
+
+    void insert( T&& aValue );
+
+    /**
+    * Deletes the minimum value
+    * @param aValue Receives the deleted value
+    * @return True if a value was deleted, false if the heap was empty
+    */
+    bool tryPopMin( T& aValue );
+
+    /**
+    * Deletes the maximum value
+    * @param aValue Receives the deleted value
+    * @return True if a value was deleted, false if the heap was empty
+    */
+    bool tryPopMax( T& aValue );
+
+    /**
+    * Deletes the minimum value
+    * @return The value that was deleted (throws PrecondViolatedExcep if the heap is empty)
+    */
+    T popMin();
+
+    /**
+    * Deletes the maximum value
+    * @return The value that was deleted (throws PrecondViolatedExcep if the heap is empty)
+    */
+    T popMax();
+
+    /**
+    * @return The number of values after the last combining pass
+    */
+    long size() const;
+
+    /**
+    * @return True if the heap was empty after the last combining pass
+    */
+    bool isEmpty() const;
+
+    /**
+    * @return The number of combining passes so far
+    */
+    long passes() const;
+
+    /**
+    * @return The number of requests applied by those passes, divided by passes() the average batch
+    */
+    long combinedRequests() const;
+
+private:
+    FlatCombiningMinMaxHeap( const FlatCombiningMinMaxHeap& );
+    FlatCombiningMinMaxHeap& operator=( const FlatCombiningMinMaxHeap& );
+
+    enum Operation
+    {
+        INSERT,
+        POP_MIN,
+        POP_MAX
+    };
+
+    enum State
+    {
+        FREE,       //!< No request
+        PENDING,    //!< Published, waiting for a combiner
+        DONE,       //!< Applied, the result is in the slot
+        FAILED      //!< The pass threw, mError holds the exception
+    };
+
+    /**
+    * One thread's request and its result, on cache lines of its own
+    */
+    struct alignas( 64 ) Slot
+    {
+        Slot();
+
+        std::atomic<bool> mOwned;   //!< Set while a thread is using the slot
+        std::atomic<int> mState;    //!< A State, PENDING hands the slot to the combiner and DONE back
+        Operation mOperation;       //!< What was requested
+        bool mFound;                //!< For pops, whether a value was deleted
+        T mValue;                   //!< The value to insert or the value deleted
+        std::exception_ptr mError;  //!< Why the request FAILED
+    };
+
+    /**
+    * Releases mCombining when a pass ends, however it ends
+    */
+    class CombinerGuard
+    {
+    public:
+        explicit CombinerGuard( std::atomic<bool>& aCombining );
+        ~CombinerGuard();
+
+    private:
+        CombinerGuard( const CombinerGuard& );
+        CombinerGuard& operator=( const CombinerGuard& );
+
+        std::atomic<bool>& mCombining;
+    };
+
+    /**
+    * Claims a free slot, starting from one chosen by the calling thread's id
+    */
+    Slot& acquire();
+
+    /**
+    * Publishes the request in aSlot and combines or waits until it is DONE, then frees the slot. A
+    * FAILED request frees the slot and rethrows.
+    */
+    void submit( Slot& aSlot );
+
+    /**
+    * Applies the PENDING requests, inserts first. Only called by the combiner. If applying them
+    * throws, the requests not answered yet are FAILED instead.
+    * @return The number of requests applied or failed
+    */
+    long combine();
+
+    /**
+    * Publishes an insert
+    */
+    template <class U>
+    void push( U&& aValue );
+
+    /**
+    * Publishes a pop
+    */
+    bool pop( Operation aOperation, T& aValue );
+
+    MinMaxHeap<T, Compare, Allocator> mHeap;    //!< Only touched by the combiner
+    std::vector<T> mBatch;                      //!< The combiner's scratch space for the inserts
+    std::vector<long> mPending;                 //!< The combiner's list of the slots in the pass
+    long mNumSlots;                             //!< The number of slots
+    std::unique_ptr<char[]> mStorage;           //!< The raw memory the slots live in
+    Slot* mSlots;                               //!< The slots, 64 byte aligned inside mStorage
+    alignas( 64 ) std::atomic<bool> mCombining; //!< Held by the thread that is combining
+    std::atomic<long> mSize;                    //!< mHeap.size() after the last pass
+    std::atomic<long> mPasses;                  //!< Combining passes so far
+    std::atomic<long> mRequests;                //!< Requests applied by those passes
+};
+
+#include "FlatCombiningMinMaxHeap.hpp"
+#endif // !FLAT_COMBINING_MIN_MAX_HEAP_H
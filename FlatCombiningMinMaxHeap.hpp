@@ -0,0 +1,318 @@
+/**
+*	@file : FlatCombiningMinMaxHeap.hpp
+*	@author :  Haaris Chaudhry
+*	@date : Mar 9, 2017
+*	Purpose: Implementation of the FlatCombiningMinMaxHeap class template.
+*/
+
+#include "PrecondViolatedExcep.h"
+#include <iterator>
+#include <new>
+#include <thread>
+#include <utility>
+
+template <class T, class Compare, class Allocator>
+FlatCombiningMinMaxHeap<T, Compare, Allocator>::Slot::Slot() :
+    mOwned( false ),
+    mState( FREE ),
+    mOperation( INSERT ),
+    mFound( false ),
+    mValue(),
+    mError()
+{
+}
+
+template <class T, class Compare, class Allocator>
+FlatCombiningMinMaxHeap<T, Compare, Allocator>::CombinerGuard::CombinerGuard( std::atomic<bool>& aCombining ) :
+    mCombining( aCombining )
+{
+}
+
+template <class T, class Compare, class Allocator>
+FlatCombiningMinMaxHeap<T, Compare, Allocator>::CombinerGuard::~CombinerGuard()
+{
+    mCombining.store( false, std::memory_order_release );
+}
+
+// operator new only promises 16 byte alignment before C++17, so the slots are placed by hand
+template <class T, class Compare, class Allocator>
+FlatCombiningMinMaxHeap<T, Compare, Allocator>::FlatCombiningMinMaxHeap( long aNumSlots, const Compare& aCompare ) :
+    mHeap( 0, aCompare ),
+    mNumSlots( aNumSlots ),
+    mSlots( nullptr ),
+    mCombining( false ),
+    mSize( 0 ),
+    mPasses( 0 ),
+    mRequests( 0 )
+{
+    if( mNumSlots <= 0 )
+    {
+        long threads = static_cast<long>( std::thread::hardware_concurrency() );
+        mNumSlots = 4 * ( threads > 0 ? threads : 1 );
+    }
+
+    std::size_t bytes = static_cast<std::size_t>( mNumSlots ) * sizeof( Slot );
+    std::size_t space = bytes + alignof( Slot );
+    mStorage.reset( new char[space] );
+    void* first = mStorage.get();
+    mSlots = static_cast<Slot*>( std::align( alignof( Slot ), bytes, first, space ) );
+    mBatch.reserve( mNumSlots );
+    mPending.reserve( mNumSlots );
+
+    long constructed = 0;
+
+    try
+    {
+        for( ; constructed < mNumSlots; constructed++ )
+        {
+            new( mSlots + constructed ) Slot();
+        }
+    }
+    catch( ... )
+    {
+        while( constructed > 0 )
+        {
+            mSlots[--constructed].~Slot();
+        }
+
+        throw;
+    }
+}
+
+template <class T, class Compare, class Allocator>
+FlatCombiningMinMaxHeap<T, Compare, Allocator>::~FlatCombiningMinMaxHeap()
+{
+    for( long i = 0; i < mNumSlots; i++ )
+    {
+        mSlots[i].~Slot();
+    }
+}
+
+template <class T, class Compare, class Allocator>
+void FlatCombiningMinMaxHeap<T, Compare, Allocator>::insert( const T& aValue )
+{
+    push( aValue );
+}
+
+template <class T, class Compare, class Allocator>
+void FlatCombiningMinMaxHeap<T, Compare, Allocator>::insert( T&& aValue )
+{
+    push( std::move( aValue ) );
+}
+
+template <class T, class Compare, class Allocator>
+bool FlatCombiningMinMaxHeap<T, Compare, Allocator>::tryPopMin( T& aValue )
+{
+    return pop( POP_MIN, aValue );
+}
+
+template <class T, class Compare, class Allocator>
+bool FlatCombiningMinMaxHeap<T, Compare, Allocator>::tryPopMax( T& aValue )
+{
+    return pop( POP_MAX, aValue );
+}
+
+template <class T, class Compare, class Allocator>
+T FlatCombiningMinMaxHeap<T, Compare, Allocator>::popMin()
+{
+    T value;
+
+    if( !tryPopMin( value ) )
+    {
+        throw PrecondViolatedExcep( "popMin attempted on an empty heap" );
+    }
+
+    return value;
+}
+
+template <class T, class Compare, class Allocator>
+T FlatCombiningMinMaxHeap<T, Compare, Allocator>::popMax()
+{
+    T value;
+
+    if( !tryPopMax( value ) )
+    {
+        throw PrecondViolatedExcep( "popMax attempted on an empty heap" );
+    }
+
+    return value;
+}
+
+template <class T, class Compare, class Allocator>
+template <class U>
+void FlatCombiningMinMaxHeap<T, Compare, Allocator>::push( U&& aValue )
+{
+    Slot& slot = acquire();
+    slot.mOperation = INSERT;
+    slot.mValue = std::forward<U>( aValue );
+    submit( slot );
+}
+
+template <class T, class Compare, class Allocator>
+bool FlatCombiningMinMaxHeap<T, Compare, Allocator>::pop( Operation aOperation, T& aValue )
+{
+    Slot& slot = acquire();
+    slot.mOperation = aOperation;
+    submit( slot );
+
+    bool found = slot.mFound;
+
+    if( found )
+    {
+        aValue = std::move( slot.mValue );
+    }
+
+    slot.mOwned.store( false, std::memory_order_release );
+    return found;
+}
+
+// A thread keeps landing on the same slot, so claiming it is normally one uncontended exchange
+template <class T, class Compare, class Allocator>
+typename FlatCombiningMinMaxHeap<T, Compare, Allocator>::Slot& FlatCombiningMinMaxHeap<T, Compare, Allocator>::acquire()
+{
+    long start = static_cast<long>( std::hash<std::thread::id>()( std::this_thread::get_id() ) % static_cast<std::size_t>( mNumSlots ) );
+
+    for( ;; )
+    {
+        for( long i = 0; i < mNumSlots; i++ )
+        {
+            Slot& slot = mSlots[( start + i ) % mNumSlots];
+
+            if( !slot.mOwned.load( std::memory_order_relaxed ) && !slot.mOwned.exchange( true, std::memory_order_acquire ) )
+            {
+                return slot;
+            }
+        }
+
+        std::this_thread::yield();
+    }
+}
+
+// Inserts free their slot here, pops free it once they have read the result. A failed request frees
+// its slot here too, after taking the exception out of it.
+template <class T, class Compare, class Allocator>
+void FlatCombiningMinMaxHeap<T, Compare, Allocator>::submit( Slot& aSlot )
+{
+    aSlot.mState.store( PENDING, std::memory_order_release );
+    int state = PENDING;
+
+    while( ( state = aSlot.mState.load( std::memory_order_acquire ) ) == PENDING )
+    {
+        if( !mCombining.load( std::memory_order_relaxed ) && !mCombining.exchange( true, std::memory_order_acquire ) )
+        {
+            CombinerGuard guard( mCombining );
+            long requests = combine();
+            mPasses.fetch_add( 1, std::memory_order_relaxed );
+            mRequests.fetch_add( requests, std::memory_order_relaxed );
+        }
+        else
+        {
+            std::this_thread::yield();
+        }
+    }
+
+    aSlot.mState.store( FREE, std::memory_order_relaxed );
+
+    if( state == FAILED )
+    {
+        std::exception_ptr error = aSlot.mError;
+        aSlot.mError = nullptr;
+        aSlot.mOwned.store( false, std::memory_order_release );
+        std::rethrow_exception( error );
+    }
+
+    if( aSlot.mOperation == INSERT )
+    {
+        aSlot.mOwned.store( false, std::memory_order_release );
+    }
+}
+
+// The requests seen in the first scan make up the pass, a request published after that waits for the
+// next one. Their inserts are absorbed with one insertRange, which rebuilds bottom up when the batch
+// is large against the heap, before any pop of the pass is answered. A throw fails every request of
+// the pass from the one being answered on, the ones before it already have their results.
+template <class T, class Compare, class Allocator>
+long FlatCombiningMinMaxHeap<T, Compare, Allocator>::combine()
+{
+    size_t answered = 0;
+
+    try
+    {
+        for( long i = 0; i < mNumSlots; i++ )
+        {
+            Slot& slot = mSlots[i];
+
+            if( slot.mState.load( std::memory_order_acquire ) == PENDING )
+            {
+                mPending.push_back( i );
+
+                if( slot.mOperation == INSERT )
+                {
+                    mBatch.push_back( std::move( slot.mValue ) );
+                }
+            }
+        }
+
+        mHeap.insertRange( std::make_move_iterator( mBatch.begin() ), std::make_move_iterator( mBatch.end() ) );
+        mBatch.clear();
+
+        for( ; answered < mPending.size(); answered++ )
+        {
+            Slot& slot = mSlots[mPending[answered]];
+
+            if( slot.mOperation != INSERT )
+            {
+                slot.mFound = !mHeap.isEmpty();
+
+                if( slot.mFound )
+                {
+                    slot.mValue = ( slot.mOperation == POP_MIN ) ? mHeap.deleteMin() : mHeap.deleteMax();
+                }
+            }
+
+            slot.mState.store( DONE, std::memory_order_release );
+        }
+    }
+    catch( ... )
+    {
+        std::exception_ptr error = std::current_exception();
+
+        for( ; answered < mPending.size(); answered++ )
+        {
+            Slot& slot = mSlots[mPending[answered]];
+            slot.mError = error;
+            slot.mState.store( FAILED, std::memory_order_release );
+        }
+
+        mBatch.clear();
+    }
+
+    long requests = static_cast<long>( mPending.size() );
+    mPending.clear();
+    mSize.store( mHeap.size(), std::memory_order_relaxed );
+    return requests;
+}
+
+template <class T, class Compare, class Allocator>
+long FlatCombiningMinMaxHeap<T, Compare, Allocator>::size() const
+{
+    return mSize.load( std::memory_order_relaxed );
+}
+
+template <class T, class Compare, class Allocator>
+bool FlatCombiningMinMaxHeap<T, Compare, Allocator>::isEmpty() const
+{
+    return ( size() == 0 );
+}
+
+template <class T, class Compare, class Allocator>
+long FlatCombiningMinMaxHeap<T, Compare, Allocator>::passes() const
+{
+    return mPasses.load( std::memory_order_relaxed );
+}
+
+template <class T, class Compare, class Allocator>
+long FlatCombiningMinMaxHeap<T, Compare, Allocator>::combinedRequests() const
+{
+    return mRequests.load( std::memory_order_relaxed );
+}
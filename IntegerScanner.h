@@ -0,0 +1,93 @@
+/**
+*	@file : IntegerScanner.h
+*	@author :  Haaris Chaudhry
+*	@date : Mar 9, 2017
+*	Purpose: Parses the integers out of a block of text, such as a MappedFile, without streams or locales.
+*          Anything that is not a digit separates integers, and a '-' right before a digit makes it
+*          negative.  Digits are converted eight at a time with SWAR arithmetic on one 64 bit word, and
+*          the integers are counted up front with SSE2 so the destination can be sized exactly.
+*          Values are assumed to fit in the integer type; larger ones wrap around.
+*/
+
+#ifndef INTEGER_SCANNER_H
+#define INTEGER_SCANNER_H
+
+#include "MinMaxSimd.h"
+#include <cstddef>
+#include <iterator>
+
+/**
+* An input iterator over the integers in [aFirst, aLast), the text has to outlive it
+*/
+template <class T>
+class IntegerScanner
+{
+public:
+    typedef std::input_iterator_tag iterator_category;
+    typedef T value_type;
+    typedef std::ptrdiff_t difference_type;
+    typedef const T* pointer;
+    typedef const T& reference;
+
+    /**
+    * Creates the end iterator
+    */
+    IntegerScanner();
+
+    /**
+    * Creates an iterator at the first integer of the text
+    * @param aFirst The first character of the text
+    * @param aLast One past the last character of the text
+    */
+    IntegerScanner( const char* aFirst, const char* aLast );
+
+    /**
+    * @return The integer the iterator is at
+    */
+    const T& operator*() const;
+
+    /**
+    * Moves to the next integer, or to the end when there is none
+    */
+    IntegerScanner& operator++();
+    IntegerScanner operator++( int );
+
+    /**
+    * Only the end is compared meaningfully, two iterators that are not at the end are equal when
+    * they are at the same position
+    */
+    bool operator==( const IntegerScanner& aOther ) const;
+    bool operator!=( const IntegerScanner& aOther ) const;
+
+    /**
+    * Counts the integers in a text, which is much faster than parsing them
+    * @param aFirst The first character of the text
+    * @param aLast One past the last character of the text
+    * @return The number of integers an IntegerScanner would produce
+    */
+    static long count( const char* aFirst, const char* aLast );
+
+private:
+    /**
+    * Parses the integer starting at mNext, or marks the iterator as ended if there is none
+    */
+    void advance();
+
+    /**
+    * @return The number of leading digit characters in an 8 byte word (8 if all of them are digits)
+    */
+    static int digitRun( unsigned long long aWord );
+
+    /**
+    * @return The value of the first aDigits characters of an 8 byte word, which are all digits
+    */
+    static unsigned long long parseDigits( unsigned long long aWord, int aDigits );
+
+    const char* mNext;  //!< The first character not parsed yet
+    const char* mLast;  //!< One past the last character of the text
+    T mValue;           //!< The integer the iterator is at
+    bool mEnded;        //!< True once there are no more integers
+};
+
+#include "IntegerScanner.hpp"
+#endif // !INTEGER_SCANNER_H
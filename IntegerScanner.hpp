@@ -0,0 +1,199 @@
+/**
+*	@file : IntegerScanner.hpp
+*	@author :  Haaris Chaudhry
+*	@date : Mar 9, 2017
+*	Purpose: Implementation of the IntegerScanner class template.
+*/
+
+#include <cstring>
+
+template <class T>
+IntegerScanner<T>::IntegerScanner() :
+    mNext( nullptr ),
+    mLast( nullptr ),
+    mValue(),
+    mEnded( true )
+{
+}
+
+template <class T>
+IntegerScanner<T>::IntegerScanner( const char* aFirst, const char* aLast ) :
+    mNext( aFirst ),
+    mLast( aLast ),
+    mValue(),
+    mEnded( false )
+{
+    advance();
+}
+
+template <class T>
+const T& IntegerScanner<T>::operator*() const
+{
+    return mValue;
+}
+
+template <class T>
+IntegerScanner<T>& IntegerScanner<T>::operator++()
+{
+    advance();
+    return *this;
+}
+
+template <class T>
+IntegerScanner<T> IntegerScanner<T>::operator++( int )
+{
+    IntegerScanner previous = *this;
+    advance();
+    return previous;
+}
+
+template <class T>
+bool IntegerScanner<T>::operator==( const IntegerScanner& aOther ) const
+{
+    if( mEnded || aOther.mEnded )
+    {
+        return mEnded == aOther.mEnded;
+    }
+
+    return mNext == aOther.mNext;
+}
+
+template <class T>
+bool IntegerScanner<T>::operator!=( const IntegerScanner& aOther ) const
+{
+    return !( *this == aOther );
+}
+
+// Skips the separators, then consumes whole 8 digit words while the number keeps going. Only the last
+// few characters of the text, where a full word cannot be loaded, are converted one digit at a time.
+template <class T>
+void IntegerScanner<T>::advance()
+{
+    bool negative = false;
+
+    while( mNext != mLast && static_cast<unsigned char>( *mNext - '0' ) > 9 )
+    {
+        negative = ( *mNext == '-' );
+        mNext++;
+    }
+
+    if( mNext == mLast )
+    {
+        mEnded = true;
+        return;
+    }
+
+    unsigned long long value = 0;
+
+    while( mLast - mNext >= 8 )
+    {
+        unsigned long long word;
+        std::memcpy( &word, mNext, 8 );
+        int digits = digitRun( word );
+
+        if( digits < 8 )
+        {
+            static const unsigned long long kPowers[8] = { 1ULL, 10ULL, 100ULL, 1000ULL, 10000ULL, 100000ULL, 1000000ULL, 10000000ULL };
+
+            if( digits > 0 )    // A number that is a multiple of 8 digits long ends right at a word boundary
+            {
+                value = value * kPowers[digits] + parseDigits( word, digits );
+                mNext += digits;
+            }
+
+            mValue = static_cast<T>( negative ? 0ULL - value : value );
+            return;
+        }
+
+        value = value * 100000000ULL + parseDigits( word, 8 );
+        mNext += 8;
+    }
+
+    while( mNext != mLast && static_cast<unsigned char>( *mNext - '0' ) <= 9 )
+    {
+        value = value * 10 + static_cast<unsigned long long>( *mNext - '0' );
+        mNext++;
+    }
+
+    mValue = static_cast<T>( negative ? 0ULL - value : value );
+}
+
+// A byte is a digit when its high nibble is 3 both before and after adding 6. The add may carry out of
+// a byte of 0xFA or more, but such a byte is not a digit, so the run has already ended before it.
+// Each non-digit byte is then reduced to its high bit and the lowest one marks the end of the run.
+template <class T>
+int IntegerScanner<T>::digitRun( unsigned long long aWord )
+{
+    const unsigned long long kHigh = 0xF0F0F0F0F0F0F0F0ULL;
+    const unsigned long long kThrees = 0x3030303030303030ULL;
+
+    unsigned long long mismatch = ( ( aWord & kHigh ) ^ kThrees ) | ( ( ( aWord + 0x0606060606060606ULL ) & kHigh ) ^ kThrees );
+    unsigned long long nonDigits = ( ( ( mismatch >> 4 ) & 0x0F0F0F0F0F0F0F0FULL ) + 0x7F7F7F7F7F7F7F7FULL ) & 0x8080808080808080ULL;
+
+    if( nonDigits == 0 )
+    {
+        return 8;
+    }
+
+#if defined( __GNUC__ )
+    return __builtin_ctzll( nonDigits ) >> 3;
+#else
+    int digits = 0;
+
+    while( ( nonDigits & 0x80 ) == 0 )
+    {
+        nonDigits >>= 8;
+        digits++;
+    }
+
+    return digits;
+#endif
+}
+
+// The first character sits in the lowest byte and is the most significant digit. The digits are
+// shifted to the top of the word, so the bytes that were cut off become leading zeros, then neighbouring
+// digits are combined into pairs (one multiply-add), and the four pairs into the result (two multiplies)
+template <class T>
+unsigned long long IntegerScanner<T>::parseDigits( unsigned long long aWord, int aDigits )
+{
+    unsigned long long value = ( aWord << ( 8 * ( 8 - aDigits ) ) ) & 0x0F0F0F0F0F0F0F0FULL;
+
+    value = ( value * 10 ) + ( value >> 8 );
+    value = ( ( ( value & 0x000000FF000000FFULL ) * ( 100 + ( 1000000ULL << 32 ) ) )
+        + ( ( ( value >> 16 ) & 0x000000FF000000FFULL ) * ( 1 + ( 10000ULL << 32 ) ) ) ) >> 32;
+    return value & 0xFFFFFFFFULL;
+}
+
+// A run starts at every digit whose predecessor is not a digit. With SSE2 the digit mask of 16
+// characters is one subtract, one min and one compare, and the starts are mask & ~(mask << 1)
+template <class T>
+long IntegerScanner<T>::count( const char* aFirst, const char* aLast )
+{
+    long runs = 0;
+    unsigned int previous = 0;
+
+#if defined( MINMAXHEAP_HAVE_SIMD )
+    const __m128i zeros = _mm_set1_epi8( '0' );
+    const __m128i nines = _mm_set1_epi8( 9 );
+
+    for( ; aLast - aFirst >= 16; aFirst += 16 )
+    {
+        __m128i text = _mm_loadu_si128( reinterpret_cast<const __m128i*>( aFirst ) );
+        __m128i offsets = _mm_sub_epi8( text, zeros );
+        unsigned int digits = static_cast<unsigned int>( _mm_movemask_epi8( _mm_cmpeq_epi8( _mm_min_epu8( offsets, nines ), offsets ) ) );
+        unsigned int starts = digits & ~( ( digits << 1 ) | previous );
+
+        runs += __builtin_popcount( starts );
+        previous = digits >> 15;
+    }
+#endif
+
+    for( ; aFirst != aLast; aFirst++ )
+    {
+        unsigned int digit = ( static_cast<unsigned char>( *aFirst - '0' ) <= 9 ) ? 1 : 0;
+        runs += digit & ~previous;
+        previous = digit;
+    }
+
+    return runs;
+}
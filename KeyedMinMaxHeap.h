@@ -0,0 +1,140 @@
+/**
+*	@file : KeyedMinMaxHeap.h
+*	@author :  Haaris Chaudhry
+*	@date : Mar 9, 2017
+*	Purpose: A min-max heap of keys that each carry a payload, such as a job id or a pointer.
+*          The keys and the payloads live in two parallel arrays (see MinMaxSplitStore), so the
+*          descendant scans and the vector kernels only ever read the dense key array, and a payload
+*          is moved once for every time its key moves, never for a comparison.  With 32 to 64 byte
+*          payloads the keys the sifts compare stay eight to a cache line instead of one or two.
+*/
+
+#ifndef KEYED_MIN_MAX_HEAP_H
+#define KEYED_MIN_MAX_HEAP_H
+
+#include "MinMaxHeapEngine.h"
+#include <functional>
+#include <memory>
+#include <utility>
+#include <vector>
+
+template <class K, class P, class Compare = std::less<K>, class Allocator = std::allocator<K> >
+class KeyedMinMaxHeap
+{
+public:
+    typedef K key_type;
+    typedef P payload_type;
+    typedef std::pair<K, P> value_type;
+    typedef Compare key_compare;
+    typedef Allocator allocator_type;
+
+    /**
+    * Constructor for the KeyedMinMaxHeap
+    * @param aSize The initial capacity of the heap
+    * @param aCompare The strict weak ordering used to compare keys
+    * @return An empty heap able to hold aSize entries before growing
+    */
+    explicit KeyedMinMaxHeap( long aSize = 0, const Compare& aCompare = Compare() );
+
+    /**
+    * Constructor for the KeyedMinMaxHeap, copies two parallel arrays and heapifies them bottom up
+    * @param aSize The initial capacity of the heap
+    * @param keys an array of keys
+    * @param payloads an array of payloads, payloads[i] belongs to keys[i]
+    * @param valuesSize the size of both arrays
+    * @return A heap containing the entries
+    */
+    KeyedMinMaxHeap( long aSize, const K keys[], const P payloads[], long valuesSize );
+
+    /**
+    * The insertion function, also heapifies the entry
+    * @param aKey The key the entry is ordered by
+    * @param aPayload The data carried with it
+    */
+    void insert( const K& aKey, const P& aPayload );
+
+    void insert( K&& aKey, P&& aPayload );
+
+    /**
+    * Deletes the entry with the minimum key
+    * @return The key and payload that were deleted (throws PrecondViolatedExcep if the heap is empty)
+    */
+    value_type deleteMin();
+
+    /**
+    * Deletes the entry with the maximum key
+    * @return The key and payload that were deleted (throws PrecondViolatedExcep if the heap is empty)
+    */
+    value_type deleteMax();
+
+    /**
+    * Reads the minimum key without removing it
+    * @return The minimum key (throws PrecondViolatedExcep if the heap is empty)
+    */
+    const K& peekMin() const;
+
+    /**
+    * @return The payload of the minimum key (throws PrecondViolatedExcep if the heap is empty)
+    */
+    const P& peekMinPayload() const;
+
+    /**
+    * Reads the maximum key without removing it
+    * @return The maximum key (throws PrecondViolatedExcep if the heap is empty)
+    */
+    const K& peekMax() const;
+
+    /**
+    * @return The payload of the maximum key (throws PrecondViolatedExcep if the heap is empty)
+    */
+    const P& peekMaxPayload() const;
+
+    /**
+    * Function that indicates if the heap is empty
+    * @return True if empty, false if not
+    */
+    bool isEmpty() const;
+
+    /**
+    * @return The number of entries in the heap
+    */
+    long size() const;
+
+    /**
+    * Makes sure both arrays can hold at least aCapacity entries without growing
+    * @param aCapacity The requested capacity
+    */
+    void reserve( long aCapacity );
+
+    /**
+    * Removes every entry, the capacity is kept
+    */
+    void clear();
+
+private:
+    typedef typename std::allocator_traits<Allocator>::template rebind_alloc<P> PayloadAllocator;
+    typedef MinMaxSplitStore<K, P, Compare> Store;
+
+    /**
+    * Appends an entry and bubbles it up
+    */
+    template <class U, class V>
+    void push( U&& aKey, V&& aPayload );
+
+    /**
+    * Drops the moved-from last slot of both arrays after a pop
+    */
+    void popBack();
+
+    /**
+    * @return The engine's view of the two arrays
+    */
+    Store store() const;
+
+    Compare mCompare;                               //!< The ordering of the keys
+    std::vector<K, Allocator> mKeys;                //!< The keys, heap index i lives in slot i - 1
+    std::vector<P, PayloadAllocator> mPayloads;     //!< The payloads, parallel to mKeys
+};
+
+#include "KeyedMinMaxHeap.hpp"
+#endif // !KEYED_MIN_MAX_HEAP_H
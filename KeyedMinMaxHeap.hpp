@@ -0,0 +1,174 @@
+/**
+*	@file : KeyedMinMaxHeap.hpp
+*	@author :  Haaris Chaudhry
+*	@date : Mar 9, 2017
+*	Purpose: Implementation of the KeyedMinMaxHeap class template.
+*/
+
+#include "PrecondViolatedExcep.h"
+
+template <class K, class P, class Compare, class Allocator>
+KeyedMinMaxHeap<K, P, Compare, Allocator>::KeyedMinMaxHeap( long aSize, const Compare& aCompare ) :
+    mCompare( aCompare )
+{
+    reserve( aSize );
+}
+
+template <class K, class P, class Compare, class Allocator>
+KeyedMinMaxHeap<K, P, Compare, Allocator>::KeyedMinMaxHeap( long aSize, const K keys[], const P payloads[], long valuesSize ) :
+    mCompare()
+{
+    reserve( ( aSize > valuesSize ) ? aSize : valuesSize );
+    mKeys.assign( keys, keys + valuesSize );
+    mPayloads.assign( payloads, payloads + valuesSize );
+
+    Store heapStore = store();
+    MinMaxHeapEngine::build( heapStore, size() );
+}
+
+// The payload is pushed first so a failed key push leaves both arrays the same length after the undo
+template <class K, class P, class Compare, class Allocator>
+template <class U, class V>
+void KeyedMinMaxHeap<K, P, Compare, Allocator>::push( U&& aKey, V&& aPayload )
+{
+    mPayloads.push_back( std::forward<V>( aPayload ) );
+
+    try
+    {
+        mKeys.push_back( std::forward<U>( aKey ) );
+    }
+    catch( ... )
+    {
+        mPayloads.pop_back();
+        throw;
+    }
+
+    Store heapStore = store();
+    MinMaxHeapEngine::bubbleUp( heapStore, size() );
+}
+
+template <class K, class P, class Compare, class Allocator>
+void KeyedMinMaxHeap<K, P, Compare, Allocator>::insert( const K& aKey, const P& aPayload )
+{
+    push( aKey, aPayload );
+}
+
+template <class K, class P, class Compare, class Allocator>
+void KeyedMinMaxHeap<K, P, Compare, Allocator>::insert( K&& aKey, P&& aPayload )
+{
+    push( std::move( aKey ), std::move( aPayload ) );
+}
+
+template <class K, class P, class Compare, class Allocator>
+typename KeyedMinMaxHeap<K, P, Compare, Allocator>::value_type KeyedMinMaxHeap<K, P, Compare, Allocator>::deleteMin()
+{
+    if( isEmpty() )
+    {
+        throw PrecondViolatedExcep( "deleteMin attempted on an empty heap" );
+    }
+
+    Store heapStore = store();
+    long numNodes = size();
+    value_type minEntry = MinMaxHeapEngine::popMin( heapStore, numNodes );
+    popBack();
+    return minEntry;
+}
+
+template <class K, class P, class Compare, class Allocator>
+typename KeyedMinMaxHeap<K, P, Compare, Allocator>::value_type KeyedMinMaxHeap<K, P, Compare, Allocator>::deleteMax()
+{
+    if( isEmpty() )
+    {
+        throw PrecondViolatedExcep( "deleteMax attempted on an empty heap" );
+    }
+
+    Store heapStore = store();
+    long numNodes = size();
+    value_type maxEntry = MinMaxHeapEngine::popMax( heapStore, numNodes );
+    popBack();
+    return maxEntry;
+}
+
+template <class K, class P, class Compare, class Allocator>
+void KeyedMinMaxHeap<K, P, Compare, Allocator>::popBack()
+{
+    mKeys.pop_back();
+    mPayloads.pop_back();
+}
+
+template <class K, class P, class Compare, class Allocator>
+const K& KeyedMinMaxHeap<K, P, Compare, Allocator>::peekMin() const
+{
+    if( isEmpty() )
+    {
+        throw PrecondViolatedExcep( "peekMin attempted on an empty heap" );
+    }
+
+    return mKeys[0];
+}
+
+template <class K, class P, class Compare, class Allocator>
+const P& KeyedMinMaxHeap<K, P, Compare, Allocator>::peekMinPayload() const
+{
+    if( isEmpty() )
+    {
+        throw PrecondViolatedExcep( "peekMinPayload attempted on an empty heap" );
+    }
+
+    return mPayloads[0];
+}
+
+template <class K, class P, class Compare, class Allocator>
+const K& KeyedMinMaxHeap<K, P, Compare, Allocator>::peekMax() const
+{
+    if( isEmpty() )
+    {
+        throw PrecondViolatedExcep( "peekMax attempted on an empty heap" );
+    }
+
+    return mKeys[MinMaxHeapEngine::maxIndex( store(), size() ) - 1];
+}
+
+template <class K, class P, class Compare, class Allocator>
+const P& KeyedMinMaxHeap<K, P, Compare, Allocator>::peekMaxPayload() const
+{
+    if( isEmpty() )
+    {
+        throw PrecondViolatedExcep( "peekMaxPayload attempted on an empty heap" );
+    }
+
+    return mPayloads[MinMaxHeapEngine::maxIndex( store(), size() ) - 1];
+}
+
+template <class K, class P, class Compare, class Allocator>
+bool KeyedMinMaxHeap<K, P, Compare, Allocator>::isEmpty() const
+{
+    return mKeys.empty();
+}
+
+template <class K, class P, class Compare, class Allocator>
+long KeyedMinMaxHeap<K, P, Compare, Allocator>::size() const
+{
+    return static_cast<long>( mKeys.size() );
+}
+
+template <class K, class P, class Compare, class Allocator>
+void KeyedMinMaxHeap<K, P, Compare, Allocator>::reserve( long aCapacity )
+{
+    mKeys.reserve( aCapacity );
+    mPayloads.reserve( aCapacity );
+}
+
+template <class K, class P, class Compare, class Allocator>
+void KeyedMinMaxHeap<K, P, Compare, Allocator>::clear()
+{
+    mKeys.clear();
+    mPayloads.clear();
+}
+
+// The Store writes through the arrays, the const members only ever read through it
+template <class K, class P, class Compare, class Allocator>
+typename KeyedMinMaxHeap<K, P, Compare, Allocator>::Store KeyedMinMaxHeap<K, P, Compare, Allocator>::store() const
+{
+    return Store( const_cast<K*>( mKeys.data() ), const_cast<P*>( mPayloads.data() ), mCompare );
+}
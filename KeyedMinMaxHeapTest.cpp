@@ -0,0 +1,132 @@
+/**
+*	@file : KeyedMinMaxHeapTest.cpp
+*	@author :  Haaris Chaudhry
+*	@date : Mar 9, 2017
+*	Purpose: Checks that every KeyedMinMaxHeap payload stays with its key through random inserts,
+*          deletes from both ends and the two array constructor, against a std::multiset of entries.
+*/
+
+#include "KeyedMinMaxHeap.h"
+#include "MinMaxTest.h"
+#include <iterator>
+#include <random>
+#include <set>
+#include <string>
+#include <utility>
+#include <vector>
+
+namespace
+{
+    // The payload names its key, so a payload that moved without its key is caught
+    std::string payloadOf( long aKey, long aId )
+    {
+        return std::to_string( aKey ) + "/" + std::to_string( aId ) + std::string( 24, '.' );
+    }
+
+    bool attached( const std::pair<long, std::string>& aEntry )
+    {
+        return aEntry.second.compare( 0, aEntry.second.find( '/' ), std::to_string( aEntry.first ) ) == 0;
+    }
+
+    typedef KeyedMinMaxHeap<long, std::string> Heap;
+
+    typedef std::multiset<std::pair<long, std::string> > Reference;
+
+    // The deleted entry has to be in the reference with its payload, and carry the expected key
+    bool checkRemoved( const MinMaxTest::Run& aRun, const std::pair<long, std::string>& aRemoved, long aExpectedKey, Reference& aReference )
+    {
+        Reference::iterator found = aReference.find( aRemoved );
+
+        if( !MINMAX_CHECK_EQUAL( aRun, aRemoved.first, aExpectedKey ) || !MINMAX_CHECK_STEP( aRun, attached( aRemoved ) )
+            || !MINMAX_CHECK_STEP( aRun, found != aReference.end() ) )
+        {
+            return false;
+        }
+
+        aReference.erase( found );
+        return true;
+    }
+
+    void runAgainstReference( Heap& aHeap, Reference& aReference, const std::string& aName, long aRange, unsigned long aSeed )
+    {
+        bool passed = MinMaxTest::runSteps( aName, aSeed, 5000, [&]( std::mt19937& aRandom, const MinMaxTest::Run& aRun )
+        {
+            long choice = static_cast<long>( aRandom() % 10 );
+
+            if( choice < 5 || aReference.empty() )
+            {
+                long key = static_cast<long>( aRandom() % aRange );
+                std::string payload = payloadOf( key, aRun.mOp );
+                aHeap.insert( key, payload );
+                aReference.insert( std::make_pair( key, payload ) );
+            }
+            else
+            {
+                long expectedKey = ( choice < 8 ) ? aReference.begin()->first : aReference.rbegin()->first;
+
+                if( !checkRemoved( aRun, ( choice < 8 ) ? aHeap.deleteMin() : aHeap.deleteMax(), expectedKey, aReference ) )
+                {
+                    return;
+                }
+            }
+
+            MINMAX_CHECK_EQUAL( aRun, aHeap.size(), static_cast<long>( aReference.size() ) )
+                && ( aHeap.isEmpty()
+                     || ( MINMAX_CHECK_EQUAL( aRun, aHeap.peekMin(), aReference.begin()->first )
+                          && MINMAX_CHECK_EQUAL( aRun, aHeap.peekMax(), aReference.rbegin()->first )
+                          && MINMAX_CHECK_EQUAL( aRun, aHeap.peekMinPayload().substr( 0, aHeap.peekMinPayload().find( '/' ) ), std::to_string( aHeap.peekMin() ) )
+                          && MINMAX_CHECK_EQUAL( aRun, aHeap.peekMaxPayload().substr( 0, aHeap.peekMaxPayload().find( '/' ) ), std::to_string( aHeap.peekMax() ) ) ) );
+        } );
+
+        // Then every entry left comes out in key order with its payload
+        MinMaxTest::Run drain( aName + ", drain", aSeed );
+
+        for( ; passed && !aHeap.isEmpty(); drain.mOp++ )
+        {
+            long expectedKey = aReference.begin()->first;
+            passed = checkRemoved( drain, aHeap.deleteMin(), expectedKey, aReference );
+        }
+
+        MINMAX_CHECK( !passed || aReference.empty() );
+    }
+}
+
+int main()
+{
+    std::mt19937 random( 2017 );
+    const long ranges[] = { 1L << 30, 30, 1 };
+
+    for( size_t r = 0; r < sizeof( ranges ) / sizeof( ranges[0] ); r++ )
+    {
+        Heap heap;
+        Reference reference;
+        runAgainstReference( heap, reference, "range " + std::to_string( ranges[r] ), ranges[r], random() );
+    }
+
+    // The two array constructor heapifies the keys, every payload has to come along
+    for( long size = 0; size <= 1000; size += ( size < 10 ) ? 1 : 331 )
+    {
+        std::vector<long> keys;
+        std::vector<std::string> payloads;
+        Reference reference;
+
+        for( long i = 0; i < size; i++ )
+        {
+            keys.push_back( static_cast<long>( random() % 100 ) );
+            payloads.push_back( payloadOf( keys.back(), i ) );
+            reference.insert( std::make_pair( keys.back(), payloads.back() ) );
+        }
+
+        Heap heap( 0, keys.data(), payloads.data(), size );
+        MINMAX_CHECK( heap.size() == size );
+        runAgainstReference( heap, reference, "array of " + std::to_string( size ), 100, random() );
+    }
+
+    Heap empty;
+    MINMAX_CHECK_THROWS( empty.deleteMin() );
+    MINMAX_CHECK_THROWS( empty.deleteMax() );
+    MINMAX_CHECK_THROWS( empty.peekMinPayload() );
+    MINMAX_CHECK_THROWS( empty.peekMaxPayload() );
+
+    return MinMaxTest::report( "KeyedMinMaxHeapTest" );
+}
@@ -0,0 +1,211 @@
+/**
+*	@file : LazyEraseMinMaxHeap.h
+*	@author :  Haaris Chaudhry
+*	@date : Mar 9, 2017
+*	Purpose: A MinMaxHeap whose values can be cancelled by key without handles.  An open addressing
+*          hash table counts, for every distinct key in the heap, how many values equal it and how
+*          many of those are cancelled.  eraseLazy only bumps the cancelled count (a tombstone); the
+*          value stays in the heap until it reaches either end, where it is dropped before anyone can
+*          see it, so the minimum and the maximum in the heap are never tombstoned and the peeks stay
+*          O(1).  A key with no uncancelled value left, such as a cancel that arrives after its value
+*          was already deleted, is refused.  Once the tombstones outnumber a given share of the heap,
+*          the heap is compacted with one bottom up rebuild (see MinMaxHeap::eraseIf), which also
+*          keeps a heap full of dead values from growing deeper.
+*
+*          Every insert and delete updates the table, one hash probe each.  Equal keys are
+*          interchangeable: erasing a key that was inserted twice cancels one of the two.  KeyEqual
+*          has to agree with the equivalence of Compare, and T has to be default constructible for
+*          the empty slots of the table.
+*/
+
+#ifndef LAZY_ERASE_MIN_MAX_HEAP_H
+#define LAZY_ERASE_MIN_MAX_HEAP_H
+
+#include "MinMaxHeap.h"
+#include <cstdint>
+#include <functional>
+#include <memory>
+#include <vector>
+
+template <class T, class Compare = std::less<T>, class Hash = std::hash<T>, class KeyEqual = std::equal_to<T>, class Allocator = std::allocator<T> >
+class LazyEraseMinMaxHeap
+{
+public:
+    typedef T value_type;
+    typedef Compare value_compare;
+    typedef Hash hasher;
+    typedef KeyEqual key_equal;
+    typedef Allocator allocator_type;
+
+    static const double kDefaultTombstoneRatio;     //!< 0.25, compaction costs four values visited per erase
+
+    /**
+    * Constructor for the LazyEraseMinMaxHeap
+    * @param aSize The initial capacity of the heap
+    * @param aMaxTombstoneRatio The share of the heap that may be tombstoned before it is compacted,
+    *        greater than 0 (throws PrecondViolatedExcep otherwise)
+    * @param aCompare The strict weak ordering used to compare values
+    * @return An empty heap
+    */
+    explicit LazyEraseMinMaxHeap( long aSize = 0, double aMaxTombstoneRatio = kDefaultTombstoneRatio, const Compare& aCompare = Compare() );
+
+    /**
+    * The insertion function, also heapifies the value
+    * @param aValue The value to be inserted
+    */
+    void insert( const T& aValue );
+
+    void insert( T&& aValue );
+
+    /**
+    * Cancels one value equal to aKey. A value at either end of the heap is deleted straight away,
+    * any other one is tombstoned.
+    * @param aKey The value to cancel
+    * @return False if every value equal to aKey is already cancelled or gone, nothing is recorded then
+    */
+    bool eraseLazy( const T& aKey );
+
+    /**
+    * Deletes the minimum value that has not been cancelled
+    * @return The value that was deleted (throws PrecondViolatedExcep if the heap is empty)
+    */
+    T deleteMin();
+
+    /**
+    * Deletes the maximum value that has not been cancelled
+    * @return The value that was deleted (throws PrecondViolatedExcep if the heap is empty)
+    */
+    T deleteMax();
+
+    /**
+    * Reads the minimum value that has not been cancelled, O(1)
+    * @return The minimum value (throws PrecondViolatedExcep if the heap is empty)
+    */
+    const T& peekMin() const;
+
+    /**
+    * Reads the maximum value that has not been cancelled, O(1)
+    * @return The maximum value (throws PrecondViolatedExcep if the heap is empty)
+    */
+    const T& peekMax() const;
+
+    /**
+    * Drops every tombstoned value with one bottom up rebuild
+    */
+    void compact();
+
+    /**
+    * Function that indicates if the heap is empty
+    * @return True if empty, false if not
+    */
+    bool isEmpty() const;
+
+    /**
+    * @return The number of values in the heap that have not been cancelled
+    */
+    long size() const;
+
+    /**
+    * @return The number of cancelled values still waiting in the heap
+    */
+    long tombstones() const;
+
+    /**
+    * @return The share of the heap that may be tombstoned before it is compacted
+    */
+    double maxTombstoneRatio() const;
+
+    /**
+    * Removes every value and tombstone, the capacities are kept
+    */
+    void clear();
+
+private:
+    /**
+    * A slot of the key table, empty while mInHeap is 0
+    */
+    struct KeyCount
+    {
+        KeyCount();
+
+        T mKey;             //!< The key
+        long mInHeap;       //!< How many values equal to mKey are in the heap, cancelled or not
+        long mCancelled;    //!< How many of those are cancelled, at most mInHeap
+    };
+
+    typedef typename std::allocator_traits<Allocator>::template rebind_alloc<KeyCount> KeyCountAllocator;
+
+    static const int kMinimumTableBits = 4;
+
+    /**
+    * @return The slot a key's probe sequence starts at, Fibonacci hashing over the table's size
+    */
+    long homeSlot( const T& aKey ) const;
+
+    /**
+    * @return The slot holding aKey, or the empty slot its probe sequence ends at
+    */
+    long findSlot( const T& aKey ) const;
+
+    /**
+    * Counts one more value equal to aKey in the heap, growing the table at half load
+    * @return The slot of aKey
+    */
+    long countInserted( const T& aKey );
+
+    /**
+    * Counts one value out of the heap, freeing the slot once none is left
+    * @param aSlot The slot of the value's key
+    */
+    void countRemoved( long aSlot );
+
+    /**
+    * Uses up one tombstone of aValue, if there is one, and counts the value out of the heap
+    * @return True if aValue was cancelled and has to be dropped
+    */
+    bool consumeTombstone( const T& aValue );
+
+    /**
+    * Inserts a value into the heap after counting it
+    */
+    template <class U>
+    void push( U&& aValue );
+
+    /**
+    * Empties slot aSlot and shifts the rest of its cluster back, so no probe sequence is broken
+    */
+    void removeSlot( long aSlot );
+
+    /**
+    * Doubles the table and reinserts every key
+    */
+    void growTable();
+
+    /**
+    * Empties every slot of the table
+    */
+    void resetTable();
+
+    /**
+    * Drops cancelled values from both ends until neither end is cancelled
+    */
+    void purgeEnds();
+
+    /**
+    * Compacts once the tombstones pass mMaxTombstoneRatio of the heap
+    */
+    void compactIfNeeded();
+
+    MinMaxHeap<T, Compare, Allocator> mHeap;                //!< The values, cancelled or not
+    Compare mCompare;                                       //!< The ordering of the values
+    Hash mHash;                                             //!< Hashes the keys of the table
+    KeyEqual mEqual;                                        //!< Matches the keys of the table
+    std::vector<KeyCount, KeyCountAllocator> mTable;        //!< Open addressing, linear probing
+    int mTableBits;                                         //!< The table has 2^mTableBits slots
+    long mNumSlotsUsed;                                     //!< Slots with a count
+    long mNumTombstones;                                    //!< The sum of the cancelled counts
+    double mMaxTombstoneRatio;                              //!< Compaction threshold
+};
+
+#include "LazyEraseMinMaxHeap.hpp"
+#endif // !LAZY_ERASE_MIN_MAX_HEAP_H
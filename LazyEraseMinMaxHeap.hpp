@@ -0,0 +1,337 @@
+/**
+*	@file : LazyEraseMinMaxHeap.hpp
+*	@author :  Haaris Chaudhry
+*	@date : Mar 9, 2017
+*	Purpose: Implementation of the LazyEraseMinMaxHeap class template.
+*/
+
+#include "PrecondViolatedExcep.h"
+#include <utility>
+
+template <class T, class Compare, class Hash, class KeyEqual, class Allocator>
+const double LazyEraseMinMaxHeap<T, Compare, Hash, KeyEqual, Allocator>::kDefaultTombstoneRatio = 0.25;
+
+template <class T, class Compare, class Hash, class KeyEqual, class Allocator>
+LazyEraseMinMaxHeap<T, Compare, Hash, KeyEqual, Allocator>::KeyCount::KeyCount() :
+    mKey(),
+    mInHeap( 0 ),
+    mCancelled( 0 )
+{
+}
+
+template <class T, class Compare, class Hash, class KeyEqual, class Allocator>
+LazyEraseMinMaxHeap<T, Compare, Hash, KeyEqual, Allocator>::LazyEraseMinMaxHeap( long aSize, double aMaxTombstoneRatio, const Compare& aCompare ) :
+    mHeap( aSize, aCompare ),
+    mCompare( aCompare ),
+    mHash(),
+    mEqual(),
+    mTable( 1L << kMinimumTableBits ),
+    mTableBits( kMinimumTableBits ),
+    mNumSlotsUsed( 0 ),
+    mNumTombstones( 0 ),
+    mMaxTombstoneRatio( aMaxTombstoneRatio )
+{
+    if( !( mMaxTombstoneRatio > 0.0 ) )
+    {
+        throw PrecondViolatedExcep( "Lazy erase heap needs a tombstone ratio greater than 0" );
+    }
+}
+
+template <class T, class Compare, class Hash, class KeyEqual, class Allocator>
+void LazyEraseMinMaxHeap<T, Compare, Hash, KeyEqual, Allocator>::insert( const T& aValue )
+{
+    push( aValue );
+}
+
+template <class T, class Compare, class Hash, class KeyEqual, class Allocator>
+void LazyEraseMinMaxHeap<T, Compare, Hash, KeyEqual, Allocator>::insert( T&& aValue )
+{
+    push( std::move( aValue ) );
+}
+
+// The slot is taken before the value may be moved from, and nothing else touches the table until the
+// heap has it. A new value equal to a cancelled one may land at an end, where it stands in for it.
+template <class T, class Compare, class Hash, class KeyEqual, class Allocator>
+template <class U>
+void LazyEraseMinMaxHeap<T, Compare, Hash, KeyEqual, Allocator>::push( U&& aValue )
+{
+    long slot = countInserted( aValue );
+
+    try
+    {
+        mHeap.insert( std::forward<U>( aValue ) );
+    }
+    catch( ... )
+    {
+        countRemoved( slot );
+        throw;
+    }
+
+    purgeEnds();
+}
+
+// The ends are never tombstoned, so a key equal to either one is simply deleted
+template <class T, class Compare, class Hash, class KeyEqual, class Allocator>
+bool LazyEraseMinMaxHeap<T, Compare, Hash, KeyEqual, Allocator>::eraseLazy( const T& aKey )
+{
+    if( mHeap.isEmpty() )
+    {
+        return false;
+    }
+
+    long slot = findSlot( aKey );
+
+    if( mTable[slot].mInHeap == mTable[slot].mCancelled )
+    {
+        return false;
+    }
+
+    if( mEqual( aKey, mHeap.peekMin() ) )
+    {
+        mHeap.deleteMin();
+        countRemoved( slot );
+        purgeEnds();
+    }
+    else if( mEqual( aKey, mHeap.peekMax() ) )
+    {
+        mHeap.deleteMax();
+        countRemoved( slot );
+        purgeEnds();
+    }
+    else
+    {
+        mTable[slot].mCancelled++;
+        mNumTombstones++;
+    }
+
+    compactIfNeeded();
+    return true;
+}
+
+template <class T, class Compare, class Hash, class KeyEqual, class Allocator>
+T LazyEraseMinMaxHeap<T, Compare, Hash, KeyEqual, Allocator>::deleteMin()
+{
+    T minValue = mHeap.deleteMin();
+    countRemoved( findSlot( minValue ) );
+    purgeEnds();
+    compactIfNeeded();
+    return minValue;
+}
+
+template <class T, class Compare, class Hash, class KeyEqual, class Allocator>
+T LazyEraseMinMaxHeap<T, Compare, Hash, KeyEqual, Allocator>::deleteMax()
+{
+    T maxValue = mHeap.deleteMax();
+    countRemoved( findSlot( maxValue ) );
+    purgeEnds();
+    compactIfNeeded();
+    return maxValue;
+}
+
+template <class T, class Compare, class Hash, class KeyEqual, class Allocator>
+const T& LazyEraseMinMaxHeap<T, Compare, Hash, KeyEqual, Allocator>::peekMin() const
+{
+    return mHeap.peekMin();
+}
+
+template <class T, class Compare, class Hash, class KeyEqual, class Allocator>
+const T& LazyEraseMinMaxHeap<T, Compare, Hash, KeyEqual, Allocator>::peekMax() const
+{
+    return mHeap.peekMax();
+}
+
+// eraseIf visits every value once and rebuilds bottom up only if something went
+template <class T, class Compare, class Hash, class KeyEqual, class Allocator>
+void LazyEraseMinMaxHeap<T, Compare, Hash, KeyEqual, Allocator>::compact()
+{
+    if( mNumTombstones == 0 )
+    {
+        return;
+    }
+
+    mHeap.eraseIf( [this]( const T& aValue ) { return consumeTombstone( aValue ); } );
+}
+
+// Every compaction drops more than mMaxTombstoneRatio of the heap, all of it paid for by earlier erases
+template <class T, class Compare, class Hash, class KeyEqual, class Allocator>
+void LazyEraseMinMaxHeap<T, Compare, Hash, KeyEqual, Allocator>::compactIfNeeded()
+{
+    if( mNumTombstones > mMaxTombstoneRatio * mHeap.size() )
+    {
+        compact();
+    }
+}
+
+template <class T, class Compare, class Hash, class KeyEqual, class Allocator>
+bool LazyEraseMinMaxHeap<T, Compare, Hash, KeyEqual, Allocator>::isEmpty() const
+{
+    return mHeap.isEmpty();
+}
+
+template <class T, class Compare, class Hash, class KeyEqual, class Allocator>
+long LazyEraseMinMaxHeap<T, Compare, Hash, KeyEqual, Allocator>::size() const
+{
+    return mHeap.size() - mNumTombstones;
+}
+
+template <class T, class Compare, class Hash, class KeyEqual, class Allocator>
+long LazyEraseMinMaxHeap<T, Compare, Hash, KeyEqual, Allocator>::tombstones() const
+{
+    return mNumTombstones;
+}
+
+template <class T, class Compare, class Hash, class KeyEqual, class Allocator>
+double LazyEraseMinMaxHeap<T, Compare, Hash, KeyEqual, Allocator>::maxTombstoneRatio() const
+{
+    return mMaxTombstoneRatio;
+}
+
+template <class T, class Compare, class Hash, class KeyEqual, class Allocator>
+void LazyEraseMinMaxHeap<T, Compare, Hash, KeyEqual, Allocator>::clear()
+{
+    mHeap.clear();
+    resetTable();
+}
+
+// Multiplying by 2^64 / phi spreads even consecutive hashes over the top bits, which pick the slot
+template <class T, class Compare, class Hash, class KeyEqual, class Allocator>
+long LazyEraseMinMaxHeap<T, Compare, Hash, KeyEqual, Allocator>::homeSlot( const T& aKey ) const
+{
+    std::uint64_t mixed = static_cast<std::uint64_t>( mHash( aKey ) ) * UINT64_C( 0x9E3779B97F4A7C15 );
+    return static_cast<long>( mixed >> ( 64 - mTableBits ) );
+}
+
+template <class T, class Compare, class Hash, class KeyEqual, class Allocator>
+long LazyEraseMinMaxHeap<T, Compare, Hash, KeyEqual, Allocator>::findSlot( const T& aKey ) const
+{
+    long mask = static_cast<long>( mTable.size() ) - 1;
+    long slot = homeSlot( aKey );
+
+    while( mTable[slot].mInHeap != 0 && !mEqual( mTable[slot].mKey, aKey ) )
+    {
+        slot = ( slot + 1 ) & mask;
+    }
+
+    return slot;
+}
+
+template <class T, class Compare, class Hash, class KeyEqual, class Allocator>
+long LazyEraseMinMaxHeap<T, Compare, Hash, KeyEqual, Allocator>::countInserted( const T& aKey )
+{
+    long slot = findSlot( aKey );
+
+    if( mTable[slot].mInHeap == 0 )
+    {
+        if( 2 * ( mNumSlotsUsed + 1 ) > static_cast<long>( mTable.size() ) )
+        {
+            growTable();
+            slot = findSlot( aKey );
+        }
+
+        mTable[slot].mKey = aKey;
+        mNumSlotsUsed++;
+    }
+
+    mTable[slot].mInHeap++;
+    return slot;
+}
+
+template <class T, class Compare, class Hash, class KeyEqual, class Allocator>
+void LazyEraseMinMaxHeap<T, Compare, Hash, KeyEqual, Allocator>::countRemoved( long aSlot )
+{
+    if( --mTable[aSlot].mInHeap == 0 )
+    {
+        removeSlot( aSlot );
+    }
+}
+
+template <class T, class Compare, class Hash, class KeyEqual, class Allocator>
+bool LazyEraseMinMaxHeap<T, Compare, Hash, KeyEqual, Allocator>::consumeTombstone( const T& aValue )
+{
+    long slot = findSlot( aValue );
+
+    if( mTable[slot].mCancelled == 0 )
+    {
+        return false;
+    }
+
+    mTable[slot].mCancelled--;
+    mNumTombstones--;
+    countRemoved( slot );
+    return true;
+}
+
+// An entry further along the cluster moves into the gap unless its home lies cyclically in ( gap, entry ],
+// where a probe for it would never pass the gap
+template <class T, class Compare, class Hash, class KeyEqual, class Allocator>
+void LazyEraseMinMaxHeap<T, Compare, Hash, KeyEqual, Allocator>::removeSlot( long aSlot )
+{
+    long mask = static_cast<long>( mTable.size() ) - 1;
+    long gap = aSlot;
+
+    for( long slot = ( gap + 1 ) & mask; mTable[slot].mInHeap != 0; slot = ( slot + 1 ) & mask )
+    {
+        long home = homeSlot( mTable[slot].mKey );
+
+        if( ( ( slot - home ) & mask ) >= ( ( slot - gap ) & mask ) )
+        {
+            mTable[gap] = std::move( mTable[slot] );
+            mTable[slot].mInHeap = 0;
+            gap = slot;
+        }
+    }
+
+    mTable[gap] = KeyCount();
+    mNumSlotsUsed--;
+}
+
+template <class T, class Compare, class Hash, class KeyEqual, class Allocator>
+void LazyEraseMinMaxHeap<T, Compare, Hash, KeyEqual, Allocator>::growTable()
+{
+    std::vector<KeyCount, KeyCountAllocator> oldTable( 2 * mTable.size() );
+    oldTable.swap( mTable );
+    mTableBits++;
+
+    for( size_t i = 0; i < oldTable.size(); i++ )
+    {
+        if( oldTable[i].mInHeap != 0 )
+        {
+            mTable[findSlot( oldTable[i].mKey )] = std::move( oldTable[i] );
+        }
+    }
+}
+
+template <class T, class Compare, class Hash, class KeyEqual, class Allocator>
+void LazyEraseMinMaxHeap<T, Compare, Hash, KeyEqual, Allocator>::resetTable()
+{
+    if( mNumSlotsUsed > 0 )
+    {
+        for( size_t i = 0; i < mTable.size(); i++ )
+        {
+            mTable[i] = KeyCount();
+        }
+    }
+
+    mNumSlotsUsed = 0;
+    mNumTombstones = 0;
+}
+
+template <class T, class Compare, class Hash, class KeyEqual, class Allocator>
+void LazyEraseMinMaxHeap<T, Compare, Hash, KeyEqual, Allocator>::purgeEnds()
+{
+    while( mNumTombstones > 0 )
+    {
+        if( consumeTombstone( mHeap.peekMin() ) )
+        {
+            mHeap.deleteMin();
+        }
+        else if( consumeTombstone( mHeap.peekMax() ) )
+        {
+            mHeap.deleteMax();
+        }
+        else
+        {
+            return;
+        }
+    }
+}
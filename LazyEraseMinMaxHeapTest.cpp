@@ -0,0 +1,142 @@
+/**
+*	@file : LazyEraseMinMaxHeapTest.cpp
+*	@author :  Haaris Chaudhry
+*	@date : Mar 9, 2017
+*	Purpose: Checks LazyEraseMinMaxHeap against a std::multiset through random inserts, cancels of keys
+*          that are and are not in the heap, deletes from both ends and compactions, at several
+*          tombstone ratios.
+*/
+
+#include "LazyEraseMinMaxHeap.h"
+#include "MinMaxTest.h"
+#include <iterator>
+#include <random>
+#include <set>
+#include <sstream>
+#include <string>
+
+namespace
+{
+    void runAgainstReference( double aRatio, int aRange, unsigned long aSeed )
+    {
+        LazyEraseMinMaxHeap<int> heap( 0, aRatio );
+        std::multiset<int> reference;
+        std::ostringstream name;
+        name << "ratio " << aRatio << ", range " << aRange;
+
+        MinMaxTest::runSteps( name.str(), aSeed, 5000, [&]( std::mt19937& aRandom, const MinMaxTest::Run& aRun )
+        {
+            long choice = static_cast<long>( aRandom() % 10 );
+
+            if( choice < 4 )
+            {
+                int value = static_cast<int>( aRandom() % aRange );
+                heap.insert( value );
+                reference.insert( value );
+            }
+            else if( choice < 7 && !reference.empty() )
+            {
+                std::multiset<int>::iterator target = reference.begin();
+                std::advance( target, aRandom() % reference.size() );
+                int key = *target;
+                reference.erase( target );
+
+                if( !MINMAX_CHECK_STEP( aRun, heap.eraseLazy( key ) ) )
+                {
+                    return;
+                }
+            }
+            else if( choice == 7 )
+            {
+                // Keys that were never inserted, or whose values are all cancelled or gone, are refused
+                int key = static_cast<int>( aRandom() % ( aRange + 2 ) ) - 1;
+                bool inHeap = reference.count( key ) > 0;
+
+                if( inHeap )
+                {
+                    reference.erase( reference.find( key ) );
+                }
+
+                if( !MINMAX_CHECK_EQUAL( aRun, heap.eraseLazy( key ), inHeap ) )
+                {
+                    return;
+                }
+            }
+            else if( choice >= 8 && !reference.empty() && !MINMAX_CHECK_DELETE( aRun, heap, reference, choice == 9 ) )
+            {
+                return;
+            }
+
+            if( aRandom() % 100 == 0 )
+            {
+                heap.compact();
+
+                if( !MINMAX_CHECK_EQUAL( aRun, heap.tombstones(), 0L ) )
+                {
+                    return;
+                }
+            }
+
+            MINMAX_CHECK_ENDS( aRun, heap, reference )
+                && MINMAX_CHECK_STEP( aRun, heap.tombstones() <= aRatio * ( heap.size() + heap.tombstones() ) );
+        } );
+    }
+}
+
+int main()
+{
+    std::mt19937 random( 2017 );
+    const double ratios[] = { 0.05, 0.25, 1.0, 5.0 };
+    const int ranges[] = { 1 << 30, 200, 5 };
+
+    for( size_t r = 0; r < sizeof( ratios ) / sizeof( ratios[0] ); r++ )
+    {
+        for( size_t k = 0; k < sizeof( ranges ) / sizeof( ranges[0] ); k++ )
+        {
+            runAgainstReference( ratios[r], ranges[k], random() );
+        }
+    }
+
+    // A cancel for a key that is not in the heap, even one between the ends, records nothing
+    LazyEraseMinMaxHeap<int> orders;
+
+    for( int i = 0; i < 20; i++ )
+    {
+        orders.insert( i * 10 );
+    }
+
+    MINMAX_CHECK( !orders.eraseLazy( 55 ) && orders.size() == 20 && orders.tombstones() == 0 );
+    orders.insert( 55 );
+    MINMAX_CHECK( orders.eraseLazy( 50 ) && orders.tombstones() == 1 );
+    MINMAX_CHECK( !orders.eraseLazy( 50 ) && orders.size() == 20 );
+
+    bool saw55 = false;
+    bool saw50 = false;
+
+    while( !orders.isEmpty() )
+    {
+        int value = orders.deleteMin();
+        saw55 = saw55 || value == 55;
+        saw50 = saw50 || value == 50;
+    }
+
+    MINMAX_CHECK( saw55 && !saw50 && orders.tombstones() == 0 );
+    MINMAX_CHECK( !orders.eraseLazy( 0 ) );
+
+    LazyEraseMinMaxHeap<std::string> words;
+    words.insert( "b" );
+    words.insert( "a" );
+    words.insert( "c" );
+    words.insert( "bb" );
+    MINMAX_CHECK( words.eraseLazy( "b" ) && words.tombstones() == 1 && words.size() == 3 );
+
+    LazyEraseMinMaxHeap<std::string> copy( words );
+    MINMAX_CHECK( copy.deleteMin() == "a" && copy.deleteMin() == "bb" && copy.deleteMin() == "c" && copy.isEmpty() );
+    MINMAX_CHECK_THROWS( copy.deleteMin() );
+    MINMAX_CHECK_THROWS( LazyEraseMinMaxHeap<int>( 0, 0.0 ) );
+
+    words.clear();
+    MINMAX_CHECK( words.isEmpty() && words.tombstones() == 0 && !words.eraseLazy( "c" ) );
+
+    return MinMaxTest::report( "LazyEraseMinMaxHeapTest" );
+}
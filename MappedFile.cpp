@@ -0,0 +1,138 @@
+/**
+*	@file : MappedFile.cpp
+*	@author :  Haaris Chaudhry
+*	@date : Mar 9, 2017
+*	Purpose: Implementation of the MappedFile class.
+*/
+
+#include "MappedFile.h"
+#include "PrecondViolatedExcep.h"
+
+#if defined( __unix__ ) || defined( __APPLE__ )
+#define MAPPED_FILE_USE_MMAP 1
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#else
+#include <fstream>
+#endif
+
+#if defined( MAPPED_FILE_USE_MMAP )
+
+// The descriptor is only needed until the mapping exists. An empty file cannot be mapped, it is left
+// without data. A file that is read front to back gets aggressive read ahead; a copy-on-write mapping
+// is a private writable mapping, so its pages are copied the first time they are written.
+MappedFile::MappedFile( const std::string& aPath, Mode aMode ) :
+    mData( nullptr ),
+    mSize( 0 ),
+    mMode( aMode )
+{
+    int fd = open( aPath.c_str(), O_RDONLY );
+
+    if( fd < 0 )
+    {
+        throw PrecondViolatedExcep( "Could not open " + aPath );
+    }
+
+    struct stat status;
+
+    if( fstat( fd, &status ) != 0 )
+    {
+        close( fd );
+        throw PrecondViolatedExcep( "Could not read the size of " + aPath );
+    }
+
+    mSize = static_cast<long>( status.st_size );
+
+    if( mSize > 0 )
+    {
+        int protection = ( aMode == COPY_ON_WRITE ) ? ( PROT_READ | PROT_WRITE ) : PROT_READ;
+        void* mapping = mmap( nullptr, static_cast<size_t>( mSize ), protection, MAP_PRIVATE, fd, 0 );
+
+        if( mapping == MAP_FAILED )
+        {
+            close( fd );
+            throw PrecondViolatedExcep( "Could not map " + aPath );
+        }
+
+        mData = static_cast<char*>( mapping );
+
+        if( aMode == READ_ONLY )
+        {
+            madvise( mapping, static_cast<size_t>( mSize ), MADV_SEQUENTIAL );
+        }
+    }
+
+    close( fd );
+}
+
+MappedFile::~MappedFile()
+{
+    if( mData != nullptr )
+    {
+        munmap( mData, static_cast<size_t>( mSize ) );
+    }
+}
+
+#else
+
+// The buffer is private to the process, so it serves both modes
+MappedFile::MappedFile( const std::string& aPath, Mode aMode ) :
+    mData( nullptr ),
+    mSize( 0 ),
+    mMode( aMode )
+{
+    std::ifstream fileReader( aPath.c_str(), std::ios::binary | std::ios::ate );
+
+    if( !fileReader.is_open() )
+    {
+        throw PrecondViolatedExcep( "Could not open " + aPath );
+    }
+
+    mSize = static_cast<long>( fileReader.tellg() );
+
+    if( mSize > 0 )
+    {
+        mData = new char[mSize];
+        fileReader.seekg( 0 );
+
+        if( !fileReader.read( mData, mSize ) )
+        {
+            delete[] mData;
+            throw PrecondViolatedExcep( "Could not read " + aPath );
+        }
+    }
+}
+
+MappedFile::~MappedFile()
+{
+    delete[] mData;
+}
+
+#endif
+
+const char* MappedFile::begin() const
+{
+    return mData;
+}
+
+char* MappedFile::data()
+{
+    if( mMode != COPY_ON_WRITE )
+    {
+        throw PrecondViolatedExcep( "Write access attempted on a read only mapping" );
+    }
+
+    return mData;
+}
+
+const char* MappedFile::end() const
+{
+    return mData + mSize;
+}
+
+long MappedFile::size() const
+{
+    return mSize;
+}
@@ -0,0 +1,70 @@
+/**
+*	@file : MappedFile.h
+*	@author :  Haaris Chaudhry
+*	@date : Mar 9, 2017
+*	Purpose: Access to a whole file as one block of memory.  On POSIX systems the file is
+*          memory-mapped, so the kernel pages it in as it is read and nothing is copied; elsewhere the
+*          file is read into a buffer once.  A copy-on-write mapping can also be written to: the pages
+*          that are touched become private copies and the file itself never changes.
+*/
+
+#ifndef MAPPED_FILE_H
+#define MAPPED_FILE_H
+
+#include <string>
+
+class MappedFile
+{
+public:
+    /**
+    * How the contents may be used
+    */
+    enum Mode
+    {
+        READ_ONLY = 0,      //!< The file is read front to back
+        COPY_ON_WRITE = 1   //!< The contents may be modified in memory, in any order
+    };
+
+    /**
+    * Opens and maps a file
+    * @param aPath The path of the file
+    * @param aMode Whether the mapping may be written to
+    * @return The mapped file (throws PrecondViolatedExcep if the file cannot be opened or mapped)
+    */
+    explicit MappedFile( const std::string& aPath, Mode aMode = READ_ONLY );
+
+    /**
+    * Unmaps the file
+    */
+    ~MappedFile();
+
+    /**
+    * @return The first byte of the file
+    */
+    const char* begin() const;
+
+    /**
+    * @return The first byte of a COPY_ON_WRITE mapping, writes stay in this process
+    */
+    char* data();
+
+    /**
+    * @return One past the last byte of the file
+    */
+    const char* end() const;
+
+    /**
+    * @return The number of bytes in the file
+    */
+    long size() const;
+
+private:
+    MappedFile( const MappedFile& );
+    MappedFile& operator=( const MappedFile& );
+
+    char* mData;    //!< The contents of the file (nullptr for an empty file)
+    long mSize;     //!< The number of bytes in the file
+    Mode mMode;     //!< Whether the mapping may be written to
+};
+
+#endif // !MAPPED_FILE_H
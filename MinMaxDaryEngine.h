@@ -0,0 +1,120 @@
+/**
+*	@file : MinMaxDaryEngine.h
+*	@author :  Haaris Chaudhry
+*	@date : Mar 9, 2017
+*	Purpose: The sift routines of a min-max heap in which every node has Arity children instead of two.
+*          Levels still alternate between min and max levels and the same hole moving algorithms as
+*          MinMaxHeapEngine apply, but the tree is log2( Arity ) times shallower.  Each step scans
+*          a node's Arity children and Arity^2 grandchildren, which sit in two contiguous runs, so a
+*          step costs more comparisons but touches far fewer cache lines on heaps beyond the caches.
+*
+*          Heap indices start at 1 like MinMaxHeapEngine, the children of i are
+*          Arity * ( i - 1 ) + 2 through Arity * i + 1, and any MinMaxHeapEngine Store works.
+*          Arity has to be a power of two.
+*/
+
+#ifndef MIN_MAX_DARY_ENGINE_H
+#define MIN_MAX_DARY_ENGINE_H
+
+#include "MinMaxHeapEngine.h"
+#include <utility>
+
+template <int Arity>
+class MinMaxDaryEngine
+{
+public:
+    static_assert( Arity >= 2 && ( Arity & ( Arity - 1 ) ) == 0, "MinMaxDaryEngine needs a power of two arity" );
+
+    /**
+    * @return True if aIndex is on a min level
+    */
+    static bool isMinLevel( long aIndex );
+
+    /**
+    * @return The parent of aIndex, which has to be greater than 1
+    */
+    static long parent( long aIndex );
+
+    /**
+    * @return The first child of aIndex, the others follow it
+    */
+    static long firstChild( long aIndex );
+
+    /**
+    * Moves the value at aIndex up the heap to its proper spot
+    */
+    template <class Store>
+    static void bubbleUp( Store& aStore, long aIndex );
+
+    /**
+    * Moves the value at aIndex down through the heap to its proper spot
+    */
+    template <class Store>
+    static void trickleDown( Store& aStore, long aIndex, long aNumNodes );
+
+    /**
+    * Fills the hole at aHole with aHeld, moving it down through the heap to its proper spot
+    */
+    template <class Store>
+    static void trickleDownHole( Store& aStore, long aHole, typename Store::Held&& aHeld, long aNumNodes );
+
+    /**
+    * Fills the hole left by the maximum with a value that may be smaller than the root
+    */
+    template <class Store>
+    static void fillMaxHole( Store& aStore, long aHole, typename Store::Held&& aHeld, long aNumNodes );
+
+    /**
+    * Takes the minimum out and carries the last value into its hole, see MinMaxHeapEngine::popMin
+    */
+    template <class Store>
+    static typename Store::Held popMin( Store& aStore, long& aNumNodes );
+
+    /**
+    * Takes the maximum out and carries the last value into its hole
+    */
+    template <class Store>
+    static typename Store::Held popMax( Store& aStore, long& aNumNodes );
+
+    /**
+    * @return The index of the maximum, the root if it is alone, otherwise the largest child of the root
+    */
+    template <class Store>
+    static long maxIndex( const Store& aStore, long aNumNodes );
+
+    /**
+    * Bottom up construction, trickles down every parent starting from the last one
+    */
+    template <class Store>
+    static void build( Store& aStore, long aNumNodes );
+
+    /**
+    * Restores the heap after a batch was appended, see MinMaxHeapEngine::heapifyAppended
+    */
+    template <class Store>
+    static void heapifyAppended( Store& aStore, long aOldNumNodes, long aNumNodes );
+
+private:
+    /**
+    * @return The number of levels a step of Arity children spans in a binary tree
+    */
+    static int log2Arity();
+
+    template <bool IsMax, class Store, class Key>
+    static bool precedes( const Store& aStore, const Key& aLeft, const Key& aRight );
+
+    /**
+    * @return The child or grandchild of aIndex that belongs highest on aIndex's kind of level
+    */
+    template <bool IsMax, class Store>
+    static long extremeDescendant( const Store& aStore, long aIndex, long aNumNodes );
+
+    template <bool IsMax, class Store>
+    static void trickleDownLevel( Store& aStore, long aHole, typename Store::Held& aHeld, long aNumNodes );
+
+    template <bool IsMax, class Store>
+    static void bubbleUpLevel( Store& aStore, long aHole, typename Store::Held& aHeld );
+};
+
+#include "MinMaxDaryEngine.hpp"
+#endif // !MIN_MAX_DARY_ENGINE_H
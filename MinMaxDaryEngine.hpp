@@ -0,0 +1,328 @@
+/**
+*	@file : MinMaxDaryEngine.hpp
+*	@author :  Haaris Chaudhry
+*	@date : Mar 9, 2017
+*	Purpose: Implementation of the d-ary min-max heap sift engine.
+*/
+
+template <int Arity>
+int MinMaxDaryEngine<Arity>::log2Arity()
+{
+    int bits = 0;
+
+    while( ( 1 << bits ) < Arity )
+    {
+        bits++;
+    }
+
+    return bits;
+}
+
+// Level l starts at index ( Arity^l - 1 ) / ( Arity - 1 ) + 1, so ( Arity - 1 ) * ( i - 1 ) + 1 lies in
+// [Arity^l, Arity^(l+1)) and its bit length divided by log2( Arity ) is the level
+template <int Arity>
+bool MinMaxDaryEngine<Arity>::isMinLevel( long aIndex )
+{
+    unsigned long scaled = static_cast<unsigned long>( ( Arity - 1 ) * ( aIndex - 1 ) + 1 );
+    int highestBit = 0;
+
+#if defined( __GNUC__ )
+    highestBit = static_cast<int>( sizeof( unsigned long ) * 8 - 1 ) - __builtin_clzl( scaled );
+#else
+    while( scaled > 1 )
+    {
+        scaled >>= 1;
+        highestBit++;
+    }
+#endif
+
+    return ( ( highestBit / log2Arity() ) % 2 == 0 );
+}
+
+template <int Arity>
+long MinMaxDaryEngine<Arity>::parent( long aIndex )
+{
+    return ( aIndex - 2 ) / Arity + 1;
+}
+
+template <int Arity>
+long MinMaxDaryEngine<Arity>::firstChild( long aIndex )
+{
+    return Arity * ( aIndex - 1 ) + 2;
+}
+
+template <int Arity>
+template <bool IsMax, class Store, class Key>
+bool MinMaxDaryEngine<Arity>::precedes( const Store& aStore, const Key& aLeft, const Key& aRight )
+{
+    return IsMax ? aStore.less( aRight, aLeft ) : aStore.less( aLeft, aRight );
+}
+
+// The children form one run and the grandchildren, the children of the children, a second run of
+// Arity^2 values further along the array.  The best key is tracked through a pointer and both picks
+// are plain selects, so the scan compiles to conditional moves instead of unpredictable branches.
+template <int Arity>
+template <bool IsMax, class Store>
+long MinMaxDaryEngine<Arity>::extremeDescendant( const Store& aStore, long aIndex, long aNumNodes )
+{
+    long first = firstChild( aIndex );
+    long last = ( first + Arity - 1 < aNumNodes ) ? first + Arity - 1 : aNumNodes;
+    long best = first;
+    const typename Store::Key* bestKey = &aStore.key( first );
+
+    for( long i = first + 1; i <= last; i++ )
+    {
+        const typename Store::Key* key = &aStore.key( i );
+        bool better = precedes<IsMax>( aStore, *key, *bestKey );
+        best = better ? i : best;
+        bestKey = better ? key : bestKey;
+    }
+
+    long firstGrandchild = firstChild( first );
+    long lastGrandchild = firstGrandchild + Arity * Arity - 1;
+
+    if( lastGrandchild > aNumNodes )
+    {
+        lastGrandchild = aNumNodes;
+    }
+
+    // Two interleaved chains halve the latency of the longer run, the odd one is merged in at the end
+    long oddBest = best;
+    const typename Store::Key* oddKey = bestKey;
+    long i = firstGrandchild;
+
+    for( ; Arity >= 8 && i + 1 <= lastGrandchild; i += 2 )
+    {
+        const typename Store::Key* key = &aStore.key( i );
+        const typename Store::Key* oddNext = &aStore.key( i + 1 );
+        bool better = precedes<IsMax>( aStore, *key, *bestKey );
+        bool oddBetter = precedes<IsMax>( aStore, *oddNext, *oddKey );
+        best = better ? i : best;
+        bestKey = better ? key : bestKey;
+        oddBest = oddBetter ? i + 1 : oddBest;
+        oddKey = oddBetter ? oddNext : oddKey;
+    }
+
+    for( ; i <= lastGrandchild; i++ )
+    {
+        const typename Store::Key* key = &aStore.key( i );
+        bool better = precedes<IsMax>( aStore, *key, *bestKey );
+        best = better ? i : best;
+        bestKey = better ? key : bestKey;
+    }
+
+    if( precedes<IsMax>( aStore, *oddKey, *bestKey ) )
+    {
+        best = oddBest;
+    }
+
+    return best;
+}
+
+// Same as MinMaxHeapEngine::trickleDownLevel, with the d-ary parent and grandchild tests
+template <int Arity>
+template <bool IsMax, class Store>
+void MinMaxDaryEngine<Arity>::trickleDownLevel( Store& aStore, long aHole, typename Store::Held& aHeld, long aNumNodes )
+{
+    while( firstChild( aHole ) <= aNumNodes )
+    {
+        long m = extremeDescendant<IsMax>( aStore, aHole, aNumNodes );
+
+        if( !precedes<IsMax>( aStore, aStore.key( m ), aStore.keyOf( aHeld ) ) )
+        {
+            break;
+        }
+
+        aStore.move( m, aHole );
+        bool isChild = ( m < firstChild( firstChild( aHole ) ) );
+        aHole = m;
+
+        if( isChild )
+        {
+            break;
+        }
+
+        long parentIndexOfM = parent( m );
+
+        if( precedes<IsMax>( aStore, aStore.key( parentIndexOfM ), aStore.keyOf( aHeld ) ) )
+        {
+            aStore.exchange( parentIndexOfM, aHeld );
+        }
+    }
+
+    aStore.put( aHole, std::move( aHeld ) );
+}
+
+template <int Arity>
+template <bool IsMax, class Store>
+void MinMaxDaryEngine<Arity>::bubbleUpLevel( Store& aStore, long aHole, typename Store::Held& aHeld )
+{
+    while( aHole > Arity + 1 )
+    {
+        long grandparentIndex = parent( parent( aHole ) );
+
+        if( !precedes<IsMax>( aStore, aStore.keyOf( aHeld ), aStore.key( grandparentIndex ) ) )
+        {
+            break;
+        }
+
+        aStore.move( grandparentIndex, aHole );
+        aHole = grandparentIndex;
+    }
+
+    aStore.put( aHole, std::move( aHeld ) );
+}
+
+// Indices up to Arity + 1 are the root and its children, only deeper nodes have a grandparent
+template <int Arity>
+template <class Store>
+void MinMaxDaryEngine<Arity>::bubbleUp( Store& aStore, long aIndex )
+{
+    if( aIndex <= 1 )
+    {
+        return;
+    }
+
+    long parentIndex = parent( aIndex );
+
+    if( isMinLevel( aIndex ) )
+    {
+        if( aStore.less( aStore.key( parentIndex ), aStore.key( aIndex ) ) )
+        {
+            typename Store::Held held = aStore.take( aIndex );
+            aStore.move( parentIndex, aIndex );
+            bubbleUpLevel<true>( aStore, parentIndex, held );
+        }
+        else if( aIndex > Arity + 1 && aStore.less( aStore.key( aIndex ), aStore.key( parent( parentIndex ) ) ) )
+        {
+            typename Store::Held held = aStore.take( aIndex );
+            bubbleUpLevel<false>( aStore, aIndex, held );
+        }
+    }
+    else
+    {
+        if( aStore.less( aStore.key( aIndex ), aStore.key( parentIndex ) ) )
+        {
+            typename Store::Held held = aStore.take( aIndex );
+            aStore.move( parentIndex, aIndex );
+            bubbleUpLevel<false>( aStore, parentIndex, held );
+        }
+        else if( aIndex > Arity + 1 && aStore.less( aStore.key( parent( parentIndex ) ), aStore.key( aIndex ) ) )
+        {
+            typename Store::Held held = aStore.take( aIndex );
+            bubbleUpLevel<true>( aStore, aIndex, held );
+        }
+    }
+}
+
+template <int Arity>
+template <class Store>
+void MinMaxDaryEngine<Arity>::trickleDown( Store& aStore, long aIndex, long aNumNodes )
+{
+    if( firstChild( aIndex ) <= aNumNodes )
+    {
+        trickleDownHole( aStore, aIndex, aStore.take( aIndex ), aNumNodes );
+    }
+}
+
+template <int Arity>
+template <class Store>
+void MinMaxDaryEngine<Arity>::trickleDownHole( Store& aStore, long aHole, typename Store::Held&& aHeld, long aNumNodes )
+{
+    if( isMinLevel( aHole ) )
+    {
+        trickleDownLevel<false>( aStore, aHole, aHeld, aNumNodes );
+    }
+    else
+    {
+        trickleDownLevel<true>( aStore, aHole, aHeld, aNumNodes );
+    }
+}
+
+template <int Arity>
+template <class Store>
+void MinMaxDaryEngine<Arity>::fillMaxHole( Store& aStore, long aHole, typename Store::Held&& aHeld, long aNumNodes )
+{
+    if( aHole > 1 && aStore.less( aStore.keyOf( aHeld ), aStore.key( 1 ) ) )
+    {
+        aStore.exchange( 1, aHeld );
+    }
+
+    trickleDownHole( aStore, aHole, std::move( aHeld ), aNumNodes );
+}
+
+template <int Arity>
+template <class Store>
+typename Store::Held MinMaxDaryEngine<Arity>::popMin( Store& aStore, long& aNumNodes )
+{
+    typename Store::Held minValue = aStore.take( 1 );
+
+    if( aNumNodes > 1 )
+    {
+        trickleDownHole( aStore, 1, aStore.take( aNumNodes ), aNumNodes - 1 );
+    }
+
+    aNumNodes--;
+    return minValue;
+}
+
+template <int Arity>
+template <class Store>
+typename Store::Held MinMaxDaryEngine<Arity>::popMax( Store& aStore, long& aNumNodes )
+{
+    long hole = maxIndex( aStore, aNumNodes );
+    typename Store::Held maxValue = aStore.take( hole );
+
+    if( hole != aNumNodes )
+    {
+        trickleDownHole( aStore, hole, aStore.take( aNumNodes ), aNumNodes - 1 );
+    }
+
+    aNumNodes--;
+    return maxValue;
+}
+
+template <int Arity>
+template <class Store>
+long MinMaxDaryEngine<Arity>::maxIndex( const Store& aStore, long aNumNodes )
+{
+    long last = ( aNumNodes < Arity + 1 ) ? aNumNodes : Arity + 1;
+    long best = 1;
+
+    for( long i = 2; i <= last; i++ )
+    {
+        if( best == 1 || aStore.less( aStore.key( best ), aStore.key( i ) ) )
+        {
+            best = i;
+        }
+    }
+
+    return best;
+}
+
+template <int Arity>
+template <class Store>
+void MinMaxDaryEngine<Arity>::build( Store& aStore, long aNumNodes )
+{
+    for( long i = ( aNumNodes < 2 ) ? 0 : parent( aNumNodes ); i >= 1; i-- )
+    {
+        trickleDown( aStore, i, aNumNodes );
+    }
+}
+
+template <int Arity>
+template <class Store>
+void MinMaxDaryEngine<Arity>::heapifyAppended( Store& aStore, long aOldNumNodes, long aNumNodes )
+{
+    if( MinMaxHeapEngine::prefersRebuild( aOldNumNodes, aNumNodes ) )
+    {
+        build( aStore, aNumNodes );
+    }
+    else
+    {
+        for( long i = aOldNumNodes + 1; i <= aNumNodes; i++ )
+        {
+            bubbleUp( aStore, i );
+        }
+    }
+}
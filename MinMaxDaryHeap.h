@@ -0,0 +1,173 @@
+/**
+*	@file : MinMaxDaryHeap.h
+*	@author :  Haaris Chaudhry
+*	@date : Mar 9, 2017
+*	Purpose: A min-max heap with Arity children per node (see MinMaxDaryEngine), for heaps much larger
+*          than the caches.  The array is placed so that every group of siblings starts on a multiple
+*          of Arity values from a 64 byte boundary: when Arity values fill a cache line (Arity 8 for
+*          longs and doubles) every node's children are exactly one line, and a node's grandchildren
+*          are Arity whole lines.
+*/
+
+#ifndef MIN_MAX_DARY_HEAP_H
+#define MIN_MAX_DARY_HEAP_H
+
+#include "MinMaxDaryEngine.h"
+#include "MinMaxHeapEngine.h"
+#include "MinMaxHeapOps.h"
+#include <functional>
+#include <iterator>
+#include <memory>
+
+template <class T, int Arity = 4, class Compare = std::less<T>, class Allocator = std::allocator<T> >
+class MinMaxDaryHeap
+{
+public:
+    typedef T value_type;
+    typedef Compare value_compare;
+    typedef Allocator allocator_type;
+
+    static const int kArity = Arity;
+
+    /**
+    * Constructor for the MinMaxDaryHeap
+    * @param aSize The initial capacity of the heap
+    * @param aCompare The strict weak ordering used to compare values
+    * @param aAllocator The allocator used for the heap array
+    * @return An empty heap able to hold aSize values before growing
+    */
+    explicit MinMaxDaryHeap( long aSize = 0, const Compare& aCompare = Compare(), const Allocator& aAllocator = Allocator() );
+
+    /**
+    * Constructor for the MinMaxDaryHeap, copies an array and heapifies it bottom up
+    * @param aSize The initial capacity of the heap
+    * @param values an array of values to be inserted into the heap
+    * @param valuesSize the size of the array
+    * @return A heap containing the values in values
+    */
+    MinMaxDaryHeap( long aSize, const T values[], long valuesSize );
+
+    /**
+    * The destructor
+    */
+    ~MinMaxDaryHeap();
+
+    /**
+    * The insertion function, also heapifies the value. The array grows if it is full.
+    * @param aValue The value to be inserted
+    */
+    void insert( const T& aValue );
+
+    void insert( T&& aValue );
+
+    /**
+    * Inserts every value of a range, see MinMaxHeap::insertRange
+    * @param aFirst The first value to insert
+    * @param aLast One past the last value to insert
+    */
+    template <class InputIterator>
+    void insertRange( InputIterator aFirst, InputIterator aLast );
+
+    /**
+    * Deletes the minimum value
+    * @return The value that was deleted (throws PrecondViolatedExcep if the heap is empty)
+    */
+    T deleteMin();
+
+    /**
+    * Deletes the maximum value
+    * @return The value that was deleted (throws PrecondViolatedExcep if the heap is empty)
+    */
+    T deleteMax();
+
+    /**
+    * Reads the minimum value without removing it, O(1)
+    * @return The minimum value (throws PrecondViolatedExcep if the heap is empty)
+    */
+    const T& peekMin() const;
+
+    /**
+    * Reads the maximum value without removing it, O(Arity)
+    * @return The maximum value (throws PrecondViolatedExcep if the heap is empty)
+    */
+    const T& peekMax() const;
+
+    /**
+    * Deletes the minimum value and inserts aValue with a single trickle down
+    * @param aValue The value to be inserted
+    * @return The value that was deleted (throws PrecondViolatedExcep if the heap is empty)
+    */
+    T replaceMin( T aValue );
+
+    /**
+    * Deletes the maximum value and inserts aValue with a single trickle down
+    * @param aValue The value to be inserted
+    * @return The value that was deleted (throws PrecondViolatedExcep if the heap is empty)
+    */
+    T replaceMax( T aValue );
+
+    /**
+    * Function that indicates if the heap is empty
+    * @return True if empty, false if not
+    */
+    bool isEmpty() const;
+
+    /**
+    * @return The number of values in the heap
+    */
+    long size() const;
+
+    /**
+    * @return The number of values the heap array can hold before it has to grow
+    */
+    long capacity() const;
+
+    /**
+    * Makes sure the heap array can hold at least aCapacity values without growing
+    * @param aCapacity The requested capacity
+    */
+    void reserve( long aCapacity );
+
+    /**
+    * Removes every value, the capacity is kept
+    */
+    void clear();
+
+private:
+    typedef std::allocator_traits<Allocator> AllocTraits;
+    typedef MinMaxArrayStore<T, Compare> Store;
+
+    MinMaxDaryHeap( const MinMaxDaryHeap& );
+    MinMaxDaryHeap& operator=( const MinMaxDaryHeap& );
+
+    /**
+    * Slots allocated beyond the capacity, so the root can be shifted to put the child groups in place
+    */
+    static const long kSlack = ( sizeof( T ) < 64 ) ? 64 / sizeof( T ) : 1;
+
+    /**
+    * Appends a value without heapifying
+    */
+    template <class U>
+    void bottomUpInsert( U&& aValue );
+
+    /**
+    * Moves every value into a new, realigned array of aCapacity slots
+    */
+    void reallocate( long aCapacity );
+
+    /**
+    * @return The engine's view of the heap array
+    */
+    Store store() const;
+
+    Compare mCompare;       //!< The ordering of the heap values
+    Allocator mAllocator;   //!< The allocator that owns the heap array
+    long mNumNodes;         //!< The number of nodes in the heap
+    long mCapacity;         //!< The number of values the array can hold
+    T* mAllocation;         //!< The array as allocated, mCapacity + kSlack slots
+    T* mHeapArray;          //!< The root's slot inside mAllocation, heap index i lives in slot i - 1
+};
+
+#include "MinMaxDaryHeap.hpp"
+#endif // !MIN_MAX_DARY_HEAP_H
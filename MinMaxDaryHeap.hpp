@@ -0,0 +1,262 @@
+/**
+*	@file : MinMaxDaryHeap.hpp
+*	@author :  Haaris Chaudhry
+*	@date : Mar 9, 2017
+*	Purpose: Implementation of the MinMaxDaryHeap class template.
+*/
+
+#include "PrecondViolatedExcep.h"
+#include <cstdint>
+#include <utility>
+
+template <class T, int Arity, class Compare, class Allocator>
+MinMaxDaryHeap<T, Arity, Compare, Allocator>::MinMaxDaryHeap( long aSize, const Compare& aCompare, const Allocator& aAllocator ) :
+    mCompare( aCompare ),
+    mAllocator( aAllocator ),
+    mNumNodes( 0 ),
+    mCapacity( 0 ),
+    mAllocation( nullptr ),
+    mHeapArray( nullptr )
+{
+    reserve( aSize );
+}
+
+template <class T, int Arity, class Compare, class Allocator>
+MinMaxDaryHeap<T, Arity, Compare, Allocator>::MinMaxDaryHeap( long aSize, const T values[], long valuesSize ) :
+    MinMaxDaryHeap( aSize )
+{
+    reserve( valuesSize );
+
+    for( long i = 0; i < valuesSize; i++ )
+    {
+        bottomUpInsert( values[i] );
+    }
+
+    Store heapStore = store();
+    MinMaxDaryEngine<Arity>::build( heapStore, mNumNodes );
+}
+
+template <class T, int Arity, class Compare, class Allocator>
+MinMaxDaryHeap<T, Arity, Compare, Allocator>::~MinMaxDaryHeap()
+{
+    clear();
+
+    if( mAllocation != nullptr )
+    {
+        AllocTraits::deallocate( mAllocator, mAllocation, mCapacity + kSlack );
+    }
+}
+
+// The children of heap index i start at slot Arity * ( i - 1 ) + 1, so once slot 1 sits on a 64 byte
+// boundary every group of siblings starts a multiple of Arity values after one
+template <class T, int Arity, class Compare, class Allocator>
+void MinMaxDaryHeap<T, Arity, Compare, Allocator>::reallocate( long aCapacity )
+{
+    T* newAllocation = AllocTraits::allocate( mAllocator, aCapacity + kSlack );
+    T* newArray = newAllocation;
+
+    for( long offset = 0; offset < kSlack; offset++ )
+    {
+        if( reinterpret_cast<std::uintptr_t>( newAllocation + offset + 1 ) % 64 == 0 )
+        {
+            newArray = newAllocation + offset;
+            break;
+        }
+    }
+
+    for( long i = 0; i < mNumNodes; i++ )
+    {
+        AllocTraits::construct( mAllocator, newArray + i, std::move_if_noexcept( mHeapArray[i] ) );
+        AllocTraits::destroy( mAllocator, mHeapArray + i );
+    }
+
+    if( mAllocation != nullptr )
+    {
+        AllocTraits::deallocate( mAllocator, mAllocation, mCapacity + kSlack );
+    }
+
+    mAllocation = newAllocation;
+    mHeapArray = newArray;
+    mCapacity = aCapacity;
+}
+
+template <class T, int Arity, class Compare, class Allocator>
+void MinMaxDaryHeap<T, Arity, Compare, Allocator>::reserve( long aCapacity )
+{
+    if( aCapacity > mCapacity )
+    {
+        reallocate( aCapacity );
+    }
+}
+
+template <class T, int Arity, class Compare, class Allocator>
+void MinMaxDaryHeap<T, Arity, Compare, Allocator>::clear()
+{
+    for( long i = 0; i < mNumNodes; i++ )
+    {
+        AllocTraits::destroy( mAllocator, mHeapArray + i );
+    }
+
+    mNumNodes = 0;
+}
+
+// aValue may be one of the heap's own values, so before the array moves it is taken out into a local
+template <class T, int Arity, class Compare, class Allocator>
+template <class U>
+void MinMaxDaryHeap<T, Arity, Compare, Allocator>::bottomUpInsert( U&& aValue )
+{
+    if( mNumNodes == mCapacity )
+    {
+        T value( std::forward<U>( aValue ) );
+        reallocate( mCapacity < 4 ? 8 : mCapacity * 2 );
+        AllocTraits::construct( mAllocator, mHeapArray + mNumNodes, std::move( value ) );
+    }
+    else
+    {
+        AllocTraits::construct( mAllocator, mHeapArray + mNumNodes, std::forward<U>( aValue ) );
+    }
+
+    mNumNodes++;
+}
+
+template <class T, int Arity, class Compare, class Allocator>
+void MinMaxDaryHeap<T, Arity, Compare, Allocator>::insert( const T& aValue )
+{
+    bottomUpInsert( aValue );
+    Store heapStore = store();
+    MinMaxDaryEngine<Arity>::bubbleUp( heapStore, mNumNodes );
+}
+
+template <class T, int Arity, class Compare, class Allocator>
+void MinMaxDaryHeap<T, Arity, Compare, Allocator>::insert( T&& aValue )
+{
+    bottomUpInsert( std::move( aValue ) );
+    Store heapStore = store();
+    MinMaxDaryEngine<Arity>::bubbleUp( heapStore, mNumNodes );
+}
+
+template <class T, int Arity, class Compare, class Allocator>
+template <class InputIterator>
+void MinMaxDaryHeap<T, Arity, Compare, Allocator>::insertRange( InputIterator aFirst, InputIterator aLast )
+{
+    long oldNumNodes = mNumNodes;
+
+    try
+    {
+        for( ; aFirst != aLast; ++aFirst )
+        {
+            bottomUpInsert( *aFirst );
+        }
+    }
+    catch( ... )
+    {
+        Store heapStore = store();
+        MinMaxDaryEngine<Arity>::heapifyAppended( heapStore, oldNumNodes, mNumNodes );
+        throw;
+    }
+
+    Store heapStore = store();
+    MinMaxDaryEngine<Arity>::heapifyAppended( heapStore, oldNumNodes, mNumNodes );
+}
+
+template <class T, int Arity, class Compare, class Allocator>
+T MinMaxDaryHeap<T, Arity, Compare, Allocator>::deleteMin()
+{
+    if( isEmpty() )
+    {
+        throw PrecondViolatedExcep( "deleteMin attempted on an empty heap" );
+    }
+
+    Store heapStore = store();
+    long numNodes = mNumNodes;
+    T minValue = MinMaxDaryEngine<Arity>::popMin( heapStore, numNodes );
+    AllocTraits::destroy( mAllocator, mHeapArray + numNodes );
+    mNumNodes = numNodes;
+    return minValue;
+}
+
+template <class T, int Arity, class Compare, class Allocator>
+T MinMaxDaryHeap<T, Arity, Compare, Allocator>::deleteMax()
+{
+    if( isEmpty() )
+    {
+        throw PrecondViolatedExcep( "deleteMax attempted on an empty heap" );
+    }
+
+    Store heapStore = store();
+    long numNodes = mNumNodes;
+    T maxValue = MinMaxDaryEngine<Arity>::popMax( heapStore, numNodes );
+    AllocTraits::destroy( mAllocator, mHeapArray + numNodes );
+    mNumNodes = numNodes;
+    return maxValue;
+}
+
+template <class T, int Arity, class Compare, class Allocator>
+const T& MinMaxDaryHeap<T, Arity, Compare, Allocator>::peekMin() const
+{
+    if( isEmpty() )
+    {
+        throw PrecondViolatedExcep( "peekMin attempted on an empty heap" );
+    }
+
+    return mHeapArray[0];
+}
+
+template <class T, int Arity, class Compare, class Allocator>
+const T& MinMaxDaryHeap<T, Arity, Compare, Allocator>::peekMax() const
+{
+    if( isEmpty() )
+    {
+        throw PrecondViolatedExcep( "peekMax attempted on an empty heap" );
+    }
+
+    return mHeapArray[MinMaxDaryEngine<Arity>::maxIndex( store(), mNumNodes ) - 1];
+}
+
+template <class T, int Arity, class Compare, class Allocator>
+T MinMaxDaryHeap<T, Arity, Compare, Allocator>::replaceMin( T aValue )
+{
+    if( isEmpty() )
+    {
+        throw PrecondViolatedExcep( "replaceMin attempted on an empty heap" );
+    }
+
+    Store heapStore = store();
+    return MinMaxHeapOps<MinMaxDaryEngine<Arity> >::replaceMin( heapStore, mNumNodes, std::move( aValue ) );
+}
+
+template <class T, int Arity, class Compare, class Allocator>
+T MinMaxDaryHeap<T, Arity, Compare, Allocator>::replaceMax( T aValue )
+{
+    if( isEmpty() )
+    {
+        throw PrecondViolatedExcep( "replaceMax attempted on an empty heap" );
+    }
+
+    Store heapStore = store();
+    return MinMaxHeapOps<MinMaxDaryEngine<Arity> >::replaceMax( heapStore, mNumNodes, std::move( aValue ) );
+}
+
+template <class T, int Arity, class Compare, class Allocator>
+bool MinMaxDaryHeap<T, Arity, Compare, Allocator>::isEmpty() const
+{
+    return ( mNumNodes == 0 );
+}
+
+template <class T, int Arity, class Compare, class Allocator>
+long MinMaxDaryHeap<T, Arity, Compare, Allocator>::size() const
+{
+    return mNumNodes;
+}
+
+template <class T, int Arity, class Compare, class Allocator>
+long MinMaxDaryHeap<T, Arity, Compare, Allocator>::capacity() const
+{
+    return mCapacity;
+}
+
+template <class T, int Arity, class Compare, class Allocator>
+typename MinMaxDaryHeap<T, Arity, Compare, Allocator>::Store MinMaxDaryHeap<T, Arity, Compare, Allocator>::store() const
+{
+    return Store( mHeapArray, mCompare );
+}
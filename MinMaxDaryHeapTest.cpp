@@ -0,0 +1,174 @@
+/**
+*	@file : MinMaxDaryHeapTest.cpp
+*	@author :  Haaris Chaudhry
+*	@date : Mar 9, 2017
+*	Purpose: Checks MinMaxDaryHeap against a std::multiset for Arity 2, 4 and 8: random inserts, range
+*          inserts, deletes and replaces at both ends, growth from an empty array, reserve and clear.
+*          After every op the root has to sit one value before a 64 byte boundary, however often the
+*          array has been reallocated, so every group of siblings starts on a cache line.
+*/
+
+#include "MinMaxDaryHeap.h"
+#include "MinMaxTest.h"
+#include <cstdint>
+#include <iterator>
+#include <random>
+#include <set>
+#include <string>
+#include <vector>
+
+namespace
+{
+    // The root is heap index 1, its children start at index 2
+    template <class Heap>
+    bool childrenAligned( const Heap& aHeap )
+    {
+        return aHeap.isEmpty() || reinterpret_cast<std::uintptr_t>( &aHeap.peekMin() + 1 ) % 64 == 0;
+    }
+
+    template <int Arity>
+    void runAgainstReference( long aRange, unsigned long aSeed )
+    {
+        typedef MinMaxDaryHeap<long, Arity> Heap;
+        Heap heap;
+        std::multiset<long> reference;
+
+        MinMaxTest::runSteps( "arity " + std::to_string( Arity ) + ", range " + std::to_string( aRange ), aSeed, 6000, [&]( std::mt19937& aRandom, const MinMaxTest::Run& aRun )
+        {
+            long choice = static_cast<long>( aRandom() % 12 );
+            long value = static_cast<long>( aRandom() % aRange );
+
+            if( choice < 4 || reference.empty() )
+            {
+                heap.insert( value );
+                reference.insert( value );
+            }
+            else if( choice == 4 )
+            {
+                // Small batches are bubbled up, batches as large as the heap rebuild it
+                long count = ( aRandom() % 2 == 0 ) ? static_cast<long>( aRandom() % 4 ) : static_cast<long>( aRandom() % 300 );
+                std::vector<long> values( count );
+
+                for( long i = 0; i < count; i++ )
+                {
+                    values[i] = static_cast<long>( aRandom() % aRange );
+                }
+
+                heap.insertRange( values.begin(), values.end() );
+                reference.insert( values.begin(), values.end() );
+            }
+            else if( choice < 8 )
+            {
+                if( !MINMAX_CHECK_DELETE( aRun, heap, reference, choice % 2 == 0 ) )
+                {
+                    return;
+                }
+            }
+            else if( choice < 10 )
+            {
+                bool isMax = ( choice == 9 );
+                std::multiset<long>::iterator end = isMax ? std::prev( reference.end() ) : reference.begin();
+                long expected = *end;
+                reference.erase( end );
+                reference.insert( value );
+
+                if( !MINMAX_CHECK_EQUAL( aRun, isMax ? heap.replaceMax( value ) : heap.replaceMin( value ), expected ) )
+                {
+                    return;
+                }
+            }
+            else if( choice == 10 )
+            {
+                long capacity = heap.capacity() + static_cast<long>( aRandom() % 100 );
+                heap.reserve( capacity );
+
+                if( !MINMAX_CHECK_STEP( aRun, heap.capacity() >= capacity ) )
+                {
+                    return;
+                }
+            }
+            else if( aRandom() % 20 == 0 )
+            {
+                long capacity = heap.capacity();
+                heap.clear();
+                reference.clear();
+
+                if( !MINMAX_CHECK_EQUAL( aRun, heap.capacity(), capacity ) )
+                {
+                    return;
+                }
+            }
+
+            MINMAX_CHECK_ENDS( aRun, heap, reference ) && MINMAX_CHECK_STEP( aRun, childrenAligned( heap ) );
+        } );
+    }
+
+    // Grows one value at a time from an empty array, then drains from both ends
+    template <int Arity>
+    void checkGrowth( std::mt19937& aRandom )
+    {
+        MinMaxDaryHeap<long, Arity> heap;
+        std::multiset<long> reference;
+        MinMaxTest::Run run( "growth, arity " + std::to_string( Arity ), 0 );
+        bool passed = true;
+
+        for( long i = 0; i < 100000 && passed; i++ )
+        {
+            long value = static_cast<long>( aRandom() % 1000000 );
+            long capacity = heap.capacity();
+            heap.insert( value );
+            reference.insert( value );
+            passed = MINMAX_CHECK_STEP( run, heap.capacity() >= heap.size() )
+                && ( capacity == heap.capacity() || MINMAX_CHECK_STEP( run, childrenAligned( heap ) ) );
+        }
+
+        for( bool isMax = false; passed && !reference.empty(); isMax = !isMax )
+        {
+            passed = MINMAX_CHECK_DELETE( run, heap, reference, isMax ) && MINMAX_CHECK_ENDS( run, heap, reference );
+        }
+    }
+
+    template <int Arity>
+    void checkArrayConstructor( std::mt19937& aRandom )
+    {
+        std::vector<long> values( 5000 );
+
+        for( size_t i = 0; i < values.size(); i++ )
+        {
+            values[i] = static_cast<long>( aRandom() % 100 );
+        }
+
+        MinMaxDaryHeap<long, Arity> heap( 0, values.data(), static_cast<long>( values.size() ) );
+        std::multiset<long> reference( values.begin(), values.end() );
+        MinMaxTest::Run run( "array, arity " + std::to_string( Arity ), 0 );
+        MINMAX_CHECK( MINMAX_CHECK_ENDS( run, heap, reference ) && childrenAligned( heap ) );
+
+        MinMaxDaryHeap<long, Arity> empty;
+        MINMAX_CHECK_THROWS( empty.deleteMin() );
+        MINMAX_CHECK_THROWS( empty.deleteMax() );
+        MINMAX_CHECK_THROWS( empty.peekMax() );
+        MINMAX_CHECK_THROWS( empty.replaceMin( 1 ) );
+    }
+}
+
+int main()
+{
+    std::mt19937 random( 2017 );
+    const long ranges[] = { 1L << 30, 40, 2 };
+
+    for( size_t r = 0; r < sizeof( ranges ) / sizeof( ranges[0] ); r++ )
+    {
+        runAgainstReference<2>( ranges[r], random() );
+        runAgainstReference<4>( ranges[r], random() );
+        runAgainstReference<8>( ranges[r], random() );
+    }
+
+    checkGrowth<2>( random );
+    checkGrowth<4>( random );
+    checkGrowth<8>( random );
+    checkArrayConstructor<2>( random );
+    checkArrayConstructor<4>( random );
+    checkArrayConstructor<8>( random );
+
+    return MinMaxTest::report( "MinMaxDaryHeapTest" );
+}
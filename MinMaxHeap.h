@@ -2,41 +2,94 @@
 *	@file : MinMaxHeap.h
 *	@author :  Haaris Chaudhry
 *	@date : Mar 9, 2017
-*	Purpose: The MinMaxHeap class will simulate the classical functions k-heap with k equal to 2
+*	Purpose: The MinMaxHeap class will simulate the classical functions k-heap with k equal to 2.
+*          The heap is generic over its key type, ordering and allocator, and its storage grows
+*          geometrically so instances can be sized to their real load.
+*
+*          The Engine decides how the values are arranged in the array.  MinMaxHeapEngine keeps a
+*          classic min-max heap; MinMaxIntervalEngine keeps an interval heap, a pair of values per
+*          node, which is half as deep and compares fewer values per level.  Both give the same API,
+*          so switching is a matter of changing the last template argument.
 */
 
 #ifndef MIN_MAX_HEAP_H
 #define MIN_MAX_HEAP_H
 
+#include "MinMaxHeapEngine.h"
+#include "MinMaxHeapOps.h"
+#include "MinMaxHeapStats.h"
+#include "MinMaxIntervalEngine.h"
+#include "MinMaxSnapshot.h"
 #include "Queue.h"
+#include <functional>
+#include <iterator>
+#include <memory>
+#include <string>
+#include <utility>
 
+template <class T, class Compare = std::less<T>, class Allocator = std::allocator<T>, class Engine = MinMaxHeapEngine>
 class MinMaxHeap
 {
 public:
+    typedef T value_type;
+    typedef Compare value_compare;
+    typedef Allocator allocator_type;
+    typedef Engine engine_type;
+
     /**
     * Constructor for the MinMaxHeap
-    * @param aSize The size of the array that will contain the heap values
-    * @return A Min 2-heap with a size of aSize
+    * @param aSize The initial capacity of the array that will contain the heap values
+    * @param aCompare The strict weak ordering used to compare values
+    * @param aAllocator The allocator used for the heap array
+    * @return An empty min-max heap able to hold aSize values before growing
     */
-    MinMaxHeap( long aSize );
+    explicit MinMaxHeap( long aSize = 0, const Compare& aCompare = Compare(), const Allocator& aAllocator = Allocator() );
 
     /**
     * Constructor for the MinMaxHeap
-    * @param aSize The size of the array that will contain the heap values
+    * @param aSize The initial capacity of the array that will contain the heap values
     * @param aQueue This queue is used when values need to be read from a file
-    * @return A Min 2-heap with a size of aSize containing the values in aQueue
+    * @param aThreads The number of threads the bottom up build may use, 0 for one per hardware thread
+    *        (see MinMaxHeapEngine::buildParallel, the heap is the same for any number of threads)
+    * @return A min-max heap containing the values in aQueue (aQueue is left empty)
     */
-    MinMaxHeap( long aSize, Queue<long>& aQueue );
+    MinMaxHeap( long aSize, Queue<T>& aQueue, long aThreads = 1 );
 
     /**
     * Constructor for the MinMaxHeap
-    * @param aSize The size of the array that will contain the heap values
-    * @param aQueue This queue is used when values need to be read from a file
+    * @param aSize The initial capacity of the array that will contain the heap values
     * @param values an array of values to be inserted into the heap
     * @param valuesSize the size of the array
-    * @return A Min 2-heap with a size of aSize containing the values in values
+    * @param aThreads The number of threads the bottom up build may use, 0 for one per hardware thread
+    * @return A min-max heap containing the values in values
+    */
+    MinMaxHeap( long aSize, const T values[], long valuesSize, long aThreads = 1 );
+
+    /**
+    * Copy constructor, copies every value into a new array of the same capacity
+    * @param aOther The heap to copy
+    */
+    MinMaxHeap( const MinMaxHeap& aOther );
+
+    /**
+    * Move constructor, takes over the heap array of aOther
+    * @param aOther The heap to move from, left empty with no storage
     */
-    MinMaxHeap( long aSize, long values[], long valuesSize );
+    MinMaxHeap( MinMaxHeap&& aOther ) noexcept;
+
+    /**
+    * Copy assignment
+    * @param aOther The heap to copy
+    * @return This heap
+    */
+    MinMaxHeap& operator=( const MinMaxHeap& aOther );
+
+    /**
+    * Move assignment, takes over the heap array of aOther when the allocators allow it
+    * @param aOther The heap to move from, left empty
+    * @return This heap
+    */
+    MinMaxHeap& operator=( MinMaxHeap&& aOther );
 
     /**
     * The destructor
@@ -44,10 +97,58 @@ public:
     ~MinMaxHeap();
 
     /**
-    * The insertion function, also heapifies the value
+    * The insertion function, also heapifies the value. The array grows if it is full.
     * @param aValue The value to be inserted
     */
-    void insert( const long aValue );
+    void insert( const T& aValue );
+
+    /**
+    * The insertion function for values that can be moved into the heap
+    * @param aValue The value to be inserted
+    */
+    void insert( T&& aValue );
+
+    /**
+    * Inserts every value of a range. The values are appended first; a batch at least as large as the
+    * heap is then absorbed with one O(n) bottom up pass instead of one bubble up per value.
+    * @param aFirst The first value to insert
+    * @param aLast One past the last value to insert
+    */
+    template <class InputIterator>
+    void insertRange( InputIterator aFirst, InputIterator aLast );
+
+    /**
+    * Moves every value of aOther into this heap. The larger of the two arrays is kept and the
+    * smaller one is appended to it, then absorbed like an insertRange batch: bubbled up value by
+    * value, or with one O(n) bottom up pass when the two are about the same size.
+    * When aOther is the larger heap and its allocator propagates on swap (or compares equal), this
+    * heap takes over aOther's array together with its allocator: afterwards get_allocator() returns
+    * aOther's old allocator, so with MinMaxStorageAllocator this heap lives on aOther's backend, and
+    * aOther is left empty on this heap's old array and allocator.
+    * @param aOther The heap to take the values from, left empty
+    */
+    void meld( MinMaxHeap& aOther );
+
+    void meld( MinMaxHeap&& aOther );
+
+    /**
+    * Splits the heap in two in O(n): the values ordered before aPivot stay, the others move to a new
+    * heap. The array is partitioned in place and both halves are rebuilt bottom up.
+    * @param aPivot The smallest value that moves
+    * @return A heap with every value that is not ordered before aPivot, on a copy of this heap's
+    *         allocator
+    */
+    MinMaxHeap splitAt( const T& aPivot );
+
+    /**
+    * Removes every value aPredicate picks, in O(n): the array is compacted in place and rebuilt
+    * bottom up once, however many values go
+    * @param aPredicate Called exactly once for every value, returns true for the values to remove.
+    *        It must not throw, the array is mid compaction while it runs
+    * @return The number of values removed
+    */
+    template <class Predicate>
+    long eraseIf( Predicate aPredicate );
 
     /**
     * Displays the heap in a fancy level order using hyphens
@@ -56,106 +157,115 @@ public:
 
     /**
     * Deletes the minimum value
-    * @return The value that was deleted
+    * @return The value that was deleted (throws PrecondViolatedExcep if the heap is empty)
     */
-    long deleteMin();
+    T deleteMin();
 
     /**
     * Deletes the maximum value
-    * @return The value that was deleted
+    * @return The value that was deleted (throws PrecondViolatedExcep if the heap is empty)
     */
-    long deleteMax();
+    T deleteMax();
 
-private:
     /**
-    * A function used to insert values without heapifying, used during bottom up construction
-    * @param aValue The value to be inserted into the heap
+    * Deletes up to aCount of the smallest values, writing them to aOut in ascending order
+    * @param aOut Where the deleted values are written
+    * @param aCount The number of values to delete, fewer are deleted if the heap runs out
+    * @return aOut advanced past the last value written
     */
-    void bottomUpInsert( const long aValue );
+    template <class OutputIterator>
+    OutputIterator popMinK( OutputIterator aOut, long aCount );
 
     /**
-    * Finds the smallest child or grandchild of the given index
-    * @param aValueToMove The value that we'll compare against
-    * @param aIndex The index of the node that we'll compare against aValueToMove
-    * @return The smallest child or grandchild of the given index, returns -1 if there are no smaller children
+    * Deletes up to aCount of the largest values, writing them to aOut in descending order
+    * @param aOut Where the deleted values are written
+    * @param aCount The number of values to delete, fewer are deleted if the heap runs out
+    * @return aOut advanced past the last value written
     */
-    long indexSmallestCorGC( long aValueToMove, long aIndex ) const;
+    template <class OutputIterator>
+    OutputIterator popMaxK( OutputIterator aOut, long aCount );
 
     /**
-    * Finds the largest child or grandchild of the given index
-    * @param aValueToMove The value that we'll compare against
-    * @param aIndex The index of the node that we'll compare against aValueToMove
-    * @return The largest child or grandchild of the given index, returns -1 if there are no smaller children
+    * Empties the heap from both ends at once, alternating between the minimum and the maximum.
+    * aLowOut receives the lower half in ascending order, aHighOut the upper half in descending order
+    * (the lower half gets the middle value when the size is odd).
+    * @param aLowOut Where the smallest values are written
+    * @param aHighOut Where the largest values are written
+    * @return Both output iterators advanced past the last value written to them
     */
-    long indexLargestCorGC( long aValueToMove, long aIndex ) const;
+    template <class LowOutputIterator, class HighOutputIterator>
+    std::pair<LowOutputIterator, HighOutputIterator> drainBoth( LowOutputIterator aLowOut, HighOutputIterator aHighOut );
 
     /**
-    * Checks if the current node is a parent
-    * @param aIndex The index of the current node
-    * @return True if the node is a parent, false if otherwise
+    * Reads the minimum value without removing it, O(1)
+    * @return The minimum value (throws PrecondViolatedExcep if the heap is empty)
     */
-    bool isParent( long aIndex ) const;
+    const T& peekMin() const;
 
     /**
-    * Gets the parent node index
-    * @param aIndex The index of the current node
-    * @return The index of the parent (-1 if there is no parent)
+    * Reads the maximum value without removing it, O(1)
+    * @return The maximum value (throws PrecondViolatedExcep if the heap is empty)
     */
-    long getParentIndex( long aIndex ) const;
+    const T& peekMax() const;
 
     /**
-    * Gets the Grandparent node index
-    * @param aIndex The index of the current node
-    * @return The index of the grandparent (-1 if there is no parent)
+    * Deletes the minimum value and inserts aValue with a single trickle down
+    * @param aValue The value to be inserted
+    * @return The value that was deleted (throws PrecondViolatedExcep if the heap is empty)
     */
-    long getGrandparentIndex( long aIndex ) const;
+    T replaceMin( T aValue );
 
     /**
-    * Checks if a particular child (either 0, or 1) exists
-    * @param aIndex The index to check for children on
-    * @param aNthChild The child index that we're searching for (either 0, or 1)
-    * @return A flag indicating if a child does indeed exist (true if so, false if not)
+    * Deletes the maximum value and inserts aValue with a single trickle down
+    * @param aValue The value to be inserted
+    * @return The value that was deleted (throws PrecondViolatedExcep if the heap is empty)
     */
-    bool nthChildExists( long aIndex, long aNthChild ) const;
+    T replaceMax( T aValue );
 
     /**
-    * Checks if a particular grandchild (either 0,1,2,3) exists
-    * @param aIndex The index to check for grandchildren on
-    * @param aNthGrandchild The grandchild index that we're searching for (either 0,1,2,3)
-    * @return A flag indicating if a grandchild does indeed exist (true if so, false if not)
+    * Inserts aValue and then deletes the minimum, in a single trickle down at most.
+    * If aValue is not larger than the minimum it is handed straight back and the heap is untouched.
+    * @param aValue The value to be inserted
+    * @return The smallest of aValue and the values in the heap
     */
-    bool nthGrandchildExists( long aIndex, long aNthGrandchild ) const;
+    T pushPopMin( T aValue );
 
     /**
-    * Retreives the index of the child
-    * @param aIndex The index of the parent
-    * @param aNthChild The child that we're searching for
-    * @return The index of the child
+    * Inserts aValue and then deletes the maximum, in a single trickle down at most.
+    * If aValue is not smaller than the maximum it is handed straight back and the heap is untouched.
+    * @param aValue The value to be inserted
+    * @return The largest of aValue and the values in the heap
     */
-    long getNthChild( long aIndex, long aNthChild ) const;
+    T pushPopMax( T aValue );
 
     /**
-    * Retreives the index of the grandchild
-    * @param aIndex The index of the grandparent
-    * @param aNthGrandchild The grandchild that we're searching for
-    * @return The index of the grandchild
+    * Saves the heap to a versioned binary file holding the heap array as is (see MinMaxSnapshot).
+    * Only heaps of trivially copyable values can be saved, and only restored into a heap with the same Engine.
+    * @param aPath The path of the snapshot file, replaced atomically
+    * @return None (throws PrecondViolatedExcep if the file cannot be written)
     */
-    long getNthGrandchild( long aIndex, long aNthGrandchild ) const;
+    void saveSnapshot( const std::string& aPath ) const;
 
     /**
-    * Determines if aPossibleGrandchildIndex is a grandchild of aIndex
-    * @param aIndex The grandparent index
-    * @param aPossibleGrandchildIndex The index that we'll check to see the grandchild status of
-    * @return True if aPossibleGrandchildIndex is the grandchild index of aIndex, false otherwise
+    * Replaces the contents of the heap with a snapshot. The array is read back in one block, it is
+    * neither parsed nor heapified. MinMaxSnapshot::adopt maps a snapshot without even copying it.
+    * @param aPath The path of the snapshot file
+    * @return None (throws PrecondViolatedExcep if the file cannot be read or does not match the heap's
+    *         key type and ordering, the heap is left empty if reading fails midway)
     */
-    bool isGrandChildOfIndex( long aIndex, long aPossibleGrandchildIndex) const;
+    void loadSnapshot( const std::string& aPath );
 
     /**
-    * Helper function that computes powers of 2
-    * @param exponent The power to raise 2 to
-    * @return A power of 2
+    * Reads the operation counters and latency histograms gathered since the heap was created or
+    * resetStats was last called. Copies and moved-to heaps start with their own empty statistics.
+    * @return A snapshot of the statistics, all zero unless compiled with MINMAXHEAP_STATS
     */
-    long pow( const long exponent ) const;
+    MinMaxHeapStats stats() const;
+
+    /**
+    * Zeroes the operation counters and latency histograms
+    */
+    void resetStats();
 
     /**
     * Function that indicates if the heap is empty
@@ -164,55 +274,161 @@ private:
     bool isEmpty() const;
 
     /**
-    * Finds the index of the last parent
-    * @return The index of the last parent
+    * @return The number of values in the heap
     */
-    long lastParentIndex();
+    long size() const;
 
     /**
-    * Find out if the level that the index is on is a min level
-    * @return True if a min level, false otherwise (which indicates max level)
+    * @return The number of values the heap array can hold before it has to grow
     */
-    bool isMinLevel( long aIndex );
+    long capacity() const;
 
     /**
-    * Moves a value down through the heap to its proper spot
-    * @param aIndex The index of the value to move
+    * Makes sure the heap array can hold at least aCapacity values without growing
+    * @param aCapacity The requested capacity
     */
-    void trickleDown( long aIndex );
+    void reserve( long aCapacity );
 
     /**
-    * Moves a value up the heap
-    * @param aIndex The index of the value to move up the heap
+    * Shrinks the heap array so that its capacity matches the number of values
     */
-    void BubbleUp( long aIndex );
+    void shrink_to_fit();
 
     /**
-    * Moves a value up the max portion of the heap
-    * @param aIndex The index of the value to move up the heap
+    * Removes every value, the capacity is kept
     */
-    void BubbleUpMax( long aIndex );
+    void clear();
 
     /**
-    * Moves a value up the min portion of the heap
-    * @param aIndex The index of the value to move up the heap
+    * Exchanges the contents of two heaps without copying any values
+    * @param aOther The heap to swap with
     */
-    void BubbleUpMin( long aIndex );
+    void swap( MinMaxHeap& aOther ) noexcept;
 
     /**
-    * Moves a value down through the heap to its proper spot, assuming it's at a min level
-    * @param aIndex The index of the value to move
+    * @return A copy of the allocator used by the heap
+    */
+    allocator_type get_allocator() const;
+
+private:
+    typedef std::allocator_traits<Allocator> AllocTraits;
+    typedef MinMaxArrayStore<T, Compare> Store;
+
+    /**
+    * A function used to insert values without heapifying, used during bottom up construction
+    * @param aValue The value to be inserted into the heap
+    */
+    template <class U>
+    void bottomUpInsert( U&& aValue );
+
+    /**
+    * Heapifies the whole array bottom up
+    * @param aThreads The number of threads to use, the statistics only count a single threaded build
+    */
+    void build( long aThreads );
+
+    /**
+    * Exchanges the heap arrays, but not the orderings or statistics, of two heaps
+    * @return False if the allocators cannot free each other's arrays, nothing is exchanged then
+    */
+    bool swapStorage( MinMaxHeap& aOther );
+
+    /**
+    * Reserves room for a range whose length is known up front
+    */
+    template <class ForwardIterator>
+    void reserveFor( ForwardIterator aFirst, ForwardIterator aLast, std::forward_iterator_tag );
+
+    template <class InputIterator>
+    void reserveFor( InputIterator aFirst, InputIterator aLast, std::input_iterator_tag );
+
+    /**
+    * Destroys the slots from aNumNodes on and makes aNumNodes the new size
+    * @param aNumNodes The new number of nodes, at most mNumNodes
+    */
+    void truncate( long aNumNodes );
+
+    /**
+    * Accesses a value by its heap index (the root is at index 1)
+    * @param aIndex The heap index of the value
+    * @return A reference to the value
+    */
+    T& at( long aIndex );
+    const T& at( long aIndex ) const;
+
+    /**
+    * Compares two values using the heap's ordering
+    * @return True if aLeft is ordered before aRight
+    */
+    bool less( const T& aLeft, const T& aRight ) const;
+
+    /**
+    * Moves every value into a new array of aCapacity slots
+    * @param aCapacity The capacity of the new array, at least mNumNodes
+    */
+    void reallocate( long aCapacity );
+
+    /**
+    * Makes room for one more value, doubling the capacity when the array is full
+    */
+    void growIfFull();
+
+    /**
+    * Destroys every value and releases the heap array
+    */
+    void release();
+
+    /**
+    * Helper function that computes powers of 2
+    * @param exponent The power to raise 2 to
+    * @return A power of 2
+    */
+    long pow( const long exponent ) const;
+
+    /**
+    * @return The engine's view of the heap array
+    */
+    Store store() const;
+
+    /**
+    * @return Where operations are recorded, nullptr without MINMAXHEAP_STATS
     */
-    void trickleDownMin( long aIndex );
+    MinMaxHeapStats* statsTarget() const;
 
     /**
-    * Moves a value down through the heap to its proper spot, assuming it's at a max level
+    * Moves a value down through the heap to its proper spot
     * @param aIndex The index of the value to move
     */
-    void trickleDownMax( long aIndex );
+    void trickleDown( long aIndex );
+
+    /**
+    * Moves a value up the heap
+    * @param aIndex The index of the value to move up the heap
+    */
+    void BubbleUp( long aIndex );
 
-    long mNumNodes;     //!< The number of nodes in the heap
-    const long mSIZE;   //!< The size of the heapArray
-    long* mHeapArray;   //!< The heapArray
+    /**
+    * Removes the value at aIndex and fills its slot from the end of the heap
+    * @param aIndex The index of the value to remove
+    * @return The removed value
+    */
+    T removeAt( long aIndex );
+
+    Compare mCompare;       //!< The ordering of the heap values
+    Allocator mAllocator;   //!< The allocator that owns the heap array
+    long mNumNodes;         //!< The number of nodes in the heap
+    long mCapacity;         //!< The number of slots in the heapArray
+    T* mHeapArray;          //!< The heapArray, heap index i lives in slot i - 1
+#if defined( MINMAXHEAP_STATS )
+    mutable MinMaxHeapStats mStats; //!< Counters and latencies of this heap's operations
+#endif
 };
+
+/**
+* Exchanges the contents of two heaps without copying any values
+*/
+template <class T, class Compare, class Allocator, class Engine>
+void swap( MinMaxHeap<T, Compare, Allocator, Engine>& aLeft, MinMaxHeap<T, Compare, Allocator, Engine>& aRight ) noexcept;
+
+#include "MinMaxHeap.hpp"
 #endif // !MIN_MAX_HEAP_H
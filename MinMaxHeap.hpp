@@ -0,0 +1,835 @@
+/**
+*	@file : MinMaxHeap.hpp
+*	@author :  Haaris Chaudhry
+*	@date : Mar 9, 2017
+*	Purpose: Implementation of the MinMaxHeap class template.
+*/
+
+#include "PrecondViolatedExcep.h"
+#include <algorithm>
+#include <iostream>
+#include <utility>
+
+// Simple constructor that creates an empty array of size aSize
+template <class T, class Compare, class Allocator, class Engine>
+MinMaxHeap<T, Compare, Allocator, Engine>::MinMaxHeap( long aSize, const Compare& aCompare, const Allocator& aAllocator ) :
+    mCompare( aCompare ),
+    mAllocator( aAllocator ),
+    mNumNodes( 0 ),
+    mCapacity( 0 ),
+    mHeapArray( nullptr )
+{
+    reserve( aSize );
+}
+
+// This constructor is used when reading values from a file
+// Easier than using an array since we don't know how many numbers we'll read
+// First move the values over as they're given, walking the queue's blocks instead of
+// dequeueing one at a time, then go to the first parent and begin trickleDown from the
+// last parent to the first
+template <class T, class Compare, class Allocator, class Engine>
+MinMaxHeap<T, Compare, Allocator, Engine>::MinMaxHeap( long aSize, Queue<T>& aQueue, long aThreads ) :
+    MinMaxHeap( aSize )
+{
+    MinMaxStatsScope scope( statsTarget(), MinMaxHeapStats::BUILD );
+    reserve( aQueue.size() );
+
+    for( typename Queue<T>::iterator it = aQueue.begin(); it != aQueue.end(); ++it )
+    {
+        bottomUpInsert( std::move( *it ) );
+    }
+
+    aQueue.clear();
+    build( aThreads );
+}
+
+// This constructor uses an array to construct the heap
+// First insert each value in the array in order, and then
+// find the last parent and trickleDown for each parent
+// starting from the last to the first
+// (the values are copied, MinMaxHeapView heapifies a caller's array in place instead)
+template <class T, class Compare, class Allocator, class Engine>
+MinMaxHeap<T, Compare, Allocator, Engine>::MinMaxHeap( long aSize, const T values[], long valuesSize, long aThreads ) :
+    MinMaxHeap( aSize )
+{
+    MinMaxStatsScope scope( statsTarget(), MinMaxHeapStats::BUILD );
+    reserve( valuesSize );
+
+    for( long i = 0; i < valuesSize; i++ )
+    {
+        bottomUpInsert( values[i] );
+    }
+
+    build( aThreads );
+}
+
+// The counters are not shared between threads, so a parallel build runs on a store without them
+template <class T, class Compare, class Allocator, class Engine>
+void MinMaxHeap<T, Compare, Allocator, Engine>::build( long aThreads )
+{
+    if( aThreads == 1 )
+    {
+        Store heapStore = store();
+        Engine::build( heapStore, mNumNodes );
+    }
+    else
+    {
+        Store heapStore( mHeapArray, mCompare );
+        Engine::buildParallel( heapStore, mNumNodes, aThreads );
+    }
+}
+
+// The copy constructor copies each value into an array of the same capacity
+template <class T, class Compare, class Allocator, class Engine>
+MinMaxHeap<T, Compare, Allocator, Engine>::MinMaxHeap( const MinMaxHeap& aOther ) :
+    mCompare( aOther.mCompare ),
+    mAllocator( AllocTraits::select_on_container_copy_construction( aOther.mAllocator ) ),
+    mNumNodes( 0 ),
+    mCapacity( 0 ),
+    mHeapArray( nullptr )
+{
+    reserve( aOther.mCapacity );
+
+    for( long i = 1; i <= aOther.mNumNodes; i++ )
+    {
+        bottomUpInsert( aOther.at( i ) );
+    }
+}
+
+// The move constructor steals the array, aOther is left without storage
+template <class T, class Compare, class Allocator, class Engine>
+MinMaxHeap<T, Compare, Allocator, Engine>::MinMaxHeap( MinMaxHeap&& aOther ) noexcept :
+    mCompare( std::move( aOther.mCompare ) ),
+    mAllocator( std::move( aOther.mAllocator ) ),
+    mNumNodes( aOther.mNumNodes ),
+    mCapacity( aOther.mCapacity ),
+    mHeapArray( aOther.mHeapArray )
+{
+    aOther.mNumNodes = 0;
+    aOther.mCapacity = 0;
+    aOther.mHeapArray = nullptr;
+}
+
+// Copy assignment, built on the copy constructor and swap
+template <class T, class Compare, class Allocator, class Engine>
+MinMaxHeap<T, Compare, Allocator, Engine>& MinMaxHeap<T, Compare, Allocator, Engine>::operator=( const MinMaxHeap& aOther )
+{
+    if( this != &aOther )
+    {
+        MinMaxHeap copy( aOther );
+
+        if( AllocTraits::propagate_on_container_copy_assignment::value )
+        {
+            swap( copy );
+        }
+        else
+        {
+            // Keep our own allocator, only the values and the ordering are copied
+            release();
+            mCompare = copy.mCompare;
+            reserve( copy.mCapacity );
+
+            for( long i = 1; i <= copy.mNumNodes; i++ )
+            {
+                bottomUpInsert( std::move( copy.at( i ) ) );
+            }
+        }
+    }
+
+    return *this;
+}
+
+// Move assignment steals the array when the allocators allow it, otherwise the values are moved one by one
+template <class T, class Compare, class Allocator, class Engine>
+MinMaxHeap<T, Compare, Allocator, Engine>& MinMaxHeap<T, Compare, Allocator, Engine>::operator=( MinMaxHeap&& aOther )
+{
+    if( this == &aOther )
+    {
+        return *this;
+    }
+
+    release();
+    mCompare = std::move( aOther.mCompare );
+
+    if( AllocTraits::propagate_on_container_move_assignment::value || mAllocator == aOther.mAllocator )
+    {
+        if( AllocTraits::propagate_on_container_move_assignment::value )
+        {
+            mAllocator = std::move( aOther.mAllocator );
+        }
+
+        mNumNodes = aOther.mNumNodes;
+        mCapacity = aOther.mCapacity;
+        mHeapArray = aOther.mHeapArray;
+        aOther.mNumNodes = 0;
+        aOther.mCapacity = 0;
+        aOther.mHeapArray = nullptr;
+    }
+    else
+    {
+        reserve( aOther.mNumNodes );
+
+        for( long i = 1; i <= aOther.mNumNodes; i++ )
+        {
+            bottomUpInsert( std::move( aOther.at( i ) ) );
+        }
+
+        aOther.clear();
+    }
+
+    return *this;
+}
+
+// The destructor, destroys the heap array
+template <class T, class Compare, class Allocator, class Engine>
+MinMaxHeap<T, Compare, Allocator, Engine>::~MinMaxHeap()
+{
+    release();
+}
+
+// Destroys every value and gives the array back to the allocator
+template <class T, class Compare, class Allocator, class Engine>
+void MinMaxHeap<T, Compare, Allocator, Engine>::release()
+{
+    clear();
+
+    if( mHeapArray != nullptr )
+    {
+        AllocTraits::deallocate( mAllocator, mHeapArray, mCapacity );
+    }
+
+    mHeapArray = nullptr;
+    mCapacity = 0;
+}
+
+// Moves the values into a freshly allocated array of aCapacity slots
+template <class T, class Compare, class Allocator, class Engine>
+void MinMaxHeap<T, Compare, Allocator, Engine>::reallocate( long aCapacity )
+{
+    T* newArray = nullptr;
+
+    if( aCapacity > 0 )
+    {
+        newArray = AllocTraits::allocate( mAllocator, aCapacity );
+    }
+
+    for( long i = 0; i < mNumNodes; i++ )
+    {
+        AllocTraits::construct( mAllocator, newArray + i, std::move_if_noexcept( mHeapArray[i] ) );
+        AllocTraits::destroy( mAllocator, mHeapArray + i );
+    }
+
+    if( mHeapArray != nullptr )
+    {
+        AllocTraits::deallocate( mAllocator, mHeapArray, mCapacity );
+    }
+
+    mHeapArray = newArray;
+    mCapacity = aCapacity;
+}
+
+// Doubles the capacity once the array is full so that a run of inserts is amortized O(1) in allocations
+template <class T, class Compare, class Allocator, class Engine>
+void MinMaxHeap<T, Compare, Allocator, Engine>::growIfFull()
+{
+    if( mNumNodes == mCapacity )
+    {
+        reallocate( mCapacity < 4 ? 8 : mCapacity * 2 );
+    }
+}
+
+// Only ever grows the array
+template <class T, class Compare, class Allocator, class Engine>
+void MinMaxHeap<T, Compare, Allocator, Engine>::reserve( long aCapacity )
+{
+    if( aCapacity > mCapacity )
+    {
+        reallocate( aCapacity );
+    }
+}
+
+// Trims the array down to the number of values
+template <class T, class Compare, class Allocator, class Engine>
+void MinMaxHeap<T, Compare, Allocator, Engine>::shrink_to_fit()
+{
+    if( mCapacity > mNumNodes )
+    {
+        reallocate( mNumNodes );
+    }
+}
+
+// Destroys the values but keeps the array
+template <class T, class Compare, class Allocator, class Engine>
+void MinMaxHeap<T, Compare, Allocator, Engine>::clear()
+{
+    truncate( 0 );
+}
+
+// Swaps the arrays and bookkeeping, no values are touched
+template <class T, class Compare, class Allocator, class Engine>
+void MinMaxHeap<T, Compare, Allocator, Engine>::swap( MinMaxHeap& aOther ) noexcept
+{
+    using std::swap;
+
+    swap( mCompare, aOther.mCompare );
+
+    if( AllocTraits::propagate_on_container_swap::value )
+    {
+        swap( mAllocator, aOther.mAllocator );
+    }
+
+    swap( mNumNodes, aOther.mNumNodes );
+    swap( mCapacity, aOther.mCapacity );
+    swap( mHeapArray, aOther.mHeapArray );
+}
+
+template <class T, class Compare, class Allocator, class Engine>
+void swap( MinMaxHeap<T, Compare, Allocator, Engine>& aLeft, MinMaxHeap<T, Compare, Allocator, Engine>& aRight ) noexcept
+{
+    aLeft.swap( aRight );
+}
+
+template <class T, class Compare, class Allocator, class Engine>
+typename MinMaxHeap<T, Compare, Allocator, Engine>::allocator_type MinMaxHeap<T, Compare, Allocator, Engine>::get_allocator() const
+{
+    return mAllocator;
+}
+
+template <class T, class Compare, class Allocator, class Engine>
+long MinMaxHeap<T, Compare, Allocator, Engine>::size() const
+{
+    return mNumNodes;
+}
+
+template <class T, class Compare, class Allocator, class Engine>
+long MinMaxHeap<T, Compare, Allocator, Engine>::capacity() const
+{
+    return mCapacity;
+}
+
+// Heap indices start at 1, the array starts at 0
+template <class T, class Compare, class Allocator, class Engine>
+T& MinMaxHeap<T, Compare, Allocator, Engine>::at( long aIndex )
+{
+    return mHeapArray[aIndex - 1];
+}
+
+template <class T, class Compare, class Allocator, class Engine>
+const T& MinMaxHeap<T, Compare, Allocator, Engine>::at( long aIndex ) const
+{
+    return mHeapArray[aIndex - 1];
+}
+
+template <class T, class Compare, class Allocator, class Engine>
+bool MinMaxHeap<T, Compare, Allocator, Engine>::less( const T& aLeft, const T& aRight ) const
+{
+    return store().less( aLeft, aRight );
+}
+
+// bottomUpInsert simply inserts values in the heap
+// without heapifying. aValue may be one of the heap's own values, so before the array
+// moves it is taken out into a local
+template <class T, class Compare, class Allocator, class Engine>
+template <class U>
+void MinMaxHeap<T, Compare, Allocator, Engine>::bottomUpInsert( U&& aValue )
+{
+    if( mNumNodes == mCapacity )
+    {
+        T value( std::forward<U>( aValue ) );
+        growIfFull();
+        AllocTraits::construct( mAllocator, mHeapArray + mNumNodes, std::move( value ) );
+    }
+    else
+    {
+        AllocTraits::construct( mAllocator, mHeapArray + mNumNodes, std::forward<U>( aValue ) );
+    }
+
+    mNumNodes++;
+}
+
+// Inserts values into the heap, and then heapifies
+template <class T, class Compare, class Allocator, class Engine>
+void MinMaxHeap<T, Compare, Allocator, Engine>::insert( const T& aValue )
+{
+    MinMaxStatsScope scope( statsTarget(), MinMaxHeapStats::INSERT );
+    bottomUpInsert( aValue );
+    BubbleUp( mNumNodes );
+}
+
+template <class T, class Compare, class Allocator, class Engine>
+void MinMaxHeap<T, Compare, Allocator, Engine>::insert( T&& aValue )
+{
+    MinMaxStatsScope scope( statsTarget(), MinMaxHeapStats::INSERT );
+    bottomUpInsert( std::move( aValue ) );
+    BubbleUp( mNumNodes );
+}
+
+// Append everything, then let the engine pick between a rebuild and bubbling up the new values.
+// If appending throws, the values that made it in are still heapified so the heap stays valid.
+template <class T, class Compare, class Allocator, class Engine>
+template <class InputIterator>
+void MinMaxHeap<T, Compare, Allocator, Engine>::insertRange( InputIterator aFirst, InputIterator aLast )
+{
+    MinMaxStatsScope scope( statsTarget(), MinMaxHeapStats::INSERT_RANGE );
+    long oldNumNodes = mNumNodes;
+    reserveFor( aFirst, aLast, typename std::iterator_traits<InputIterator>::iterator_category() );
+
+    try
+    {
+        for( ; aFirst != aLast; ++aFirst )
+        {
+            bottomUpInsert( *aFirst );
+        }
+    }
+    catch( ... )
+    {
+        Store heapStore = store();
+        Engine::heapifyAppended( heapStore, oldNumNodes, mNumNodes );
+        throw;
+    }
+
+    Store heapStore = store();
+    Engine::heapifyAppended( heapStore, oldNumNodes, mNumNodes );
+}
+
+// The smaller heap is always the batch, so a meld costs O(k) bubble ups on average for the k values
+// of the smaller heap and never more than one bottom up pass over both
+template <class T, class Compare, class Allocator, class Engine>
+void MinMaxHeap<T, Compare, Allocator, Engine>::meld( MinMaxHeap& aOther )
+{
+    if( this == &aOther || aOther.isEmpty() )
+    {
+        return;
+    }
+
+    MinMaxStatsScope scope( statsTarget(), MinMaxHeapStats::MELD );
+
+    if( mNumNodes < aOther.mNumNodes )
+    {
+        swapStorage( aOther );
+    }
+
+    long oldNumNodes = mNumNodes;
+    reserve( mNumNodes + aOther.mNumNodes );
+
+    for( long i = 1; i <= aOther.mNumNodes; i++ )
+    {
+        bottomUpInsert( std::move( aOther.at( i ) ) );
+    }
+
+    aOther.clear();
+    Store heapStore = store();
+    Engine::heapifyAppended( heapStore, oldNumNodes, mNumNodes );
+}
+
+template <class T, class Compare, class Allocator, class Engine>
+void MinMaxHeap<T, Compare, Allocator, Engine>::meld( MinMaxHeap&& aOther )
+{
+    meld( aOther );
+}
+
+// When every value or none moves, the split only hands over or keeps the array
+template <class T, class Compare, class Allocator, class Engine>
+MinMaxHeap<T, Compare, Allocator, Engine> MinMaxHeap<T, Compare, Allocator, Engine>::splitAt( const T& aPivot )
+{
+    MinMaxStatsScope scope( statsTarget(), MinMaxHeapStats::SPLIT_AT );
+    MinMaxHeap upper( 0, mCompare, mAllocator );
+
+    if( isEmpty() || less( peekMax(), aPivot ) )
+    {
+        return upper;
+    }
+
+    if( !less( at( 1 ), aPivot ) && upper.swapStorage( *this ) )
+    {
+        return upper;
+    }
+
+    T* middle = std::partition( mHeapArray, mHeapArray + mNumNodes, [this, &aPivot]( const T& aValue )
+    {
+        return less( aValue, aPivot );
+    } );
+
+    long lowerNumNodes = static_cast<long>( middle - mHeapArray );
+    upper.reserve( mNumNodes - lowerNumNodes );
+
+    for( long i = lowerNumNodes; i < mNumNodes; i++ )
+    {
+        upper.bottomUpInsert( std::move( mHeapArray[i] ) );
+    }
+
+    truncate( lowerNumNodes );
+
+    Store heapStore = store();
+    Engine::build( heapStore, mNumNodes );
+    Store upperStore = upper.store();
+    Engine::build( upperStore, upper.mNumNodes );
+    return upper;
+}
+
+// remove_if keeps the surviving values in one run at the front, nothing is rebuilt if none went
+template <class T, class Compare, class Allocator, class Engine>
+template <class Predicate>
+long MinMaxHeap<T, Compare, Allocator, Engine>::eraseIf( Predicate aPredicate )
+{
+    MinMaxStatsScope scope( statsTarget(), MinMaxHeapStats::ERASE_IF );
+    T* last = std::remove_if( mHeapArray, mHeapArray + mNumNodes, aPredicate );
+    long numKept = static_cast<long>( last - mHeapArray );
+    long numRemoved = mNumNodes - numKept;
+
+    if( numRemoved > 0 )
+    {
+        truncate( numKept );
+        Store heapStore = store();
+        Engine::build( heapStore, mNumNodes );
+    }
+
+    return numRemoved;
+}
+
+template <class T, class Compare, class Allocator, class Engine>
+bool MinMaxHeap<T, Compare, Allocator, Engine>::swapStorage( MinMaxHeap& aOther )
+{
+    using std::swap;
+
+    if( AllocTraits::propagate_on_container_swap::value )
+    {
+        swap( mAllocator, aOther.mAllocator );
+    }
+    else if( !( mAllocator == aOther.mAllocator ) )
+    {
+        return false;
+    }
+
+    swap( mNumNodes, aOther.mNumNodes );
+    swap( mCapacity, aOther.mCapacity );
+    swap( mHeapArray, aOther.mHeapArray );
+    return true;
+}
+
+template <class T, class Compare, class Allocator, class Engine>
+template <class ForwardIterator>
+void MinMaxHeap<T, Compare, Allocator, Engine>::reserveFor( ForwardIterator aFirst, ForwardIterator aLast, std::forward_iterator_tag )
+{
+    reserve( mNumNodes + static_cast<long>( std::distance( aFirst, aLast ) ) );
+}
+
+// The length of a single pass range is unknown, the array grows as values arrive
+template <class T, class Compare, class Allocator, class Engine>
+template <class InputIterator>
+void MinMaxHeap<T, Compare, Allocator, Engine>::reserveFor( InputIterator, InputIterator, std::input_iterator_tag )
+{
+}
+
+template <class T, class Compare, class Allocator, class Engine>
+void MinMaxHeap<T, Compare, Allocator, Engine>::levelOrderDisplay()          // Displays values in order
+{
+    long nodeCount = 1;
+
+    if( isEmpty() )
+    {
+        std::cout << std::endl;
+        return;
+    }
+
+    for( long i = 0; i <= mNumNodes; i++ )
+    {
+        long valuesPerLevel = pow( i ) * Engine::kValuesPerNode;    // Each level contains (2 ^ level) nodes
+
+        for( long j = 0; j < valuesPerLevel; j++ )
+        {
+            std::cout << at( nodeCount ) << " ";
+            nodeCount++;
+
+            if( ( ( j + 1 ) % 2 == 0 ) && ( j != 0 ) && ( j != valuesPerLevel - 1 ) && nodeCount != mNumNodes + 1 )
+            {
+                std::cout << "- ";
+            }
+            if( nodeCount == mNumNodes + 1 )                            // Stop displaying if we reach the end of the heap
+            {
+                std::cout << std::endl;
+                return;
+            }
+        }
+
+        std::cout << std::endl;
+    }
+}
+
+// replaces the top value with the last value then heapifies
+template <class T, class Compare, class Allocator, class Engine>
+T MinMaxHeap<T, Compare, Allocator, Engine>::deleteMin()
+{
+    if( isEmpty() )
+    {
+        throw PrecondViolatedExcep( "deleteMin attempted on an empty heap" );
+    }
+
+    MinMaxStatsScope scope( statsTarget(), MinMaxHeapStats::DELETE_MIN );
+
+    return removeAt( 1 );
+}
+
+// looks for the maximum value and then replaces it with the last value in the heap, then heapifies
+template <class T, class Compare, class Allocator, class Engine>
+T MinMaxHeap<T, Compare, Allocator, Engine>::deleteMax()
+{
+    if( isEmpty() )
+    {
+        throw PrecondViolatedExcep( "deleteMax attempted on an empty heap" );
+    }
+
+    MinMaxStatsScope scope( statsTarget(), MinMaxHeapStats::DELETE_MAX );
+
+    return removeAt( Engine::maxIndex( store(), mNumNodes ) );
+}
+
+// The engine leaves a moved-from value in each vacated slot, truncate destroys them once the batch is done
+template <class T, class Compare, class Allocator, class Engine>
+template <class OutputIterator>
+OutputIterator MinMaxHeap<T, Compare, Allocator, Engine>::popMinK( OutputIterator aOut, long aCount )
+{
+    MinMaxStatsScope scope( statsTarget(), MinMaxHeapStats::POP_MIN_K );
+    Store heapStore = store();
+    long numNodes = mNumNodes;
+    aOut = MinMaxHeapOps<Engine>::popMinK( heapStore, numNodes, aOut, aCount );
+    truncate( numNodes );
+    return aOut;
+}
+
+template <class T, class Compare, class Allocator, class Engine>
+template <class OutputIterator>
+OutputIterator MinMaxHeap<T, Compare, Allocator, Engine>::popMaxK( OutputIterator aOut, long aCount )
+{
+    MinMaxStatsScope scope( statsTarget(), MinMaxHeapStats::POP_MAX_K );
+    Store heapStore = store();
+    long numNodes = mNumNodes;
+    aOut = MinMaxHeapOps<Engine>::popMaxK( heapStore, numNodes, aOut, aCount );
+    truncate( numNodes );
+    return aOut;
+}
+
+template <class T, class Compare, class Allocator, class Engine>
+template <class LowOutputIterator, class HighOutputIterator>
+std::pair<LowOutputIterator, HighOutputIterator> MinMaxHeap<T, Compare, Allocator, Engine>::drainBoth( LowOutputIterator aLowOut, HighOutputIterator aHighOut )
+{
+    MinMaxStatsScope scope( statsTarget(), MinMaxHeapStats::DRAIN_BOTH );
+    Store heapStore = store();
+    long numNodes = mNumNodes;
+    std::pair<LowOutputIterator, HighOutputIterator> outs = MinMaxHeapOps<Engine>::drainBoth( heapStore, numNodes, aLowOut, aHighOut );
+    truncate( 0 );
+    return outs;
+}
+
+template <class T, class Compare, class Allocator, class Engine>
+void MinMaxHeap<T, Compare, Allocator, Engine>::truncate( long aNumNodes )
+{
+    for( long i = aNumNodes; i < mNumNodes; i++ )
+    {
+        AllocTraits::destroy( mAllocator, mHeapArray + i );
+    }
+
+    mNumNodes = aNumNodes;
+}
+
+// The minimum is always the root
+template <class T, class Compare, class Allocator, class Engine>
+const T& MinMaxHeap<T, Compare, Allocator, Engine>::peekMin() const
+{
+    if( isEmpty() )
+    {
+        throw PrecondViolatedExcep( "peekMin attempted on an empty heap" );
+    }
+
+    return at( 1 );
+}
+
+// With one or two nodes the max is the last node, otherwise it is the larger of the two max-level children
+template <class T, class Compare, class Allocator, class Engine>
+const T& MinMaxHeap<T, Compare, Allocator, Engine>::peekMax() const
+{
+    if( isEmpty() )
+    {
+        throw PrecondViolatedExcep( "peekMax attempted on an empty heap" );
+    }
+
+    return at( Engine::maxIndex( store(), mNumNodes ) );
+}
+
+template <class T, class Compare, class Allocator, class Engine>
+T MinMaxHeap<T, Compare, Allocator, Engine>::replaceMin( T aValue )
+{
+    if( isEmpty() )
+    {
+        throw PrecondViolatedExcep( "replaceMin attempted on an empty heap" );
+    }
+
+    MinMaxStatsScope scope( statsTarget(), MinMaxHeapStats::REPLACE_MIN );
+    Store heapStore = store();
+    return MinMaxHeapOps<Engine>::replaceMin( heapStore, mNumNodes, std::move( aValue ) );
+}
+
+template <class T, class Compare, class Allocator, class Engine>
+T MinMaxHeap<T, Compare, Allocator, Engine>::replaceMax( T aValue )
+{
+    if( isEmpty() )
+    {
+        throw PrecondViolatedExcep( "replaceMax attempted on an empty heap" );
+    }
+
+    MinMaxStatsScope scope( statsTarget(), MinMaxHeapStats::REPLACE_MAX );
+    Store heapStore = store();
+    return MinMaxHeapOps<Engine>::replaceMax( heapStore, mNumNodes, std::move( aValue ) );
+}
+
+template <class T, class Compare, class Allocator, class Engine>
+T MinMaxHeap<T, Compare, Allocator, Engine>::pushPopMin( T aValue )
+{
+    MinMaxStatsScope scope( statsTarget(), MinMaxHeapStats::PUSH_POP_MIN );
+    Store heapStore = store();
+    return MinMaxHeapOps<Engine>::pushPopMin( heapStore, mNumNodes, std::move( aValue ) );
+}
+
+template <class T, class Compare, class Allocator, class Engine>
+T MinMaxHeap<T, Compare, Allocator, Engine>::pushPopMax( T aValue )
+{
+    MinMaxStatsScope scope( statsTarget(), MinMaxHeapStats::PUSH_POP_MAX );
+    Store heapStore = store();
+    return MinMaxHeapOps<Engine>::pushPopMax( heapStore, mNumNodes, std::move( aValue ) );
+}
+
+// The last value is carried straight into the hole left at aIndex, it is never written to aIndex first
+template <class T, class Compare, class Allocator, class Engine>
+T MinMaxHeap<T, Compare, Allocator, Engine>::removeAt( long aIndex )
+{
+    Store heapStore = store();
+    T removedValue = heapStore.take( aIndex );
+
+    if( aIndex == mNumNodes )
+    {
+        AllocTraits::destroy( mAllocator, mHeapArray + mNumNodes - 1 );
+        mNumNodes--;
+        return removedValue;
+    }
+
+    T lastValue = heapStore.take( mNumNodes );
+    AllocTraits::destroy( mAllocator, mHeapArray + mNumNodes - 1 );
+    mNumNodes--;
+
+    Engine::trickleDownHole( heapStore, aIndex, std::move( lastValue ), mNumNodes );
+    return removedValue;
+}
+
+template <class T, class Compare, class Allocator, class Engine>
+typename MinMaxHeap<T, Compare, Allocator, Engine>::Store MinMaxHeap<T, Compare, Allocator, Engine>::store() const
+{
+    return Store( mHeapArray, mCompare, statsTarget() );
+}
+
+template <class T, class Compare, class Allocator, class Engine>
+MinMaxHeapStats* MinMaxHeap<T, Compare, Allocator, Engine>::statsTarget() const
+{
+#if defined( MINMAXHEAP_STATS )
+    return &mStats;
+#else
+    return nullptr;
+#endif
+}
+
+template <class T, class Compare, class Allocator, class Engine>
+MinMaxHeapStats MinMaxHeap<T, Compare, Allocator, Engine>::stats() const
+{
+#if defined( MINMAXHEAP_STATS )
+    return mStats;
+#else
+    return MinMaxHeapStats();
+#endif
+}
+
+template <class T, class Compare, class Allocator, class Engine>
+void MinMaxHeap<T, Compare, Allocator, Engine>::resetStats()
+{
+#if defined( MINMAXHEAP_STATS )
+    mStats.reset();
+#endif
+}
+
+// TrickleDown hands the value to the engine, which decides whether to use the min trees or max trees
+template <class T, class Compare, class Allocator, class Engine>
+void MinMaxHeap<T, Compare, Allocator, Engine>::trickleDown( long aIndex )
+{
+    Store heapStore = store();
+    Engine::trickleDown( heapStore, aIndex, mNumNodes );
+}
+
+// Bubble up moves the value up while maintaining the min-max heap ordered structure
+template <class T, class Compare, class Allocator, class Engine>
+void MinMaxHeap<T, Compare, Allocator, Engine>::BubbleUp( long aIndex )
+{
+    Store heapStore = store();
+    Engine::bubbleUp( heapStore, aIndex );
+}
+
+// Calculates powers of 2
+template <class T, class Compare, class Allocator, class Engine>
+long MinMaxHeap<T, Compare, Allocator, Engine>::pow( const long exponent ) const
+{
+    if( exponent == 0 )
+    {
+        return 1;
+    }
+    else
+    {
+        long returnValue = 1;
+
+        for( long i = 0; i < exponent; i++ )
+        {
+            returnValue *= 2;
+        }
+
+        return returnValue;
+    }
+}
+
+template <class T, class Compare, class Allocator, class Engine>
+void MinMaxHeap<T, Compare, Allocator, Engine>::saveSnapshot( const std::string& aPath ) const
+{
+    MinMaxSnapshot::save<T, Compare>( aPath, mHeapArray, mNumNodes, Engine::kLayout );
+}
+
+// The values are trivially copyable, so the bytes of the file can go straight into the array
+template <class T, class Compare, class Allocator, class Engine>
+void MinMaxHeap<T, Compare, Allocator, Engine>::loadSnapshot( const std::string& aPath )
+{
+    long numNodes = 0;
+    std::FILE* file = MinMaxSnapshot::open<T, Compare>( aPath, numNodes, Engine::kLayout );
+
+    clear();
+
+    try
+    {
+        reserve( numNodes );
+    }
+    catch( ... )
+    {
+        std::fclose( file );
+        throw;
+    }
+
+    long numRead = ( numNodes == 0 ) ? 0 : static_cast<long>( std::fread( mHeapArray, sizeof( T ), static_cast<size_t>( numNodes ), file ) );
+    std::fclose( file );
+
+    if( numRead != numNodes )
+    {
+        throw PrecondViolatedExcep( aPath + " is truncated" );
+    }
+
+    mNumNodes = numNodes;
+}
+
+// Check if the heap is empty
+template <class T, class Compare, class Allocator, class Engine>
+bool MinMaxHeap<T, Compare, Allocator, Engine>::isEmpty() const
+{
+    return ( mNumNodes == 0 );
+}
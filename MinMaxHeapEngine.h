@@ -0,0 +1,333 @@
+/**
+*	@file : MinMaxHeapEngine.h
+*	@author :  Haaris Chaudhry
+*	@date : Mar 9, 2017
+*	Purpose: The sift routines shared by every min-max heap container.  The engine moves a "hole" up or
+*          down the tree and writes each displaced value once, instead of swapping at every level.
+*          It works on heap indices (the root is 1) through a Store, so the same code runs over an
+*          owned array, a caller's buffer or parallel key/payload arrays.
+*
+*          A Store provides:
+*              typedef ... Key;                          the type that is compared
+*              typedef ... Held;                         the type carried in the hole
+*              const Key& key( long aIndex ) const;      the key at a heap index
+*              const Key& keyOf( const Held& ) const;    the key of a carried value
+*              bool less( const Key&, const Key& ) const;
+*              Held take( long aIndex );                 moves a value out, leaving a hole
+*              void move( long aFrom, long aTo );        moves a value into the hole at aTo
+*              void put( long aIndex, Held&& aHeld );    fills the hole at aIndex
+*              void exchange( long aIndex, Held& aHeld ); swaps a stored value with the carried one
+*
+*          With MINMAXHEAP_STATS defined, MinMaxArrayStore counts the comparisons and moves made
+*          through it and the engine reports levels travelled and child versus grandchild picks to it.
+*/
+
+#ifndef MIN_MAX_HEAP_ENGINE_H
+#define MIN_MAX_HEAP_ENGINE_H
+
+#include "MinMaxHeapStats.h"
+#include "MinMaxSimd.h"
+#include <atomic>
+#include <functional>
+#include <new>
+#include <system_error>
+#include <thread>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+template <class T, class Compare>
+class MinMaxArrayStore;
+
+template <class K, class P, class Compare>
+class MinMaxSplitStore;
+
+class MinMaxHeapEngine
+{
+public:
+    static const int kLayout = 1;           //!< Identifies the array layout in snapshots
+    static const long kValuesPerNode = 1;   //!< One value per node of the tree
+
+    /**
+    * Find out if the level that the index is on is a min level
+    * @param aIndex A heap index, at least 1
+    * @return True if a min level, false otherwise (which indicates max level)
+    */
+    static bool isMinLevel( long aIndex );
+
+    /**
+    * Moves the value at aIndex up the heap to its proper spot
+    * @param aStore The heap storage
+    * @param aIndex The index of the value to move up the heap
+    */
+    template <class Store>
+    static void bubbleUp( Store& aStore, long aIndex );
+
+    /**
+    * Moves the value at aIndex down through the heap to its proper spot
+    * @param aStore The heap storage
+    * @param aIndex The index of the value to move
+    * @param aNumNodes The number of nodes in the heap
+    */
+    template <class Store>
+    static void trickleDown( Store& aStore, long aIndex, long aNumNodes );
+
+    /**
+    * Fills the hole at aHole with aHeld, moving it down through the heap to its proper spot
+    * @param aStore The heap storage
+    * @param aHole The index of an empty slot
+    * @param aHeld The value that belongs somewhere in the subtree of aHole
+    * @param aNumNodes The number of nodes in the heap
+    */
+    template <class Store>
+    static void trickleDownHole( Store& aStore, long aHole, typename Store::Held&& aHeld, long aNumNodes );
+
+    /**
+    * Fills the hole left by the maximum with aHeld. Unlike the last value of the heap, aHeld may be
+    * smaller than the root, in which case it becomes the new root and the old root moves down instead.
+    * @param aStore The heap storage
+    * @param aHole The index the maximum was taken from (see maxIndex)
+    * @param aHeld The value to put back into the heap
+    * @param aNumNodes The number of nodes in the heap
+    */
+    template <class Store>
+    static void fillMaxHole( Store& aStore, long aHole, typename Store::Held&& aHeld, long aNumNodes );
+
+    /**
+    * Takes the minimum out and carries the last value into its hole. The last slot is left holding a
+    * moved-from value for the container to dispose of.
+    * @param aStore The heap storage
+    * @param aNumNodes The number of nodes in the heap, at least 1, decremented by one
+    * @return The minimum
+    */
+    template <class Store>
+    static typename Store::Held popMin( Store& aStore, long& aNumNodes );
+
+    /**
+    * Takes the maximum out and carries the last value into its hole, like popMin
+    * @param aStore The heap storage
+    * @param aNumNodes The number of nodes in the heap, at least 1, decremented by one
+    * @return The maximum
+    */
+    template <class Store>
+    static typename Store::Held popMax( Store& aStore, long& aNumNodes );
+
+    /**
+    * Finds the maximum, the root if it is alone, otherwise the larger node on the first max level
+    * @param aStore The heap storage
+    * @param aNumNodes The number of nodes in the heap, at least 1
+    * @return The index of the maximum
+    */
+    template <class Store>
+    static long maxIndex( const Store& aStore, long aNumNodes );
+
+    /**
+    * Bottom up construction, trickles down every parent starting from the last one
+    * @param aStore The heap storage holding aNumNodes values in any order
+    * @param aNumNodes The number of nodes in the heap
+    */
+    template <class Store>
+    static void build( Store& aStore, long aNumNodes );
+
+    /**
+    * Bottom up construction split over threads. Trickling a node down only touches its own subtree,
+    * so the subtrees below one level are heapified concurrently, each one bottom up, and the levels
+    * above them are finished on the calling thread. Every node is still trickled down after all of
+    * its descendants, so the result is identical, value for value, to build's.
+    * The Store's comparisons must not throw, and must be safe to call from several threads at once.
+    * @param aStore The heap storage holding aNumNodes values in any order, used by every thread
+    * @param aNumNodes The number of nodes in the heap
+    * @param aThreads The number of threads to use including the caller, 0 for one per hardware
+    *        thread. Heaps under kParallelBuildMinimum nodes are built serially, and threads that
+    *        cannot be started leave their share to the ones that did (see runOnThreads).
+    */
+    template <class Store>
+    static void buildParallel( Store& aStore, long aNumNodes, long aThreads );
+
+    static const long kParallelBuildMinimum = 1L << 17;
+
+    /**
+    * Runs aWork on the calling thread and on aThreads - 1 more. A thread that cannot be started is
+    * left out, so aWork has to hand its work out through a shared counter: the threads that did
+    * start, the calling one included, then finish it. Every started thread is joined before return.
+    * @param aWork The work, called once per thread, must not throw
+    * @param aThreads The number of threads including the caller
+    */
+    template <class Work>
+    static void runOnThreads( Work& aWork, long aThreads );
+
+    /**
+    * Restores the heap after a batch of values was appended to it without heapifying. A batch at least
+    * as large as the heap is absorbed with one bottom up pass over everything, O(n + k); a smaller one
+    * is bubbled up value by value, O(k log n) worst case and O(k) on average.
+    * @param aStore The heap storage
+    * @param aOldNumNodes The number of nodes that already formed a heap before the batch
+    * @param aNumNodes The number of nodes including the batch
+    */
+    template <class Store>
+    static void heapifyAppended( Store& aStore, long aOldNumNodes, long aNumNodes );
+
+    /**
+    * Decides how heapifyAppended absorbs a batch
+    * @return True if rebuilding the whole heap is expected to be cheaper than bubbling up the batch
+    */
+    static bool prefersRebuild( long aOldNumNodes, long aNumNodes );
+
+private:
+    /**
+    * Orders two keys for a min level (IsMax false) or a max level (IsMax true)
+    * @return True if aLeft belongs above aRight on that kind of level
+    */
+    template <bool IsMax, class Store, class Key>
+    static bool precedes( const Store& aStore, const Key& aLeft, const Key& aRight );
+
+    /**
+    * Finds the child or grandchild of aIndex that belongs highest on aIndex's kind of level
+    * @param aStore The heap storage
+    * @param aIndex A parent index
+    * @param aNumNodes The number of nodes in the heap
+    * @return The index of the smallest (IsMax false) or largest (IsMax true) descendant within two levels
+    */
+    template <bool IsMax, class Store>
+    static long extremeDescendant( const Store& aStore, long aIndex, long aNumNodes );
+
+    /**
+    * Runs a MinMaxSimd kernel over the six descendants of aIndex when the Store keeps plain numeric
+    * keys in one array under std::less or std::greater. All six descendants must exist.
+    * @return The position (0-1 children, 2-5 grandchildren) of the extreme, or -1 to scan in scalar code
+    */
+    template <bool IsMax, class Store>
+    static int vectorScan( const Store& aStore, long aIndex );
+
+    template <bool IsMax, class T, class Compare>
+    static int vectorScan( const MinMaxArrayStore<T, Compare>& aStore, long aIndex );
+
+    template <bool IsMax, class K, class P, class Compare>
+    static int vectorScan( const MinMaxSplitStore<K, P, Compare>& aStore, long aIndex );
+
+    template <bool IsMax, class T, class Compare>
+    static int vectorScan( const T* aChildren, const T* aGrandchildren, std::false_type );
+
+    template <bool IsMax, class T, class Compare>
+    static int vectorScan( const T* aChildren, const T* aGrandchildren, std::true_type );
+
+    /**
+    * Asks for the next two levels below the grandchildren of aIndex while this level is scanned.
+    * Only stores with one contiguous array know where those values live.
+    */
+    template <class Store>
+    static void prefetchDescendants( const Store& aStore, long aIndex, long aNumNodes );
+
+    template <class T, class Compare>
+    static void prefetchDescendants( const MinMaxArrayStore<T, Compare>& aStore, long aIndex, long aNumNodes );
+
+    template <class K, class P, class Compare>
+    static void prefetchDescendants( const MinMaxSplitStore<K, P, Compare>& aStore, long aIndex, long aNumNodes );
+
+    /**
+    * Trickles down every parent in the subtree of aRoot, deepest level first
+    */
+    template <class Store>
+    static void buildSubtree( Store& aStore, long aRoot, long aNumNodes );
+
+    /**
+    * Reports work that the Store cannot see by itself to the store's statistics, if it keeps any
+    */
+    template <class Store>
+    static void record( const Store& aStore, MinMaxHeapStats::Counter aCounter, long aAmount );
+
+    template <class T, class Compare>
+    static void record( const MinMaxArrayStore<T, Compare>& aStore, MinMaxHeapStats::Counter aCounter, long aAmount );
+
+    /**
+    * Carries a hole from aHole down through levels of aHole's kind until aHeld fits
+    */
+    template <bool IsMax, class Store>
+    static void trickleDownLevel( Store& aStore, long aHole, typename Store::Held& aHeld, long aNumNodes );
+
+    /**
+    * Carries a hole from aHole up through grandparents until aHeld fits
+    */
+    template <bool IsMax, class Store>
+    static void bubbleUpLevel( Store& aStore, long aHole, typename Store::Held& aHeld );
+};
+
+/**
+* The Store used by containers that keep their values in one contiguous array.
+* Heap index i lives in slot i - 1 of the array.
+*/
+template <class T, class Compare>
+class MinMaxArrayStore
+{
+public:
+    typedef T Key;
+    typedef T Held;
+
+    /**
+    * @param aArray The first slot of the array
+    * @param aCompare The ordering of the values
+    * @param aStats Where comparisons and moves are counted, nullptr or ignored without MINMAXHEAP_STATS
+    */
+    MinMaxArrayStore( T* aArray, const Compare& aCompare, MinMaxHeapStats* aStats = nullptr );
+
+    const T& key( long aIndex ) const;
+    const T& keyOf( const T& aHeld ) const;
+    bool less( const T& aLeft, const T& aRight ) const;
+    T take( long aIndex );
+    void move( long aFrom, long aTo );
+    void put( long aIndex, T&& aHeld );
+    void exchange( long aIndex, T& aHeld );
+
+    /**
+    * Charges aAmount of aCounter to the statistics, does nothing without MINMAXHEAP_STATS
+    */
+    void record( MinMaxHeapStats::Counter aCounter, long aAmount ) const;
+
+private:
+    T* mArray;                  //!< The first slot of the heap array
+    const Compare& mCompare;    //!< The ordering of the values
+#if defined( MINMAXHEAP_STATS )
+    MinMaxHeapStats* mStats;    //!< Where comparisons and moves are counted, or nullptr
+#endif
+};
+
+/**
+* The Store used by containers that keep keys and payloads in two parallel arrays.
+* Heap index i lives in slot i - 1 of both. The scans only read the dense key array, and a payload
+* is only written when its value is put down, so it crosses the cache once per move.
+*/
+template <class K, class P, class Compare>
+class MinMaxSplitStore
+{
+public:
+    typedef K Key;
+    typedef std::pair<K, P> Held;
+
+    /**
+    * @param aKeys The first slot of the key array
+    * @param aPayloads The first slot of the payload array
+    * @param aCompare The ordering of the keys
+    */
+    MinMaxSplitStore( K* aKeys, P* aPayloads, const Compare& aCompare );
+
+    const K& key( long aIndex ) const;
+    const K& keyOf( const Held& aHeld ) const;
+    bool less( const K& aLeft, const K& aRight ) const;
+    Held take( long aIndex );
+    void move( long aFrom, long aTo );
+    void put( long aIndex, Held&& aHeld );
+    void exchange( long aIndex, Held& aHeld );
+
+    /**
+    * @return The payload at a heap index
+    */
+    const P& payload( long aIndex ) const;
+
+private:
+    K* mKeys;                   //!< The first slot of the key array
+    P* mPayloads;               //!< The first slot of the payload array
+    const Compare& mCompare;    //!< The ordering of the keys
+};
+
+#include "MinMaxHeapEngine.hpp"
+#endif // !MIN_MAX_HEAP_ENGINE_H
@@ -0,0 +1,592 @@
+/**
+*	@file : MinMaxHeapEngine.hpp
+*	@author :  Haaris Chaudhry
+*	@date : Mar 9, 2017
+*	Purpose: Implementation of the min-max heap sift engine.
+*/
+
+// Level l holds indices [2^l, 2^(l+1)), so the level is the position of the highest set bit.
+// Even levels are min levels, so only the parity of the leading zero count matters.
+inline bool MinMaxHeapEngine::isMinLevel( long aIndex )
+{
+#if defined( __GNUC__ )
+    return ( __builtin_clzl( static_cast<unsigned long>( aIndex ) ) & 1 ) == ( ( sizeof( long ) * 8 - 1 ) & 1 );
+#else
+    long level = 0;
+
+    while( aIndex > 1 )
+    {
+        aIndex >>= 1;
+        level++;
+    }
+
+    return ( level % 2 == 0 );
+#endif
+}
+
+// A random value bubbles up only a level or two on average, so per value insertion costs about as much
+// per key as the bottom up pass costs per node.  Rebuilding touches old and new nodes alike, so it
+// only wins once the batch is at least as large as the heap it joins (measured crossover ~1x for heaps
+// beyond the caches, ~2x for small ones), and it also bounds the cost for sorted batches.
+inline bool MinMaxHeapEngine::prefersRebuild( long aOldNumNodes, long aNumNodes )
+{
+    return ( aNumNodes - aOldNumNodes ) >= aOldNumNodes;
+}
+
+template <bool IsMax, class Store, class Key>
+bool MinMaxHeapEngine::precedes( const Store& aStore, const Key& aLeft, const Key& aRight )
+{
+    return IsMax ? aStore.less( aRight, aLeft ) : aStore.less( aLeft, aRight );
+}
+
+// The children of i are 2i and 2i+1, the grandchildren are 4i through 4i+3, both ranges are contiguous
+template <bool IsMax, class Store>
+long MinMaxHeapEngine::extremeDescendant( const Store& aStore, long aIndex, long aNumNodes )
+{
+    if( 4 * aIndex + 3 <= aNumNodes )
+    {
+        int position = vectorScan<IsMax>( aStore, aIndex );
+
+        if( position >= 0 )
+        {
+            record( aStore, MinMaxHeapStats::COMPARISONS, 5 );
+            return ( position < 2 ) ? 2 * aIndex + position : 4 * aIndex + position - 2;
+        }
+    }
+
+    long best = 2 * aIndex;
+
+    if( best + 1 <= aNumNodes && precedes<IsMax>( aStore, aStore.key( best + 1 ), aStore.key( best ) ) )
+    {
+        best = best + 1;
+    }
+
+    long lastGrandchild = 4 * aIndex + 3;
+
+    if( lastGrandchild > aNumNodes )
+    {
+        lastGrandchild = aNumNodes;
+    }
+
+    for( long i = 4 * aIndex; i <= lastGrandchild; i++ )
+    {
+        if( precedes<IsMax>( aStore, aStore.key( i ), aStore.key( best ) ) )
+        {
+            best = i;
+        }
+    }
+
+    return best;
+}
+
+// Stores without one contiguous numeric key array always take the scalar scan
+template <bool IsMax, class Store>
+int MinMaxHeapEngine::vectorScan( const Store&, long )
+{
+    return -1;
+}
+
+template <bool IsMax, class T, class Compare>
+int MinMaxHeapEngine::vectorScan( const MinMaxArrayStore<T, Compare>& aStore, long aIndex )
+{
+    typedef std::integral_constant<bool, MinMaxSimdKey<T>::kSupported && MinMaxSimdOrder<Compare>::kVectorizable> Usable;
+    return vectorScan<IsMax, T, Compare>( &aStore.key( 2 * aIndex ), &aStore.key( 4 * aIndex ), Usable() );
+}
+
+template <bool IsMax, class K, class P, class Compare>
+int MinMaxHeapEngine::vectorScan( const MinMaxSplitStore<K, P, Compare>& aStore, long aIndex )
+{
+    typedef std::integral_constant<bool, MinMaxSimdKey<K>::kSupported && MinMaxSimdOrder<Compare>::kVectorizable> Usable;
+    return vectorScan<IsMax, K, Compare>( &aStore.key( 2 * aIndex ), &aStore.key( 4 * aIndex ), Usable() );
+}
+
+template <bool IsMax, class T, class Compare>
+int MinMaxHeapEngine::vectorScan( const T*, const T*, std::false_type )
+{
+    return -1;
+}
+
+// Under std::greater the heap's minimum is the numeric maximum, so the kernel direction flips
+template <bool IsMax, class T, class Compare>
+int MinMaxHeapEngine::vectorScan( const T* aChildren, const T* aGrandchildren, std::true_type )
+{
+    return MinMaxSimd::scan<IsMax == MinMaxSimdOrder<Compare>::kAscending>( aChildren, aGrandchildren );
+}
+
+template <class Store>
+void MinMaxHeapEngine::prefetchDescendants( const Store&, long, long )
+{
+}
+
+// Whichever grandchild wins, its children are in 8i..8i+7 and its grandchildren in 16i..16i+15,
+// so the next iteration's loads are known before this one has picked its grandchild
+template <class T, class Compare>
+void MinMaxHeapEngine::prefetchDescendants( const MinMaxArrayStore<T, Compare>& aStore, long aIndex, long aNumNodes )
+{
+#if defined( __GNUC__ )
+    if( 16 * aIndex + 8 <= aNumNodes )
+    {
+        __builtin_prefetch( &aStore.key( 8 * aIndex ) );
+        __builtin_prefetch( &aStore.key( 16 * aIndex ) );
+        __builtin_prefetch( &aStore.key( 16 * aIndex + 8 ) );
+    }
+#endif
+}
+
+// Only the keys are read before the grandchild is picked, the payloads are fetched by the moves
+template <class K, class P, class Compare>
+void MinMaxHeapEngine::prefetchDescendants( const MinMaxSplitStore<K, P, Compare>& aStore, long aIndex, long aNumNodes )
+{
+#if defined( __GNUC__ )
+    if( 16 * aIndex + 8 <= aNumNodes )
+    {
+        __builtin_prefetch( &aStore.key( 8 * aIndex ) );
+        __builtin_prefetch( &aStore.key( 16 * aIndex ) );
+        __builtin_prefetch( &aStore.key( 16 * aIndex + 8 ) );
+    }
+#endif
+}
+
+template <class Store>
+void MinMaxHeapEngine::record( const Store&, MinMaxHeapStats::Counter, long )
+{
+}
+
+template <class T, class Compare>
+void MinMaxHeapEngine::record( const MinMaxArrayStore<T, Compare>& aStore, MinMaxHeapStats::Counter aCounter, long aAmount )
+{
+    aStore.record( aCounter, aAmount );
+}
+
+// The hole moves two levels at a time, so it stays on the same kind of level all the way down
+template <bool IsMax, class Store>
+void MinMaxHeapEngine::trickleDownLevel( Store& aStore, long aHole, typename Store::Held& aHeld, long aNumNodes )
+{
+    while( 2 * aHole <= aNumNodes )
+    {
+        prefetchDescendants( aStore, aHole, aNumNodes );
+        long m = extremeDescendant<IsMax>( aStore, aHole, aNumNodes );
+
+        if( !precedes<IsMax>( aStore, aStore.key( m ), aStore.keyOf( aHeld ) ) )
+        {
+            break;
+        }
+
+        aStore.move( m, aHole );
+        bool isChild = ( m < 4 * aHole );
+        aHole = m;
+        record( aStore, MinMaxHeapStats::LEVELS_DOWN, isChild ? 1 : 2 );
+        record( aStore, isChild ? MinMaxHeapStats::CHILD_PICKS : MinMaxHeapStats::GRANDCHILD_PICKS, 1 );
+
+        if( isChild )
+        {
+            break;      // A child has no descendants on our kind of level, the value settles there
+        }
+
+        // The grandchild's parent is on the opposite kind of level, aHeld has to stay on the right side of it
+        long parentIndexOfM = m >> 1;
+
+        if( precedes<IsMax>( aStore, aStore.key( parentIndexOfM ), aStore.keyOf( aHeld ) ) )
+        {
+            aStore.exchange( parentIndexOfM, aHeld );
+        }
+    }
+
+    aStore.put( aHole, std::move( aHeld ) );
+}
+
+// Grandparents are on the same kind of level, so the hole climbs two levels at a time
+template <bool IsMax, class Store>
+void MinMaxHeapEngine::bubbleUpLevel( Store& aStore, long aHole, typename Store::Held& aHeld )
+{
+    while( aHole > 3 )
+    {
+        long grandparentIndex = aHole >> 2;
+
+        if( !precedes<IsMax>( aStore, aStore.keyOf( aHeld ), aStore.key( grandparentIndex ) ) )
+        {
+            break;
+        }
+
+        aStore.move( grandparentIndex, aHole );
+        aHole = grandparentIndex;
+        record( aStore, MinMaxHeapStats::LEVELS_UP, 2 );
+    }
+
+    aStore.put( aHole, std::move( aHeld ) );
+}
+
+// Decide which half of the heap the value belongs to by comparing it with its parent,
+// the value is only taken out of its slot if it actually has to move
+template <class Store>
+void MinMaxHeapEngine::bubbleUp( Store& aStore, long aIndex )
+{
+    if( aIndex <= 1 )
+    {
+        return;
+    }
+
+    long parentIndex = aIndex >> 1;
+
+    if( isMinLevel( aIndex ) )
+    {
+        if( aStore.less( aStore.key( parentIndex ), aStore.key( aIndex ) ) )
+        {
+            typename Store::Held held = aStore.take( aIndex );
+            aStore.move( parentIndex, aIndex );
+            record( aStore, MinMaxHeapStats::LEVELS_UP, 1 );
+            bubbleUpLevel<true>( aStore, parentIndex, held );
+        }
+        else if( aIndex > 3 && aStore.less( aStore.key( aIndex ), aStore.key( aIndex >> 2 ) ) )
+        {
+            typename Store::Held held = aStore.take( aIndex );
+            bubbleUpLevel<false>( aStore, aIndex, held );
+        }
+    }
+    else
+    {
+        if( aStore.less( aStore.key( aIndex ), aStore.key( parentIndex ) ) )
+        {
+            typename Store::Held held = aStore.take( aIndex );
+            aStore.move( parentIndex, aIndex );
+            record( aStore, MinMaxHeapStats::LEVELS_UP, 1 );
+            bubbleUpLevel<false>( aStore, parentIndex, held );
+        }
+        else if( aIndex > 3 && aStore.less( aStore.key( aIndex >> 2 ), aStore.key( aIndex ) ) )
+        {
+            typename Store::Held held = aStore.take( aIndex );
+            bubbleUpLevel<true>( aStore, aIndex, held );
+        }
+    }
+}
+
+// A leaf never moves down, so leaves are left in place
+template <class Store>
+void MinMaxHeapEngine::trickleDown( Store& aStore, long aIndex, long aNumNodes )
+{
+    if( 2 * aIndex <= aNumNodes )
+    {
+        trickleDownHole( aStore, aIndex, aStore.take( aIndex ), aNumNodes );
+    }
+}
+
+template <class Store>
+void MinMaxHeapEngine::trickleDownHole( Store& aStore, long aHole, typename Store::Held&& aHeld, long aNumNodes )
+{
+    if( isMinLevel( aHole ) )
+    {
+        trickleDownLevel<false>( aStore, aHole, aHeld, aNumNodes );
+    }
+    else
+    {
+        trickleDownLevel<true>( aStore, aHole, aHeld, aNumNodes );
+    }
+}
+
+template <class Store>
+void MinMaxHeapEngine::fillMaxHole( Store& aStore, long aHole, typename Store::Held&& aHeld, long aNumNodes )
+{
+    if( aHole > 1 && aStore.less( aStore.keyOf( aHeld ), aStore.key( 1 ) ) )
+    {
+        aStore.exchange( 1, aHeld );
+    }
+
+    trickleDownHole( aStore, aHole, std::move( aHeld ), aNumNodes );
+}
+
+template <class Store>
+typename Store::Held MinMaxHeapEngine::popMin( Store& aStore, long& aNumNodes )
+{
+    typename Store::Held minValue = aStore.take( 1 );
+
+    if( aNumNodes > 1 )
+    {
+        trickleDownHole( aStore, 1, aStore.take( aNumNodes ), aNumNodes - 1 );
+    }
+
+    aNumNodes--;
+    return minValue;
+}
+
+template <class Store>
+typename Store::Held MinMaxHeapEngine::popMax( Store& aStore, long& aNumNodes )
+{
+    long hole = maxIndex( aStore, aNumNodes );
+    typename Store::Held maxValue = aStore.take( hole );
+
+    if( hole != aNumNodes )
+    {
+        trickleDownHole( aStore, hole, aStore.take( aNumNodes ), aNumNodes - 1 );
+    }
+
+    aNumNodes--;
+    return maxValue;
+}
+
+template <class Store>
+long MinMaxHeapEngine::maxIndex( const Store& aStore, long aNumNodes )
+{
+    if( aNumNodes <= 2 )
+    {
+        return aNumNodes;
+    }
+
+    return aStore.less( aStore.key( 3 ), aStore.key( 2 ) ) ? 2 : 3;
+}
+
+// bubbleUp only ever looks at ancestors, so the values appended after aIndex do not disturb it
+template <class Store>
+void MinMaxHeapEngine::heapifyAppended( Store& aStore, long aOldNumNodes, long aNumNodes )
+{
+    if( prefersRebuild( aOldNumNodes, aNumNodes ) )
+    {
+        build( aStore, aNumNodes );
+    }
+    else
+    {
+        for( long i = aOldNumNodes + 1; i <= aNumNodes; i++ )
+        {
+            bubbleUp( aStore, i );
+        }
+    }
+}
+
+template <class Store>
+void MinMaxHeapEngine::build( Store& aStore, long aNumNodes )
+{
+    for( long i = aNumNodes / 2; i >= 1; i-- )
+    {
+        trickleDown( aStore, i, aNumNodes );
+    }
+}
+
+// The subtree roots sit on one level, deep enough to give each thread several subtrees to balance the
+// load but shallow enough that every root is a parent. Workers take roots from a shared counter.
+template <class Store>
+void MinMaxHeapEngine::buildParallel( Store& aStore, long aNumNodes, long aThreads )
+{
+    if( aThreads <= 0 && aNumNodes >= kParallelBuildMinimum )
+    {
+        aThreads = static_cast<long>( std::thread::hardware_concurrency() );
+    }
+
+    if( aThreads <= 1 || aNumNodes < kParallelBuildMinimum )
+    {
+        build( aStore, aNumNodes );
+        return;
+    }
+
+    long depth = 0;
+
+    while( ( 1L << depth ) < 8 * aThreads && ( 4L << depth ) - 1 <= aNumNodes / 2 )
+    {
+        depth++;
+    }
+
+    long lastRoot = ( 2L << depth ) - 1;
+    std::atomic<long> nextRoot( 1L << depth );
+
+    auto worker = [&aStore, &nextRoot, lastRoot, aNumNodes]()
+    {
+        for( long root = nextRoot.fetch_add( 1 ); root <= lastRoot; root = nextRoot.fetch_add( 1 ) )
+        {
+            buildSubtree( aStore, root, aNumNodes );
+        }
+    };
+
+    runOnThreads( worker, aThreads );
+
+    for( long i = ( 1L << depth ) - 1; i >= 1; i-- )
+    {
+        trickleDown( aStore, i, aNumNodes );
+    }
+}
+
+// The vector is reserved up front, so a thread once constructed is always stored and joined. Failing to
+// start one (std::system_error, or std::bad_alloc for its state) only means fewer workers.
+template <class Work>
+void MinMaxHeapEngine::runOnThreads( Work& aWork, long aThreads )
+{
+    std::vector<std::thread> threads;
+
+    try
+    {
+        threads.reserve( static_cast<size_t>( aThreads - 1 ) );
+
+        for( long t = 1; t < aThreads; t++ )
+        {
+            threads.push_back( std::thread( std::ref( aWork ) ) );
+        }
+    }
+    catch( std::system_error& )
+    {
+    }
+    catch( std::bad_alloc& )
+    {
+    }
+
+    aWork();
+
+    for( size_t t = 0; t < threads.size(); t++ )
+    {
+        threads[t].join();
+    }
+}
+
+// Level k below aRoot holds the contiguous indices aRoot * 2^k through ( aRoot + 1 ) * 2^k - 1
+template <class Store>
+void MinMaxHeapEngine::buildSubtree( Store& aStore, long aRoot, long aNumNodes )
+{
+    long lastParent = aNumNodes / 2;
+    int levels = 0;
+
+    while( ( aRoot << levels ) <= lastParent )
+    {
+        levels++;
+    }
+
+    for( int level = levels - 1; level >= 0; level-- )
+    {
+        long first = aRoot << level;
+        long last = ( ( aRoot + 1 ) << level ) - 1;
+
+        for( long i = ( last < lastParent ) ? last : lastParent; i >= first; i-- )
+        {
+            trickleDown( aStore, i, aNumNodes );
+        }
+    }
+}
+
+template <class T, class Compare>
+MinMaxArrayStore<T, Compare>::MinMaxArrayStore( T* aArray, const Compare& aCompare, MinMaxHeapStats* aStats ) :
+    mArray( aArray ),
+    mCompare( aCompare )
+#if defined( MINMAXHEAP_STATS )
+    , mStats( aStats )
+#endif
+{
+    static_cast<void>( aStats );
+}
+
+template <class T, class Compare>
+const T& MinMaxArrayStore<T, Compare>::key( long aIndex ) const
+{
+    return mArray[aIndex - 1];
+}
+
+template <class T, class Compare>
+const T& MinMaxArrayStore<T, Compare>::keyOf( const T& aHeld ) const
+{
+    return aHeld;
+}
+
+template <class T, class Compare>
+bool MinMaxArrayStore<T, Compare>::less( const T& aLeft, const T& aRight ) const
+{
+    record( MinMaxHeapStats::COMPARISONS, 1 );
+    return mCompare( aLeft, aRight );
+}
+
+template <class T, class Compare>
+T MinMaxArrayStore<T, Compare>::take( long aIndex )
+{
+    record( MinMaxHeapStats::MOVES, 1 );
+    return std::move( mArray[aIndex - 1] );
+}
+
+template <class T, class Compare>
+void MinMaxArrayStore<T, Compare>::move( long aFrom, long aTo )
+{
+    record( MinMaxHeapStats::MOVES, 1 );
+    mArray[aTo - 1] = std::move( mArray[aFrom - 1] );
+}
+
+template <class T, class Compare>
+void MinMaxArrayStore<T, Compare>::put( long aIndex, T&& aHeld )
+{
+    record( MinMaxHeapStats::MOVES, 1 );
+    mArray[aIndex - 1] = std::move( aHeld );
+}
+
+// A swap is counted as three moves
+template <class T, class Compare>
+void MinMaxArrayStore<T, Compare>::exchange( long aIndex, T& aHeld )
+{
+    using std::swap;
+    record( MinMaxHeapStats::MOVES, 3 );
+    swap( mArray[aIndex - 1], aHeld );
+}
+
+template <class T, class Compare>
+void MinMaxArrayStore<T, Compare>::record( MinMaxHeapStats::Counter aCounter, long aAmount ) const
+{
+#if defined( MINMAXHEAP_STATS )
+    if( mStats != nullptr )
+    {
+        mStats->add( aCounter, aAmount );
+    }
+#else
+    static_cast<void>( aCounter );
+    static_cast<void>( aAmount );
+#endif
+}
+
+template <class K, class P, class Compare>
+MinMaxSplitStore<K, P, Compare>::MinMaxSplitStore( K* aKeys, P* aPayloads, const Compare& aCompare ) :
+    mKeys( aKeys ),
+    mPayloads( aPayloads ),
+    mCompare( aCompare )
+{
+}
+
+template <class K, class P, class Compare>
+const K& MinMaxSplitStore<K, P, Compare>::key( long aIndex ) const
+{
+    return mKeys[aIndex - 1];
+}
+
+template <class K, class P, class Compare>
+const K& MinMaxSplitStore<K, P, Compare>::keyOf( const Held& aHeld ) const
+{
+    return aHeld.first;
+}
+
+template <class K, class P, class Compare>
+bool MinMaxSplitStore<K, P, Compare>::less( const K& aLeft, const K& aRight ) const
+{
+    return mCompare( aLeft, aRight );
+}
+
+template <class K, class P, class Compare>
+typename MinMaxSplitStore<K, P, Compare>::Held MinMaxSplitStore<K, P, Compare>::take( long aIndex )
+{
+    return Held( std::move( mKeys[aIndex - 1] ), std::move( mPayloads[aIndex - 1] ) );
+}
+
+template <class K, class P, class Compare>
+void MinMaxSplitStore<K, P, Compare>::move( long aFrom, long aTo )
+{
+    mKeys[aTo - 1] = std::move( mKeys[aFrom - 1] );
+    mPayloads[aTo - 1] = std::move( mPayloads[aFrom - 1] );
+}
+
+template <class K, class P, class Compare>
+void MinMaxSplitStore<K, P, Compare>::put( long aIndex, Held&& aHeld )
+{
+    mKeys[aIndex - 1] = std::move( aHeld.first );
+    mPayloads[aIndex - 1] = std::move( aHeld.second );
+}
+
+template <class K, class P, class Compare>
+void MinMaxSplitStore<K, P, Compare>::exchange( long aIndex, Held& aHeld )
+{
+    using std::swap;
+    swap( mKeys[aIndex - 1], aHeld.first );
+    swap( mPayloads[aIndex - 1], aHeld.second );
+}
+
+template <class K, class P, class Compare>
+const P& MinMaxSplitStore<K, P, Compare>::payload( long aIndex ) const
+{
+    return mPayloads[aIndex - 1];
+}
@@ -0,0 +1,29 @@
+/**
+*	@file : MinMaxHeapLoader.h
+*	@author :  Haaris Chaudhry
+*	@date : Mar 9, 2017
+*	Purpose: Loads a text file of integers, like data.txt, into a MinMaxHeap.  The file is memory-mapped,
+*          the integers are counted so the heap array is allocated once, and then they are parsed
+*          straight into the heap array and heapified with one O(n) bottom up pass.
+*/
+
+#ifndef MIN_MAX_HEAP_LOADER_H
+#define MIN_MAX_HEAP_LOADER_H
+
+#include "IntegerScanner.h"
+#include "MappedFile.h"
+#include "MinMaxHeap.h"
+#include <string>
+
+/**
+* Adds every integer in a file to a heap. Integers are separated by anything that is not a digit,
+* and a '-' right before one makes it negative.
+* @param aPath The path of the file
+* @param aHeap The heap the integers are added to, it does not have to be empty
+* @return The number of integers that were read (throws PrecondViolatedExcep if the file cannot be read)
+*/
+template <class T, class Compare, class Allocator, class Engine>
+long loadIntegers( const std::string& aPath, MinMaxHeap<T, Compare, Allocator, Engine>& aHeap );
+
+#include "MinMaxHeapLoader.hpp"
+#endif // !MIN_MAX_HEAP_LOADER_H
@@ -0,0 +1,19 @@
+/**
+*	@file : MinMaxHeapLoader.hpp
+*	@author :  Haaris Chaudhry
+*	@date : Mar 9, 2017
+*	Purpose: Implementation of the integer file loader.
+*/
+
+// Counting is a fraction of the cost of parsing, and it saves the heap array from doubling its way up
+// (and moving every value) on a large file. Into an empty heap insertRange always rebuilds in O(n).
+template <class T, class Compare, class Allocator, class Engine>
+long loadIntegers( const std::string& aPath, MinMaxHeap<T, Compare, Allocator, Engine>& aHeap )
+{
+    MappedFile file( aPath );
+    long count = IntegerScanner<T>::count( file.begin(), file.end() );
+
+    aHeap.reserve( aHeap.size() + count );
+    aHeap.insertRange( IntegerScanner<T>( file.begin(), file.end() ), IntegerScanner<T>() );
+    return count;
+}
@@ -0,0 +1,84 @@
+/**
+*	@file : MinMaxHeapOps.h
+*	@author :  Haaris Chaudhry
+*	@date : Mar 9, 2017
+*	Purpose: The operations every double ended heap builds the same way out of its engine's sift
+*          routines: popping several values from one end, draining both ends, and replacing or
+*          push-popping an end with a single trickle down.  MinMaxHeap, MinMaxHeapView and
+*          MinMaxDaryHeap all forward to these, so each one only checks its preconditions, records
+*          its stats and destroys the slots a batch vacated.
+*
+*          Engine is any engine with the MinMaxHeapEngine interface (MinMaxHeapEngine,
+*          MinMaxIntervalEngine, MinMaxDaryEngine) and Store any Store it accepts.  None of these
+*          check that the heap is not empty, the callers do.
+*/
+
+#ifndef MIN_MAX_HEAP_OPS_H
+#define MIN_MAX_HEAP_OPS_H
+
+#include <utility>
+
+template <class Engine>
+class MinMaxHeapOps
+{
+public:
+    /**
+    * Pops up to aCount values from the minimum end, each vacated slot is left holding a moved-from
+    * value for the caller to destroy
+    * @param aStore The engine's view of the heap array
+    * @param aNumNodes The number of values in the heap, decreased by the number popped
+    * @param aOut Where the values go, smallest first
+    * @param aCount The most values to pop
+    * @return aOut, one past the last value written
+    */
+    template <class Store, class OutputIterator>
+    static OutputIterator popMinK( Store& aStore, long& aNumNodes, OutputIterator aOut, long aCount );
+
+    /**
+    * Pops up to aCount values from the maximum end, see popMinK
+    */
+    template <class Store, class OutputIterator>
+    static OutputIterator popMaxK( Store& aStore, long& aNumNodes, OutputIterator aOut, long aCount );
+
+    /**
+    * Pops every value, alternating between the two ends, see popMinK
+    * @param aLowOut Where the values from the minimum end go, ascending
+    * @param aHighOut Where the values from the maximum end go, descending
+    * @return Both iterators, one past the last value written to each
+    */
+    template <class Store, class LowOutputIterator, class HighOutputIterator>
+    static std::pair<LowOutputIterator, HighOutputIterator> drainBoth( Store& aStore, long& aNumNodes, LowOutputIterator aLowOut, HighOutputIterator aHighOut );
+
+    /**
+    * Takes the minimum and trickles aValue down from the root's hole
+    * @param aNumNodes The number of values in the heap, at least 1
+    * @return The minimum
+    */
+    template <class Store>
+    static typename Store::Held replaceMin( Store& aStore, long aNumNodes, typename Store::Held&& aValue );
+
+    /**
+    * Takes the maximum and fills its hole with aValue
+    * @param aNumNodes The number of values in the heap, at least 1
+    * @return The maximum
+    */
+    template <class Store>
+    static typename Store::Held replaceMax( Store& aStore, long aNumNodes, typename Store::Held&& aValue );
+
+    /**
+    * Inserts aValue and deletes the minimum, in one trickle down at most
+    * @param aNumNodes The number of values in the heap, may be 0
+    * @return The minimum, which is aValue itself when no value is ordered before it
+    */
+    template <class Store>
+    static typename Store::Held pushPopMin( Store& aStore, long aNumNodes, typename Store::Held&& aValue );
+
+    /**
+    * Inserts aValue and deletes the maximum, see pushPopMin
+    */
+    template <class Store>
+    static typename Store::Held pushPopMax( Store& aStore, long aNumNodes, typename Store::Held&& aValue );
+};
+
+#include "MinMaxHeapOps.hpp"
+#endif // !MIN_MAX_HEAP_OPS_H
@@ -0,0 +1,103 @@
+/**
+*	@file : MinMaxHeapOps.hpp
+*	@author :  Haaris Chaudhry
+*	@date : Mar 9, 2017
+*	Purpose: Implementation of the MinMaxHeapOps class.
+*/
+
+#include <utility>
+
+// One store serves the whole batch, the engine shrinks aNumNodes as it goes
+template <class Engine>
+template <class Store, class OutputIterator>
+OutputIterator MinMaxHeapOps<Engine>::popMinK( Store& aStore, long& aNumNodes, OutputIterator aOut, long aCount )
+{
+    long lastNumNodes = ( aCount < aNumNodes ) ? aNumNodes - aCount : 0;
+
+    while( aNumNodes > lastNumNodes )
+    {
+        *aOut = Engine::popMin( aStore, aNumNodes );
+        ++aOut;
+    }
+
+    return aOut;
+}
+
+template <class Engine>
+template <class Store, class OutputIterator>
+OutputIterator MinMaxHeapOps<Engine>::popMaxK( Store& aStore, long& aNumNodes, OutputIterator aOut, long aCount )
+{
+    long lastNumNodes = ( aCount < aNumNodes ) ? aNumNodes - aCount : 0;
+
+    while( aNumNodes > lastNumNodes )
+    {
+        *aOut = Engine::popMax( aStore, aNumNodes );
+        ++aOut;
+    }
+
+    return aOut;
+}
+
+template <class Engine>
+template <class Store, class LowOutputIterator, class HighOutputIterator>
+std::pair<LowOutputIterator, HighOutputIterator> MinMaxHeapOps<Engine>::drainBoth( Store& aStore, long& aNumNodes, LowOutputIterator aLowOut, HighOutputIterator aHighOut )
+{
+    while( aNumNodes > 0 )
+    {
+        *aLowOut = Engine::popMin( aStore, aNumNodes );
+        ++aLowOut;
+
+        if( aNumNodes > 0 )
+        {
+            *aHighOut = Engine::popMax( aStore, aNumNodes );
+            ++aHighOut;
+        }
+    }
+
+    return std::make_pair( aLowOut, aHighOut );
+}
+
+// The new value goes straight into the root's hole, any value can trickle down from a min level
+template <class Engine>
+template <class Store>
+typename Store::Held MinMaxHeapOps<Engine>::replaceMin( Store& aStore, long aNumNodes, typename Store::Held&& aValue )
+{
+    typename Store::Held minValue = aStore.take( 1 );
+    Engine::trickleDownHole( aStore, 1, std::move( aValue ), aNumNodes );
+    return minValue;
+}
+
+template <class Engine>
+template <class Store>
+typename Store::Held MinMaxHeapOps<Engine>::replaceMax( Store& aStore, long aNumNodes, typename Store::Held&& aValue )
+{
+    long maxIndex = Engine::maxIndex( aStore, aNumNodes );
+    typename Store::Held maxValue = aStore.take( maxIndex );
+    Engine::fillMaxHole( aStore, maxIndex, std::move( aValue ), aNumNodes );
+    return maxValue;
+}
+
+// A value the minimum is not ordered before would come straight back out, the heap is not touched
+template <class Engine>
+template <class Store>
+typename Store::Held MinMaxHeapOps<Engine>::pushPopMin( Store& aStore, long aNumNodes, typename Store::Held&& aValue )
+{
+    if( aNumNodes == 0 || !aStore.less( aStore.key( 1 ), aStore.keyOf( aValue ) ) )
+    {
+        return std::move( aValue );
+    }
+
+    return replaceMin( aStore, aNumNodes, std::move( aValue ) );
+}
+
+template <class Engine>
+template <class Store>
+typename Store::Held MinMaxHeapOps<Engine>::pushPopMax( Store& aStore, long aNumNodes, typename Store::Held&& aValue )
+{
+    if( aNumNodes == 0 || !aStore.less( aStore.keyOf( aValue ), aStore.key( Engine::maxIndex( aStore, aNumNodes ) ) ) )
+    {
+        return std::move( aValue );
+    }
+
+    return replaceMax( aStore, aNumNodes, std::move( aValue ) );
+}
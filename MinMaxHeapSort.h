@@ -0,0 +1,33 @@
+/**
+*	@file : MinMaxHeapSort.h
+*	@author :  Haaris Chaudhry
+*	@date : Mar 9, 2017
+*	Purpose: In-place heapsort built on the min-max heap engine.  The array is heapified in place and the
+*          maximum is repeatedly moved into the slot the shrinking heap gives up at its end.
+*/
+
+#ifndef MIN_MAX_HEAP_SORT_H
+#define MIN_MAX_HEAP_SORT_H
+
+#include "MinMaxHeapEngine.h"
+#include <functional>
+
+/**
+* Sorts an array in place, O(n log n) with no extra memory
+* @param aFirst The first value of the array
+* @param aLast One past the last value of the array
+* @param aCompare The strict weak ordering the array is sorted by (ascending under it)
+*/
+template <class T, class Compare>
+void minMaxHeapSort( T* aFirst, T* aLast, Compare aCompare );
+
+/**
+* Sorts an array in ascending order in place
+* @param aFirst The first value of the array
+* @param aLast One past the last value of the array
+*/
+template <class T>
+void minMaxHeapSort( T* aFirst, T* aLast );
+
+#include "MinMaxHeapSort.hpp"
+#endif // !MIN_MAX_HEAP_SORT_H
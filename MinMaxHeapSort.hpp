@@ -0,0 +1,35 @@
+/**
+*	@file : MinMaxHeapSort.hpp
+*	@author :  Haaris Chaudhry
+*	@date : Mar 9, 2017
+*	Purpose: Implementation of the min-max heapsort.
+*/
+
+// Each round takes the maximum out, carries the last heap value into its hole and drops the
+// maximum into the slot that just left the heap, so the sorted run grows from the end
+template <class T, class Compare>
+void minMaxHeapSort( T* aFirst, T* aLast, Compare aCompare )
+{
+    long numNodes = static_cast<long>( aLast - aFirst );
+    MinMaxArrayStore<T, Compare> heapStore( aFirst, aCompare );
+
+    MinMaxHeapEngine::build( heapStore, numNodes );
+
+    for( ; numNodes > 1; numNodes-- )
+    {
+        long maxIndex = MinMaxHeapEngine::maxIndex( heapStore, numNodes );
+
+        if( maxIndex != numNodes )
+        {
+            T maxValue = heapStore.take( maxIndex );
+            MinMaxHeapEngine::trickleDownHole( heapStore, maxIndex, heapStore.take( numNodes ), numNodes - 1 );
+            heapStore.put( numNodes, std::move( maxValue ) );
+        }
+    }
+}
+
+template <class T>
+void minMaxHeapSort( T* aFirst, T* aLast )
+{
+    minMaxHeapSort( aFirst, aLast, std::less<T>() );
+}
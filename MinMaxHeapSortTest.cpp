@@ -0,0 +1,78 @@
+/**
+*	@file : MinMaxHeapSortTest.cpp
+*	@author :  Haaris Chaudhry
+*	@date : Mar 9, 2017
+*	Purpose: Checks minMaxHeapSort against std::sort on random, duplicate heavy, sorted and empty
+*          ranges, ascending and descending.
+*/
+
+#include "MinMaxHeapSort.h"
+#include "MinMaxTest.h"
+#include <algorithm>
+#include <functional>
+#include <random>
+#include <string>
+#include <vector>
+
+namespace
+{
+    template <class T, class Compare>
+    bool sortsLikeStdSort( std::vector<T> aValues, Compare aCompare )
+    {
+        std::vector<T> expected = aValues;
+        std::sort( expected.begin(), expected.end(), aCompare );
+        minMaxHeapSort( aValues.data(), aValues.data() + aValues.size(), aCompare );
+        return aValues == expected;
+    }
+
+    std::vector<long> makeValues( std::mt19937& aRandom, long aSize, long aRange )
+    {
+        std::vector<long> values( aSize );
+
+        for( long i = 0; i < aSize; i++ )
+        {
+            values[i] = static_cast<long>( aRandom() % aRange );
+        }
+
+        return values;
+    }
+}
+
+int main()
+{
+    std::mt19937 random( 2017 );
+    const long ranges[] = { 1L << 30, 1000, 3, 1 };
+
+    for( long size = 0; size <= 300; size += ( size < 20 ) ? 1 : 37 )
+    {
+        for( size_t r = 0; r < sizeof( ranges ) / sizeof( ranges[0] ); r++ )
+        {
+            std::vector<long> values = makeValues( random, size, ranges[r] );
+            MINMAX_CHECK( sortsLikeStdSort( values, std::less<long>() ) );
+            MINMAX_CHECK( sortsLikeStdSort( values, std::greater<long>() ) );
+
+            std::sort( values.begin(), values.end() );
+            MINMAX_CHECK( sortsLikeStdSort( values, std::less<long>() ) );
+            MINMAX_CHECK( sortsLikeStdSort( values, std::greater<long>() ) );
+        }
+    }
+
+    std::vector<long> large = makeValues( random, 100000, 1L << 30 );
+    MINMAX_CHECK( sortsLikeStdSort( large, std::less<long>() ) );
+
+    std::vector<std::string> words;
+
+    for( long i = 0; i < 200; i++ )
+    {
+        words.push_back( std::to_string( random() % 50 ) );
+    }
+
+    MINMAX_CHECK( sortsLikeStdSort( words, std::less<std::string>() ) );
+    MINMAX_CHECK( sortsLikeStdSort( words, std::greater<std::string>() ) );
+
+    long none = 0;
+    minMaxHeapSort( &none, &none );
+    MINMAX_CHECK( none == 0 );
+
+    return MinMaxTest::report( "MinMaxHeapSortTest" );
+}
@@ -0,0 +1,166 @@
+/**
+*	@file : MinMaxHeapStats.h
+*	@author :  Haaris Chaudhry
+*	@date : Mar 9, 2017
+*	Purpose: Operation counters and latency histograms for the heap's hot paths.  Every public heap
+*          operation is timed, and the comparisons, element moves, levels travelled and child versus
+*          grandchild picks the engine makes are charged to the operation that caused them.
+*
+*          Instrumentation is compiled in only when MINMAXHEAP_STATS is defined.  Without it the
+*          counting hooks are empty inline functions, MinMaxHeap carries no stats member and stats()
+*          returns an all zero snapshot, so the heap is exactly as fast as before.
+*/
+
+#ifndef MIN_MAX_HEAP_STATS_H
+#define MIN_MAX_HEAP_STATS_H
+
+#if defined( MINMAXHEAP_STATS )
+#include <chrono>
+#endif
+
+class MinMaxHeapStats
+{
+public:
+    /**
+    * The operations that are measured
+    */
+    enum Operation
+    {
+        BUILD = 0,          //!< The bottom up build of a constructor
+        INSERT,
+        INSERT_RANGE,
+        DELETE_MIN,
+        DELETE_MAX,
+        POP_MIN_K,
+        POP_MAX_K,
+        DRAIN_BOTH,
+        REPLACE_MIN,
+        REPLACE_MAX,
+        PUSH_POP_MIN,
+        PUSH_POP_MAX,
+        MELD,
+        SPLIT_AT,
+        ERASE_IF,
+        OPERATION_COUNT
+    };
+
+    /**
+    * What the engine does while carrying out an operation
+    */
+    enum Counter
+    {
+        COMPARISONS = 0,    //!< Key comparisons, a vector scan of six descendants counts as five
+        MOVES,              //!< Values moved into, out of or between slots
+        LEVELS_DOWN,        //!< Levels a hole travelled down
+        LEVELS_UP,          //!< Levels a hole travelled up
+        CHILD_PICKS,        //!< Trickle down steps that settled on a child
+        GRANDCHILD_PICKS,   //!< Trickle down steps that moved to a grandchild
+        COUNTER_COUNT
+    };
+
+    /**
+    * Bucket 0 holds latencies under 1 ns, bucket b > 0 holds latencies in [2^(b-1), 2^b) ns and the
+    * last bucket everything longer
+    */
+    static const int kBuckets = 40;
+
+    /**
+    * @return True if the heap was compiled with MINMAXHEAP_STATS
+    */
+    static bool enabled();
+
+    /**
+    * An empty set of statistics
+    */
+    MinMaxHeapStats();
+
+    /**
+    * @return The number of times aOperation ran
+    */
+    long calls( Operation aOperation ) const;
+
+    /**
+    * @return The amount of aCounter charged to aOperation
+    */
+    long count( Operation aOperation, Counter aCounter ) const;
+
+    /**
+    * @return The amount of aCounter over all operations
+    */
+    long total( Counter aCounter ) const;
+
+    /**
+    * @return The number of aOperation calls whose latency fell in aBucket
+    */
+    long histogram( Operation aOperation, int aBucket ) const;
+
+    /**
+    * Estimates a latency percentile from the histogram
+    * @param aOperation The operation
+    * @param aFraction The percentile as a fraction, 0.99 for the 99th percentile
+    * @return The upper bound in ns of the bucket holding the percentile, 0 if the operation never ran
+    */
+    long percentileNanos( Operation aOperation, double aFraction ) const;
+
+    /**
+    * @return A short name for an operation or a counter, for reports
+    */
+    static const char* name( Operation aOperation );
+    static const char* name( Counter aCounter );
+
+    /**
+    * Zeroes every counter and histogram
+    */
+    void reset();
+
+    /**
+    * Starts charging counters to aOperation. Operations called from within another one (deleteMax
+    * inside pushPopMax, say) are charged to the outermost one and are not timed separately.
+    */
+    void begin( Operation aOperation );
+
+    /**
+    * Ends the operation begin started, recording its latency once the outermost one ends
+    * @param aNanos The latency of the operation
+    */
+    void end( long aNanos );
+
+    /**
+    * Charges aAmount of aCounter to the current operation
+    */
+    void add( Counter aCounter, long aAmount );
+
+private:
+    long mCalls[OPERATION_COUNT];                       //!< Calls per operation
+    long mCounters[OPERATION_COUNT][COUNTER_COUNT];     //!< Counters per operation
+    long mHistogram[OPERATION_COUNT][kBuckets];         //!< Latency buckets per operation
+    Operation mCurrent;                                 //!< The operation counters are charged to
+    int mDepth;                                         //!< How many begin calls are still open
+};
+
+/**
+* Times one heap operation from construction to destruction and charges the engine's counters to it.
+* Compiles to nothing unless MINMAXHEAP_STATS is defined.
+*/
+class MinMaxStatsScope
+{
+public:
+    /**
+    * @param aStats Where the operation is recorded, or nullptr to record nothing
+    * @param aOperation The operation being timed
+    */
+    MinMaxStatsScope( MinMaxHeapStats* aStats, MinMaxHeapStats::Operation aOperation );
+    ~MinMaxStatsScope();
+
+#if defined( MINMAXHEAP_STATS )
+private:
+    MinMaxStatsScope( const MinMaxStatsScope& );
+    MinMaxStatsScope& operator=( const MinMaxStatsScope& );
+
+    MinMaxHeapStats* mStats;                            //!< Where the operation is recorded
+    std::chrono::steady_clock::time_point mStart;       //!< When the operation started
+#endif
+};
+
+#include "MinMaxHeapStats.hpp"
+#endif // !MIN_MAX_HEAP_STATS_H
@@ -0,0 +1,188 @@
+/**
+*	@file : MinMaxHeapStats.hpp
+*	@author :  Haaris Chaudhry
+*	@date : Mar 9, 2017
+*	Purpose: Implementation of the MinMaxHeapStats class.
+*/
+
+inline bool MinMaxHeapStats::enabled()
+{
+#if defined( MINMAXHEAP_STATS )
+    return true;
+#else
+    return false;
+#endif
+}
+
+inline MinMaxHeapStats::MinMaxHeapStats()
+{
+    reset();
+}
+
+inline long MinMaxHeapStats::calls( Operation aOperation ) const
+{
+    return mCalls[aOperation];
+}
+
+inline long MinMaxHeapStats::count( Operation aOperation, Counter aCounter ) const
+{
+    return mCounters[aOperation][aCounter];
+}
+
+inline long MinMaxHeapStats::total( Counter aCounter ) const
+{
+    long sum = 0;
+
+    for( int operation = 0; operation < OPERATION_COUNT; operation++ )
+    {
+        sum += mCounters[operation][aCounter];
+    }
+
+    return sum;
+}
+
+inline long MinMaxHeapStats::histogram( Operation aOperation, int aBucket ) const
+{
+    return mHistogram[aOperation][aBucket];
+}
+
+// Walks the buckets until the running count reaches the requested share of the calls
+inline long MinMaxHeapStats::percentileNanos( Operation aOperation, double aFraction ) const
+{
+    if( mCalls[aOperation] == 0 )
+    {
+        return 0;
+    }
+
+    double target = aFraction * static_cast<double>( mCalls[aOperation] );
+    long seen = 0;
+
+    for( int bucket = 0; bucket < kBuckets; bucket++ )
+    {
+        seen += mHistogram[aOperation][bucket];
+
+        if( seen > 0 && static_cast<double>( seen ) >= target )
+        {
+            return 1L << bucket;
+        }
+    }
+
+    return 1L << ( kBuckets - 1 );
+}
+
+inline const char* MinMaxHeapStats::name( Operation aOperation )
+{
+    static const char* const names[OPERATION_COUNT] =
+    {
+        "build", "insert", "insertRange", "deleteMin", "deleteMax", "popMinK", "popMaxK",
+        "drainBoth", "replaceMin", "replaceMax", "pushPopMin", "pushPopMax",
+        "meld", "splitAt", "eraseIf"
+    };
+
+    return names[aOperation];
+}
+
+inline const char* MinMaxHeapStats::name( Counter aCounter )
+{
+    static const char* const names[COUNTER_COUNT] =
+    {
+        "comparisons", "moves", "levelsDown", "levelsUp", "childPicks", "grandchildPicks"
+    };
+
+    return names[aCounter];
+}
+
+inline void MinMaxHeapStats::reset()
+{
+    for( int operation = 0; operation < OPERATION_COUNT; operation++ )
+    {
+        mCalls[operation] = 0;
+
+        for( int counter = 0; counter < COUNTER_COUNT; counter++ )
+        {
+            mCounters[operation][counter] = 0;
+        }
+
+        for( int bucket = 0; bucket < kBuckets; bucket++ )
+        {
+            mHistogram[operation][bucket] = 0;
+        }
+    }
+
+    mCurrent = BUILD;
+    mDepth = 0;
+}
+
+inline void MinMaxHeapStats::begin( Operation aOperation )
+{
+    if( mDepth == 0 )
+    {
+        mCurrent = aOperation;
+    }
+
+    mDepth++;
+}
+
+// The bucket is the bit length of the latency, so bucket b starts at 2^(b-1) ns
+inline void MinMaxHeapStats::end( long aNanos )
+{
+    mDepth--;
+
+    if( mDepth > 0 )
+    {
+        return;
+    }
+
+    int bucket = 0;
+
+    while( aNanos > 0 && bucket < kBuckets - 1 )
+    {
+        aNanos >>= 1;
+        bucket++;
+    }
+
+    mCalls[mCurrent]++;
+    mHistogram[mCurrent][bucket]++;
+}
+
+// Work done outside a measured operation, such as peekMax finding the maximum, is not charged
+inline void MinMaxHeapStats::add( Counter aCounter, long aAmount )
+{
+    if( mDepth > 0 )
+    {
+        mCounters[mCurrent][aCounter] += aAmount;
+    }
+}
+
+#if defined( MINMAXHEAP_STATS )
+
+inline MinMaxStatsScope::MinMaxStatsScope( MinMaxHeapStats* aStats, MinMaxHeapStats::Operation aOperation ) :
+    mStats( aStats )
+{
+    if( mStats != nullptr )
+    {
+        mStats->begin( aOperation );
+        mStart = std::chrono::steady_clock::now();
+    }
+}
+
+inline MinMaxStatsScope::~MinMaxStatsScope()
+{
+    if( mStats != nullptr )
+    {
+        std::chrono::steady_clock::duration elapsed = std::chrono::steady_clock::now() - mStart;
+        mStats->end( static_cast<long>( std::chrono::duration_cast<std::chrono::nanoseconds>( elapsed ).count() ) );
+    }
+}
+
+#else
+
+inline MinMaxStatsScope::MinMaxStatsScope( MinMaxHeapStats*, MinMaxHeapStats::Operation )
+{
+}
+
+inline MinMaxStatsScope::~MinMaxStatsScope()
+{
+}
+
+#endif
@@ -0,0 +1,342 @@
+/**
+*	@file : MinMaxHeapTest.cpp
+*	@author :  Haaris Chaudhry
+*	@date : Mar 9, 2017
+*	Purpose: Checks the MinMaxHeap API against a std::multiset, under both engines: random inserts,
+*          range inserts, deletes and replaces at both ends, batch pops, melds, splits and erases, with
+*          a full drain of a copy now and then.  Melds of very uneven sizes and splits on pivots
+*          below, inside and above the values are checked on their own.  Also checks that a
+*          threaded build lays out the same array as a serial one, and that snapshots only load into
+*          a heap with the same engine.
+*/
+
+#include "MinMaxHeap.h"
+#include "MinMaxTest.h"
+#include <cstdio>
+#include <fstream>
+#include <functional>
+#include <iterator>
+#include <random>
+#include <set>
+#include <sstream>
+#include <string>
+#include <vector>
+
+namespace
+{
+    template <class Compare, class Engine>
+    struct Fixture
+    {
+        typedef MinMaxHeap<long, Compare, std::allocator<long>, Engine> Heap;
+        typedef std::multiset<long, Compare> Reference;
+    };
+
+    std::vector<long> randomValues( std::mt19937& aRandom, long aCount, long aRange )
+    {
+        std::vector<long> values( aCount );
+
+        for( long i = 0; i < aCount; i++ )
+        {
+            values[i] = static_cast<long>( aRandom() % aRange );
+        }
+
+        return values;
+    }
+
+    // Drains a copy from both ends, the two halves have to meet in the reference's order
+    template <class Heap, class Reference>
+    bool checkDrain( const MinMaxTest::Run& aRun, const Heap& aHeap, const Reference& aReference )
+    {
+        Heap copy( aHeap );
+        std::vector<long> low;
+        std::vector<long> high;
+        copy.drainBoth( std::back_inserter( low ), std::back_inserter( high ) );
+        low.insert( low.end(), high.rbegin(), high.rend() );
+        return MINMAX_CHECK_STEP( aRun, copy.isEmpty() )
+            && MINMAX_CHECK_STEP( aRun, low == std::vector<long>( aReference.begin(), aReference.end() ) );
+    }
+
+    template <class Compare, class Engine>
+    void runAgainstReference( const std::string& aName, long aRange, unsigned long aSeed )
+    {
+        typedef typename Fixture<Compare, Engine>::Heap Heap;
+        typedef typename Fixture<Compare, Engine>::Reference Reference;
+        Heap heap;
+        Reference reference;
+
+        MinMaxTest::runSteps( aName + ", range " + std::to_string( aRange ), aSeed, 4000, [&]( std::mt19937& aRandom, const MinMaxTest::Run& aRun )
+        {
+            long choice = static_cast<long>( aRandom() % 16 );
+            long value = static_cast<long>( aRandom() % aRange );
+
+            if( choice < 4 || reference.empty() )
+            {
+                heap.insert( value );
+                reference.insert( value );
+            }
+            else if( choice == 4 )
+            {
+                // Small batches are bubbled up, batches as large as the heap rebuild it
+                long count = ( aRandom() % 2 == 0 ) ? static_cast<long>( aRandom() % 4 ) : static_cast<long>( aRandom() % 300 );
+                std::vector<long> values = randomValues( aRandom, count, aRange );
+                heap.insertRange( values.begin(), values.end() );
+                reference.insert( values.begin(), values.end() );
+            }
+            else if( choice < 7 )
+            {
+                if( !MINMAX_CHECK_DELETE( aRun, heap, reference, choice == 6 ) )
+                {
+                    return;
+                }
+            }
+            else if( choice < 9 )
+            {
+                bool isMax = ( choice == 8 );
+                typename Reference::iterator end = isMax ? std::prev( reference.end() ) : reference.begin();
+                long expected = *end;
+                reference.erase( end );
+                reference.insert( value );
+
+                if( !MINMAX_CHECK_EQUAL( aRun, isMax ? heap.replaceMax( value ) : heap.replaceMin( value ), expected ) )
+                {
+                    return;
+                }
+            }
+            else if( choice < 11 )
+            {
+                // pushPop hands back the value itself when it is already beyond that end
+                bool isMax = ( choice == 10 );
+                reference.insert( value );
+                typename Reference::iterator end = isMax ? std::prev( reference.end() ) : reference.begin();
+                long expected = *end;
+                reference.erase( end );
+
+                if( !MINMAX_CHECK_EQUAL( aRun, isMax ? heap.pushPopMax( value ) : heap.pushPopMin( value ), expected ) )
+                {
+                    return;
+                }
+            }
+            else if( choice == 11 )
+            {
+                long count = static_cast<long>( aRandom() % 6 );
+                std::vector<long> popped;
+                bool isMax = ( aRandom() % 2 == 0 );
+
+                if( isMax )
+                {
+                    heap.popMaxK( std::back_inserter( popped ), count );
+                }
+                else
+                {
+                    heap.popMinK( std::back_inserter( popped ), count );
+                }
+
+                std::vector<long> expected;
+
+                for( long i = 0; i < count && !reference.empty(); i++ )
+                {
+                    typename Reference::iterator end = isMax ? std::prev( reference.end() ) : reference.begin();
+                    expected.push_back( *end );
+                    reference.erase( end );
+                }
+
+                if( !MINMAX_CHECK_STEP( aRun, popped == expected ) )
+                {
+                    return;
+                }
+            }
+            else if( choice == 12 )
+            {
+                std::vector<long> values = randomValues( aRandom, static_cast<long>( aRandom() % 300 ), aRange );
+                Heap other( 0, values.data(), static_cast<long>( values.size() ) );
+                heap.meld( other );
+                reference.insert( values.begin(), values.end() );
+
+                if( !MINMAX_CHECK_STEP( aRun, other.isEmpty() ) )
+                {
+                    return;
+                }
+            }
+            else if( choice == 13 )
+            {
+                // Either side of the split carries on, the other is checked and dropped
+                Heap upper = heap.splitAt( value );
+                Reference upperReference( reference.lower_bound( value ), reference.end() );
+                reference.erase( reference.lower_bound( value ), reference.end() );
+
+                if( !MINMAX_CHECK_ENDS( aRun, upper, upperReference ) || !checkDrain( aRun, upper, upperReference ) )
+                {
+                    return;
+                }
+
+                if( aRandom() % 2 == 0 )
+                {
+                    heap.swap( upper );
+                    reference.swap( upperReference );
+                }
+            }
+            else if( choice == 14 )
+            {
+                long modulus = 2 + static_cast<long>( aRandom() % 5 );
+                long removed = heap.eraseIf( [modulus]( long aValue ) { return aValue % modulus == 0; } );
+                long expected = 0;
+
+                for( typename Reference::iterator it = reference.begin(); it != reference.end(); )
+                {
+                    if( *it % modulus == 0 )
+                    {
+                        it = reference.erase( it );
+                        expected++;
+                    }
+                    else
+                    {
+                        ++it;
+                    }
+                }
+
+                if( !MINMAX_CHECK_EQUAL( aRun, removed, expected ) )
+                {
+                    return;
+                }
+            }
+            else if( !checkDrain( aRun, heap, reference ) )
+            {
+                return;
+            }
+
+            MINMAX_CHECK_ENDS( aRun, heap, reference );
+        } );
+    }
+
+    // One side much larger than the other, in both directions, and sides that are empty or equal
+    template <class Engine>
+    void checkSkewedMelds( std::mt19937& aRandom )
+    {
+        typedef MinMaxHeap<long, std::less<long>, std::allocator<long>, Engine> Heap;
+        const long sizes[][2] = { { 0, 1000 }, { 1000, 0 }, { 1, 1000 }, { 1000, 1 }, { 5, 5000 }, { 5000, 5 }, { 1000, 1000 }, { 999, 1000 } };
+
+        for( size_t s = 0; s < sizeof( sizes ) / sizeof( sizes[0] ); s++ )
+        {
+            std::vector<long> left = randomValues( aRandom, sizes[s][0], 50 );
+            std::vector<long> right = randomValues( aRandom, sizes[s][1], 1L << 30 );
+            Heap heap( 0, left.data(), sizes[s][0] );
+            Heap other( 0, right.data(), sizes[s][1] );
+            heap.meld( other );
+
+            std::multiset<long> reference( left.begin(), left.end() );
+            reference.insert( right.begin(), right.end() );
+            MINMAX_CHECK( other.isEmpty() && heap.size() == static_cast<long>( reference.size() ) );
+            MINMAX_CHECK( checkDrain( MinMaxTest::Run( "meld " + std::to_string( sizes[s][0] ) + " with " + std::to_string( sizes[s][1] ), 0 ), heap, reference ) );
+
+            // The emptied heap may be left on the smaller array, it still has to work
+            other.insert( 3 );
+            other.insert( 1 );
+            MINMAX_CHECK( other.peekMin() == 1 && other.peekMax() == 3 );
+        }
+    }
+
+    // Pivots below the range, at both ends of it, inside it and above it
+    template <class Engine>
+    void checkSplits( std::mt19937& aRandom )
+    {
+        typedef MinMaxHeap<long, std::less<long>, std::allocator<long>, Engine> Heap;
+        std::vector<long> values = randomValues( aRandom, 2000, 100 );
+
+        for( long i = 0; i < 2000; i++ )
+        {
+            values[i] += 100;
+        }
+
+        const long pivots[] = { -5, 50, 100, 101, 150, 199, 200, 300 };
+
+        for( size_t p = 0; p < sizeof( pivots ) / sizeof( pivots[0] ); p++ )
+        {
+            Heap lower( 0, values.data(), static_cast<long>( values.size() ) );
+            Heap upper = lower.splitAt( pivots[p] );
+            std::multiset<long> reference( values.begin(), values.end() );
+            std::multiset<long> upperReference( reference.lower_bound( pivots[p] ), reference.end() );
+            reference.erase( reference.lower_bound( pivots[p] ), reference.end() );
+
+            MinMaxTest::Run run( "split at " + std::to_string( pivots[p] ), 0 );
+            MINMAX_CHECK( checkDrain( run, lower, reference ) && checkDrain( run, upper, upperReference ) );
+
+            // Both halves carry on as heaps of their own
+            lower.insert( 150 );
+            upper.insert( 150 );
+            MINMAX_CHECK( lower.peekMax() >= 150 && upper.peekMin() <= 150 );
+        }
+    }
+
+    std::string fileBytes( const std::string& aPath )
+    {
+        std::ifstream file( aPath.c_str(), std::ios::binary );
+        std::ostringstream bytes;
+        bytes << file.rdbuf();
+        return bytes.str();
+    }
+
+    // The snapshot holds the array exactly as laid out, so equal files mean equal arrays
+    template <class Engine>
+    void checkThreadedBuild( const std::vector<long>& aValues, const std::string& aPath )
+    {
+        typedef MinMaxHeap<long, std::less<long>, std::allocator<long>, Engine> Heap;
+        long numValues = static_cast<long>( aValues.size() );
+        Heap serial( 0, aValues.data(), numValues, 1 );
+        Heap threaded( 0, aValues.data(), numValues, 4 );
+        serial.saveSnapshot( aPath );
+        std::string serialBytes = fileBytes( aPath );
+        threaded.saveSnapshot( aPath );
+        MINMAX_CHECK( serialBytes.size() > static_cast<size_t>( numValues ) && serialBytes == fileBytes( aPath ) );
+
+        std::multiset<long> reference( aValues.begin(), aValues.end() );
+        MINMAX_CHECK( checkDrain( MinMaxTest::Run( "threaded build", 0 ), threaded, reference ) );
+    }
+}
+
+int main()
+{
+    std::mt19937 random( 2017 );
+    const long ranges[] = { 1L << 30, 40, 2 };
+
+    for( size_t r = 0; r < sizeof( ranges ) / sizeof( ranges[0] ); r++ )
+    {
+        runAgainstReference<std::less<long>, MinMaxIntervalEngine>( "interval, less", ranges[r], random() );
+        runAgainstReference<std::greater<long>, MinMaxIntervalEngine>( "interval, greater", ranges[r], random() );
+        runAgainstReference<std::less<long>, MinMaxHeapEngine>( "min-max, less", ranges[r], random() );
+        runAgainstReference<std::greater<long>, MinMaxHeapEngine>( "min-max, greater", ranges[r], random() );
+    }
+
+    checkSkewedMelds<MinMaxIntervalEngine>( random );
+    checkSkewedMelds<MinMaxHeapEngine>( random );
+    checkSplits<MinMaxIntervalEngine>( random );
+    checkSplits<MinMaxHeapEngine>( random );
+
+    const std::string path = "minmaxheaptest.snapshot";
+    std::vector<long> values = randomValues( random, 2 * MinMaxHeapEngine::kParallelBuildMinimum + 3, 1L << 30 );
+    checkThreadedBuild<MinMaxIntervalEngine>( values, path );
+    checkThreadedBuild<MinMaxHeapEngine>( values, path );
+
+    // A snapshot only loads into a heap whose engine laid out the same array
+    typedef MinMaxHeap<long, std::less<long>, std::allocator<long>, MinMaxIntervalEngine> IntervalHeap;
+    IntervalHeap interval( 0, values.data(), 1000 );
+    interval.saveSnapshot( path );
+    MinMaxHeap<long> minMax;
+    MINMAX_CHECK_THROWS( minMax.loadSnapshot( path ) );
+    MINMAX_CHECK( minMax.isEmpty() );
+
+    MappedFile mapped( path, MappedFile::COPY_ON_WRITE );
+    MINMAX_CHECK_THROWS( MinMaxSnapshot::adopt<long>( mapped ) );
+
+    IntervalHeap restored;
+    restored.loadSnapshot( path );
+    MINMAX_CHECK( checkDrain( MinMaxTest::Run( "interval snapshot", 0 ), restored, std::multiset<long>( values.begin(), values.begin() + 1000 ) ) );
+    std::remove( path.c_str() );
+
+    IntervalHeap empty;
+    MINMAX_CHECK_THROWS( empty.deleteMin() );
+    MINMAX_CHECK_THROWS( empty.peekMax() );
+    MINMAX_CHECK_THROWS( empty.replaceMin( 1 ) );
+    MINMAX_CHECK( empty.pushPopMax( 7 ) == 7 && empty.isEmpty() );
+
+    return MinMaxTest::report( "MinMaxHeapTest" );
+}
@@ -0,0 +1,218 @@
+/**
+*	@file : MinMaxHeapView.h
+*	@author :  Haaris Chaudhry
+*	@date : Mar 9, 2017
+*	Purpose: A min-max heap laid over an array the caller owns.  The array is heapified in place and
+*          every heap operation works directly on it, so nothing is copied or allocated.  The view
+*          never constructs, destroys or frees the caller's values: a deleted value is moved out and
+*          its slot keeps the moved-from object, an inserted value is assigned into the next slot.
+*/
+
+#ifndef MIN_MAX_HEAP_VIEW_H
+#define MIN_MAX_HEAP_VIEW_H
+
+#include "MinMaxHeapEngine.h"
+#include "MinMaxHeapOps.h"
+#include <functional>
+#include <iterator>
+#include <utility>
+
+template <class T, class Compare = std::less<T> >
+class MinMaxHeapView
+{
+public:
+    typedef T value_type;
+    typedef Compare value_compare;
+
+    /**
+    * Constructor for the MinMaxHeapView, heapifies the first aSize values of the buffer in O(n)
+    * @param aBuffer The caller's array, slot 0 becomes the root
+    * @param aSize The number of values in the buffer that belong to the heap
+    * @param aCapacity The number of slots in the buffer, inserts may use the slots past aSize
+    * @param aCompare The strict weak ordering used to compare values
+    * @return A heap view over the buffer (throws PrecondViolatedExcep if aSize is out of range)
+    */
+    MinMaxHeapView( T* aBuffer, long aSize, long aCapacity, const Compare& aCompare = Compare() );
+
+    /**
+    * Constructor for the MinMaxHeapView, heapifies a whole array in place
+    * @param aFirst The first value of the array
+    * @param aLast One past the last value of the array
+    * @param aCompare The strict weak ordering used to compare values
+    * @return A full heap view over the array
+    */
+    MinMaxHeapView( T* aFirst, T* aLast, const Compare& aCompare = Compare() );
+
+    /**
+    * Adopts a buffer that already holds a min-max heap, such as a snapshot, without heapifying it
+    * @param aBuffer The caller's array, laid out as a min-max heap under aCompare
+    * @param aSize The number of values in the heap
+    * @param aCapacity The number of slots in the buffer
+    * @param aCompare The ordering the heap was built with
+    * @return A heap view over the buffer, O(1) (throws PrecondViolatedExcep if aSize is out of range)
+    */
+    static MinMaxHeapView adopt( T* aBuffer, long aSize, long aCapacity, const Compare& aCompare = Compare() );
+
+    /**
+    * Assigns aValue into the next free slot of the buffer and heapifies it
+    * @param aValue The value to be inserted (throws PrecondViolatedExcep if the buffer is full)
+    */
+    void insert( const T& aValue );
+
+    /**
+    * The insertion function for values that can be moved into the buffer
+    * @param aValue The value to be inserted (throws PrecondViolatedExcep if the buffer is full)
+    */
+    void insert( T&& aValue );
+
+    /**
+    * Inserts every value of a range, absorbing large batches with one bottom up pass like
+    * MinMaxHeap::insertRange. The values that fit are kept if the buffer fills up.
+    * @param aFirst The first value to insert
+    * @param aLast One past the last value to insert (throws PrecondViolatedExcep if the buffer is full)
+    */
+    template <class InputIterator>
+    void insertRange( InputIterator aFirst, InputIterator aLast );
+
+    /**
+    * Deletes the minimum value
+    * @return The value that was deleted (throws PrecondViolatedExcep if the heap is empty)
+    */
+    T deleteMin();
+
+    /**
+    * Deletes the maximum value
+    * @return The value that was deleted (throws PrecondViolatedExcep if the heap is empty)
+    */
+    T deleteMax();
+
+    /**
+    * Deletes up to aCount of the smallest values, writing them to aOut in ascending order
+    * @param aOut Where the deleted values are written
+    * @param aCount The number of values to delete, fewer are deleted if the heap runs out
+    * @return aOut advanced past the last value written
+    */
+    template <class OutputIterator>
+    OutputIterator popMinK( OutputIterator aOut, long aCount );
+
+    /**
+    * Deletes up to aCount of the largest values, writing them to aOut in descending order
+    * @param aOut Where the deleted values are written
+    * @param aCount The number of values to delete, fewer are deleted if the heap runs out
+    * @return aOut advanced past the last value written
+    */
+    template <class OutputIterator>
+    OutputIterator popMaxK( OutputIterator aOut, long aCount );
+
+    /**
+    * Empties the heap from both ends at once, see MinMaxHeap::drainBoth
+    * @param aLowOut Where the smallest values are written, in ascending order
+    * @param aHighOut Where the largest values are written, in descending order
+    * @return Both output iterators advanced past the last value written to them
+    */
+    template <class LowOutputIterator, class HighOutputIterator>
+    std::pair<LowOutputIterator, HighOutputIterator> drainBoth( LowOutputIterator aLowOut, HighOutputIterator aHighOut );
+
+    /**
+    * Reads the minimum value without removing it, O(1)
+    * @return The minimum value (throws PrecondViolatedExcep if the heap is empty)
+    */
+    const T& peekMin() const;
+
+    /**
+    * Reads the maximum value without removing it, O(1)
+    * @return The maximum value (throws PrecondViolatedExcep if the heap is empty)
+    */
+    const T& peekMax() const;
+
+    /**
+    * Deletes the minimum value and inserts aValue with a single trickle down
+    * @param aValue The value to be inserted
+    * @return The value that was deleted (throws PrecondViolatedExcep if the heap is empty)
+    */
+    T replaceMin( T aValue );
+
+    /**
+    * Deletes the maximum value and inserts aValue with a single trickle down
+    * @param aValue The value to be inserted
+    * @return The value that was deleted (throws PrecondViolatedExcep if the heap is empty)
+    */
+    T replaceMax( T aValue );
+
+    /**
+    * Inserts aValue and then deletes the minimum, works even when the buffer is full
+    * @param aValue The value to be inserted
+    * @return The smallest of aValue and the values in the heap
+    */
+    T pushPopMin( T aValue );
+
+    /**
+    * Inserts aValue and then deletes the maximum, works even when the buffer is full
+    * @param aValue The value to be inserted
+    * @return The largest of aValue and the values in the heap
+    */
+    T pushPopMax( T aValue );
+
+    /**
+    * Function that indicates if the heap is empty
+    * @return True if empty, false if not
+    */
+    bool isEmpty() const;
+
+    /**
+    * @return The number of values in the heap, they occupy slots 0 to size() - 1 of the buffer
+    */
+    long size() const;
+
+    /**
+    * @return The number of slots in the buffer
+    */
+    long capacity() const;
+
+    /**
+    * Forgets every value, the buffer itself is not touched
+    */
+    void clear();
+
+    /**
+    * @return The caller's buffer, laid out as a min-max heap
+    */
+    T* data() const;
+
+private:
+    typedef MinMaxArrayStore<T, Compare> Store;
+
+    /**
+    * Checks the size and heapifies the buffer only if aBuild is true
+    */
+    MinMaxHeapView( T* aBuffer, long aSize, long aCapacity, const Compare& aCompare, bool aBuild );
+
+    /**
+    * Assigns a value into the first free slot without heapifying
+    * @param aValue The value to be added (throws PrecondViolatedExcep if the buffer is full)
+    */
+    template <class U>
+    void append( U&& aValue );
+
+    /**
+    * Checks up front whether a range whose length is known fits in the buffer
+    */
+    template <class ForwardIterator>
+    void checkRoomFor( ForwardIterator aFirst, ForwardIterator aLast, std::forward_iterator_tag ) const;
+
+    template <class InputIterator>
+    void checkRoomFor( InputIterator aFirst, InputIterator aLast, std::input_iterator_tag ) const;
+
+    /**
+    * @return The engine's view of the buffer
+    */
+    Store store() const;
+
+    Compare mCompare;   //!< The ordering of the heap values
+    T* mBuffer;         //!< The caller's array, heap index i lives in slot i - 1
+    long mNumNodes;     //!< The number of nodes in the heap
+    long mCapacity;     //!< The number of slots in the buffer
+};
+
+#include "MinMaxHeapView.hpp"
+#endif // !MIN_MAX_HEAP_VIEW_H
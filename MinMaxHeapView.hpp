@@ -0,0 +1,263 @@
+/**
+*	@file : MinMaxHeapView.hpp
+*	@author :  Haaris Chaudhry
+*	@date : Mar 9, 2017
+*	Purpose: Implementation of the MinMaxHeapView class template.
+*/
+
+#include "PrecondViolatedExcep.h"
+#include <utility>
+
+template <class T, class Compare>
+MinMaxHeapView<T, Compare>::MinMaxHeapView( T* aBuffer, long aSize, long aCapacity, const Compare& aCompare ) :
+    MinMaxHeapView( aBuffer, aSize, aCapacity, aCompare, true )
+{
+}
+
+// The buffer is heapified where it is, from the last parent up to the root
+template <class T, class Compare>
+MinMaxHeapView<T, Compare>::MinMaxHeapView( T* aBuffer, long aSize, long aCapacity, const Compare& aCompare, bool aBuild ) :
+    mCompare( aCompare ),
+    mBuffer( aBuffer ),
+    mNumNodes( aSize ),
+    mCapacity( aCapacity )
+{
+    if( aSize < 0 || aSize > aCapacity )
+    {
+        throw PrecondViolatedExcep( "Heap view size is outside the buffer" );
+    }
+
+    if( aBuild )
+    {
+        Store heapStore = store();
+        MinMaxHeapEngine::build( heapStore, mNumNodes );
+    }
+}
+
+template <class T, class Compare>
+MinMaxHeapView<T, Compare>::MinMaxHeapView( T* aFirst, T* aLast, const Compare& aCompare ) :
+    MinMaxHeapView( aFirst, static_cast<long>( aLast - aFirst ), static_cast<long>( aLast - aFirst ), aCompare )
+{
+}
+
+template <class T, class Compare>
+MinMaxHeapView<T, Compare> MinMaxHeapView<T, Compare>::adopt( T* aBuffer, long aSize, long aCapacity, const Compare& aCompare )
+{
+    return MinMaxHeapView( aBuffer, aSize, aCapacity, aCompare, false );
+}
+
+template <class T, class Compare>
+template <class U>
+void MinMaxHeapView<T, Compare>::append( U&& aValue )
+{
+    if( mNumNodes == mCapacity )
+    {
+        throw PrecondViolatedExcep( "insert attempted on a full heap view" );
+    }
+
+    mBuffer[mNumNodes] = std::forward<U>( aValue );
+    mNumNodes++;
+}
+
+template <class T, class Compare>
+void MinMaxHeapView<T, Compare>::insert( const T& aValue )
+{
+    append( aValue );
+    Store heapStore = store();
+    MinMaxHeapEngine::bubbleUp( heapStore, mNumNodes );
+}
+
+template <class T, class Compare>
+void MinMaxHeapView<T, Compare>::insert( T&& aValue )
+{
+    append( std::move( aValue ) );
+    Store heapStore = store();
+    MinMaxHeapEngine::bubbleUp( heapStore, mNumNodes );
+}
+
+// Same as MinMaxHeap::insertRange, except that running out of room is an error instead of a reallocation
+template <class T, class Compare>
+template <class InputIterator>
+void MinMaxHeapView<T, Compare>::insertRange( InputIterator aFirst, InputIterator aLast )
+{
+    long oldNumNodes = mNumNodes;
+    checkRoomFor( aFirst, aLast, typename std::iterator_traits<InputIterator>::iterator_category() );
+
+    try
+    {
+        for( ; aFirst != aLast; ++aFirst )
+        {
+            append( *aFirst );
+        }
+    }
+    catch( ... )
+    {
+        Store heapStore = store();
+        MinMaxHeapEngine::heapifyAppended( heapStore, oldNumNodes, mNumNodes );
+        throw;
+    }
+
+    Store heapStore = store();
+    MinMaxHeapEngine::heapifyAppended( heapStore, oldNumNodes, mNumNodes );
+}
+
+template <class T, class Compare>
+template <class ForwardIterator>
+void MinMaxHeapView<T, Compare>::checkRoomFor( ForwardIterator aFirst, ForwardIterator aLast, std::forward_iterator_tag ) const
+{
+    if( static_cast<long>( std::distance( aFirst, aLast ) ) > mCapacity - mNumNodes )
+    {
+        throw PrecondViolatedExcep( "insert attempted on a full heap view" );
+    }
+}
+
+// The length of a single pass range is unknown, append reports the overflow when it happens
+template <class T, class Compare>
+template <class InputIterator>
+void MinMaxHeapView<T, Compare>::checkRoomFor( InputIterator, InputIterator, std::input_iterator_tag ) const
+{
+}
+
+template <class T, class Compare>
+T MinMaxHeapView<T, Compare>::deleteMin()
+{
+    if( isEmpty() )
+    {
+        throw PrecondViolatedExcep( "deleteMin attempted on an empty heap" );
+    }
+
+    Store heapStore = store();
+    return MinMaxHeapEngine::popMin( heapStore, mNumNodes );
+}
+
+template <class T, class Compare>
+T MinMaxHeapView<T, Compare>::deleteMax()
+{
+    if( isEmpty() )
+    {
+        throw PrecondViolatedExcep( "deleteMax attempted on an empty heap" );
+    }
+
+    Store heapStore = store();
+    return MinMaxHeapEngine::popMax( heapStore, mNumNodes );
+}
+
+template <class T, class Compare>
+template <class OutputIterator>
+OutputIterator MinMaxHeapView<T, Compare>::popMinK( OutputIterator aOut, long aCount )
+{
+    Store heapStore = store();
+    return MinMaxHeapOps<MinMaxHeapEngine>::popMinK( heapStore, mNumNodes, aOut, aCount );
+}
+
+template <class T, class Compare>
+template <class OutputIterator>
+OutputIterator MinMaxHeapView<T, Compare>::popMaxK( OutputIterator aOut, long aCount )
+{
+    Store heapStore = store();
+    return MinMaxHeapOps<MinMaxHeapEngine>::popMaxK( heapStore, mNumNodes, aOut, aCount );
+}
+
+template <class T, class Compare>
+template <class LowOutputIterator, class HighOutputIterator>
+std::pair<LowOutputIterator, HighOutputIterator> MinMaxHeapView<T, Compare>::drainBoth( LowOutputIterator aLowOut, HighOutputIterator aHighOut )
+{
+    Store heapStore = store();
+    return MinMaxHeapOps<MinMaxHeapEngine>::drainBoth( heapStore, mNumNodes, aLowOut, aHighOut );
+}
+
+template <class T, class Compare>
+const T& MinMaxHeapView<T, Compare>::peekMin() const
+{
+    if( isEmpty() )
+    {
+        throw PrecondViolatedExcep( "peekMin attempted on an empty heap" );
+    }
+
+    return mBuffer[0];
+}
+
+template <class T, class Compare>
+const T& MinMaxHeapView<T, Compare>::peekMax() const
+{
+    if( isEmpty() )
+    {
+        throw PrecondViolatedExcep( "peekMax attempted on an empty heap" );
+    }
+
+    return mBuffer[MinMaxHeapEngine::maxIndex( store(), mNumNodes ) - 1];
+}
+
+template <class T, class Compare>
+T MinMaxHeapView<T, Compare>::replaceMin( T aValue )
+{
+    if( isEmpty() )
+    {
+        throw PrecondViolatedExcep( "replaceMin attempted on an empty heap" );
+    }
+
+    Store heapStore = store();
+    return MinMaxHeapOps<MinMaxHeapEngine>::replaceMin( heapStore, mNumNodes, std::move( aValue ) );
+}
+
+template <class T, class Compare>
+T MinMaxHeapView<T, Compare>::replaceMax( T aValue )
+{
+    if( isEmpty() )
+    {
+        throw PrecondViolatedExcep( "replaceMax attempted on an empty heap" );
+    }
+
+    Store heapStore = store();
+    return MinMaxHeapOps<MinMaxHeapEngine>::replaceMax( heapStore, mNumNodes, std::move( aValue ) );
+}
+
+template <class T, class Compare>
+T MinMaxHeapView<T, Compare>::pushPopMin( T aValue )
+{
+    Store heapStore = store();
+    return MinMaxHeapOps<MinMaxHeapEngine>::pushPopMin( heapStore, mNumNodes, std::move( aValue ) );
+}
+
+template <class T, class Compare>
+T MinMaxHeapView<T, Compare>::pushPopMax( T aValue )
+{
+    Store heapStore = store();
+    return MinMaxHeapOps<MinMaxHeapEngine>::pushPopMax( heapStore, mNumNodes, std::move( aValue ) );
+}
+
+template <class T, class Compare>
+bool MinMaxHeapView<T, Compare>::isEmpty() const
+{
+    return ( mNumNodes == 0 );
+}
+
+template <class T, class Compare>
+long MinMaxHeapView<T, Compare>::size() const
+{
+    return mNumNodes;
+}
+
+template <class T, class Compare>
+long MinMaxHeapView<T, Compare>::capacity() const
+{
+    return mCapacity;
+}
+
+template <class T, class Compare>
+void MinMaxHeapView<T, Compare>::clear()
+{
+    mNumNodes = 0;
+}
+
+template <class T, class Compare>
+T* MinMaxHeapView<T, Compare>::data() const
+{
+    return mBuffer;
+}
+
+template <class T, class Compare>
+typename MinMaxHeapView<T, Compare>::Store MinMaxHeapView<T, Compare>::store() const
+{
+    return Store( mBuffer, mCompare );
+}
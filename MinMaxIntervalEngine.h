@@ -0,0 +1,139 @@
+/**
+*	@file : MinMaxIntervalEngine.h
+*	@author :  Haaris Chaudhry
+*	@date : Mar 9, 2017
+*	Purpose: The sift routines of an interval heap, a drop-in replacement for MinMaxHeapEngine (see
+*          MinMaxHeap's Engine parameter).  Every node of the tree holds two values, a low and a high,
+*          and its interval [low, high] contains the intervals of all of its descendants.  The lows
+*          form a min heap and the highs a max heap, so a deleteMin only walks the lows and compares
+*          two children per level, where a min-max heap inspects up to six descendants, and the tree
+*          is half as deep for the same number of values.
+*
+*          The values sit in the same flat array as a min-max heap's, heap indices start at 1: node k
+*          holds its low at index 2k - 1 and its high at index 2k.  When the number of values is odd
+*          the last node holds a single value, which counts as both its low and its high.  The
+*          minimum is at index 1 and the maximum at index 2.  Any MinMaxHeapEngine Store works.
+*/
+
+#ifndef MIN_MAX_INTERVAL_ENGINE_H
+#define MIN_MAX_INTERVAL_ENGINE_H
+
+#include "MinMaxHeapEngine.h"
+#include <atomic>
+#include <thread>
+#include <utility>
+#include <vector>
+
+class MinMaxIntervalEngine
+{
+public:
+    static const int kLayout = 2;           //!< Identifies the array layout in snapshots
+    static const long kValuesPerNode = 2;   //!< A low and a high
+
+    /**
+    * @return True if aIndex holds a low, false if it holds a high
+    */
+    static bool isLow( long aIndex );
+
+    /**
+    * Moves the value at aIndex, the last one in the heap, up to its proper spot
+    * @param aStore The heap storage
+    * @param aIndex The index of the value to move up the heap
+    */
+    template <class Store>
+    static void bubbleUp( Store& aStore, long aIndex );
+
+    /**
+    * Moves the value at aIndex down through the lows (aIndex is a low) or the highs (aIndex is a high)
+    * @param aStore The heap storage
+    * @param aIndex The index of the value to move
+    * @param aNumNodes The number of values in the heap
+    */
+    template <class Store>
+    static void trickleDown( Store& aStore, long aIndex, long aNumNodes );
+
+    /**
+    * Fills the hole at aHole with aHeld, moving it down through the heap to its proper spot. aHeld may
+    * fall outside the interval of aHole's node, it is then exchanged with the other end of the node.
+    * @param aStore The heap storage
+    * @param aHole The index of an empty slot
+    * @param aHeld The value that belongs somewhere in the subtree of aHole
+    * @param aNumNodes The number of values in the heap
+    */
+    template <class Store>
+    static void trickleDownHole( Store& aStore, long aHole, typename Store::Held&& aHeld, long aNumNodes );
+
+    /**
+    * Fills the hole left by the maximum with aHeld, which may be smaller than the minimum
+    */
+    template <class Store>
+    static void fillMaxHole( Store& aStore, long aHole, typename Store::Held&& aHeld, long aNumNodes );
+
+    /**
+    * Takes the minimum out and carries the last value into its hole, see MinMaxHeapEngine::popMin
+    */
+    template <class Store>
+    static typename Store::Held popMin( Store& aStore, long& aNumNodes );
+
+    /**
+    * Takes the maximum out and carries the last value into its hole
+    */
+    template <class Store>
+    static typename Store::Held popMax( Store& aStore, long& aNumNodes );
+
+    /**
+    * @return The index of the maximum, the root's high, or the root's only value when it is alone
+    */
+    template <class Store>
+    static long maxIndex( const Store& aStore, long aNumNodes );
+
+    /**
+    * Bottom up construction, trickles down the low and then the high of every node starting from the last
+    */
+    template <class Store>
+    static void build( Store& aStore, long aNumNodes );
+
+    /**
+    * Bottom up construction split over threads, see MinMaxHeapEngine::buildParallel. The result is
+    * identical to build's.
+    */
+    template <class Store>
+    static void buildParallel( Store& aStore, long aNumNodes, long aThreads );
+
+    /**
+    * Restores the heap after a batch was appended, see MinMaxHeapEngine::heapifyAppended
+    */
+    template <class Store>
+    static void heapifyAppended( Store& aStore, long aOldNumNodes, long aNumNodes );
+
+private:
+    template <bool IsMax, class Store, class Key>
+    static bool precedes( const Store& aStore, const Key& aLeft, const Key& aRight );
+
+    /**
+    * Carries a hole from aHole down through the lows (IsMax false) or the highs (IsMax true) until aHeld fits
+    */
+    template <bool IsMax, class Store>
+    static void trickleDownSide( Store& aStore, long aHole, typename Store::Held& aHeld, long aNumNodes );
+
+    /**
+    * Carries a hole from aHole up through the lows or the highs of its ancestors until aHeld fits
+    */
+    template <bool IsMax, class Store>
+    static void bubbleUpSide( Store& aStore, long aHole, typename Store::Held& aHeld );
+
+    /**
+    * Trickles down both ends of every node in the subtree of the node aRoot, deepest level first
+    */
+    template <class Store>
+    static void buildSubtree( Store& aStore, long aRoot, long aNumNodes );
+
+    /**
+    * Trickles down the low and then the high of node aNode
+    */
+    template <class Store>
+    static void buildNode( Store& aStore, long aNode, long aNumNodes );
+};
+
+#include "MinMaxIntervalEngine.hpp"
+#endif // !MIN_MAX_INTERVAL_ENGINE_H
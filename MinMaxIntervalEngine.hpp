@@ -0,0 +1,314 @@
+/**
+*	@file : MinMaxIntervalEngine.hpp
+*	@author :  Haaris Chaudhry
+*	@date : Mar 9, 2017
+*	Purpose: Implementation of the interval heap sift engine.
+*/
+
+inline bool MinMaxIntervalEngine::isLow( long aIndex )
+{
+    return ( aIndex & 1 ) != 0;
+}
+
+template <bool IsMax, class Store, class Key>
+bool MinMaxIntervalEngine::precedes( const Store& aStore, const Key& aLeft, const Key& aRight )
+{
+    return IsMax ? aStore.less( aRight, aLeft ) : aStore.less( aLeft, aRight );
+}
+
+// The lows of the two children of the low at h are 2h + 1 and 2h + 3, the highs of the two children of
+// the high at h are 2h and 2h + 2, all four in one run. A child that is the last, lone node only has the
+// low just before its high. At every node aHeld is first put on the right side of the other end.
+template <bool IsMax, class Store>
+void MinMaxIntervalEngine::trickleDownSide( Store& aStore, long aHole, typename Store::Held& aHeld, long aNumNodes )
+{
+    while( true )
+    {
+        long otherEnd = IsMax ? aHole - 1 : aHole + 1;
+
+        if( otherEnd <= aNumNodes && precedes<IsMax>( aStore, aStore.key( otherEnd ), aStore.keyOf( aHeld ) ) )
+        {
+            aStore.exchange( otherEnd, aHeld );
+        }
+
+        long m = IsMax ? 2 * aHole : 2 * aHole + 1;
+
+        if( IsMax && m > aNumNodes )
+        {
+            m--;
+        }
+
+        if( m > aNumNodes )
+        {
+            break;
+        }
+
+        long sibling = m + 2;
+
+        if( IsMax && sibling > aNumNodes )
+        {
+            sibling--;
+        }
+
+        if( sibling <= aNumNodes && precedes<IsMax>( aStore, aStore.key( sibling ), aStore.key( m ) ) )
+        {
+            m = sibling;
+        }
+
+        if( !precedes<IsMax>( aStore, aStore.key( m ), aStore.keyOf( aHeld ) ) )
+        {
+            break;
+        }
+
+        aStore.move( m, aHole );
+        aHole = m;
+
+        if( IsMax && isLow( m ) )
+        {
+            break;      // The last, lone node, aHeld already lies within its parent's interval
+        }
+    }
+
+    aStore.put( aHole, std::move( aHeld ) );
+}
+
+// The parent of node k is node k / 2, its low and high are at indices k - 1 and k when k is even
+template <bool IsMax, class Store>
+void MinMaxIntervalEngine::bubbleUpSide( Store& aStore, long aHole, typename Store::Held& aHeld )
+{
+    long node = ( aHole + 1 ) >> 1;
+
+    while( node > 1 )
+    {
+        long parentNode = node >> 1;
+        long target = IsMax ? 2 * parentNode : 2 * parentNode - 1;
+
+        if( !precedes<IsMax>( aStore, aStore.keyOf( aHeld ), aStore.key( target ) ) )
+        {
+            break;
+        }
+
+        aStore.move( target, aHole );
+        aHole = target;
+        node = parentNode;
+    }
+
+    aStore.put( aHole, std::move( aHeld ) );
+}
+
+// A new high first has to be at least its own node's low; if it is not, the two trade places and the
+// value climbs the lows. Otherwise the parent's interval decides which side it climbs, if any (a high
+// that is not below its own low cannot be below the parent's low either).
+// The value is only taken out of its slot if it actually has to move.
+template <class Store>
+void MinMaxIntervalEngine::bubbleUp( Store& aStore, long aIndex )
+{
+    if( aIndex <= 1 )
+    {
+        return;
+    }
+
+    if( !isLow( aIndex ) && aStore.less( aStore.key( aIndex ), aStore.key( aIndex - 1 ) ) )
+    {
+        typename Store::Held held = aStore.take( aIndex );
+        aStore.move( aIndex - 1, aIndex );
+        bubbleUpSide<false>( aStore, aIndex - 1, held );
+        return;
+    }
+
+    long node = ( aIndex + 1 ) >> 1;
+
+    if( node == 1 )
+    {
+        return;
+    }
+
+    long parentNode = node >> 1;
+
+    if( isLow( aIndex ) && aStore.less( aStore.key( aIndex ), aStore.key( 2 * parentNode - 1 ) ) )
+    {
+        typename Store::Held held = aStore.take( aIndex );
+        bubbleUpSide<false>( aStore, aIndex, held );
+    }
+    else if( aStore.less( aStore.key( 2 * parentNode ), aStore.key( aIndex ) ) )
+    {
+        typename Store::Held held = aStore.take( aIndex );
+        bubbleUpSide<true>( aStore, aIndex, held );
+    }
+}
+
+// A value without children whose node is in order never moves, so it is left in place
+template <class Store>
+void MinMaxIntervalEngine::trickleDown( Store& aStore, long aIndex, long aNumNodes )
+{
+    bool low = isLow( aIndex );
+    long otherEnd = low ? aIndex + 1 : aIndex - 1;
+    long firstChild = low ? 2 * aIndex + 1 : 2 * aIndex - 1;
+    bool outOfOrder = otherEnd <= aNumNodes
+        && ( low ? aStore.less( aStore.key( otherEnd ), aStore.key( aIndex ) ) : aStore.less( aStore.key( aIndex ), aStore.key( otherEnd ) ) );
+
+    if( firstChild <= aNumNodes || outOfOrder )
+    {
+        trickleDownHole( aStore, aIndex, aStore.take( aIndex ), aNumNodes );
+    }
+}
+
+template <class Store>
+void MinMaxIntervalEngine::trickleDownHole( Store& aStore, long aHole, typename Store::Held&& aHeld, long aNumNodes )
+{
+    if( isLow( aHole ) )
+    {
+        trickleDownSide<false>( aStore, aHole, aHeld, aNumNodes );
+    }
+    else
+    {
+        trickleDownSide<true>( aStore, aHole, aHeld, aNumNodes );
+    }
+}
+
+// The high side already trades places with a node's low when aHeld is below it, starting with the root's
+template <class Store>
+void MinMaxIntervalEngine::fillMaxHole( Store& aStore, long aHole, typename Store::Held&& aHeld, long aNumNodes )
+{
+    trickleDownHole( aStore, aHole, std::move( aHeld ), aNumNodes );
+}
+
+template <class Store>
+typename Store::Held MinMaxIntervalEngine::popMin( Store& aStore, long& aNumNodes )
+{
+    typename Store::Held minValue = aStore.take( 1 );
+
+    if( aNumNodes > 1 )
+    {
+        trickleDownHole( aStore, 1, aStore.take( aNumNodes ), aNumNodes - 1 );
+    }
+
+    aNumNodes--;
+    return minValue;
+}
+
+template <class Store>
+typename Store::Held MinMaxIntervalEngine::popMax( Store& aStore, long& aNumNodes )
+{
+    long hole = maxIndex( aStore, aNumNodes );
+    typename Store::Held maxValue = aStore.take( hole );
+
+    if( hole != aNumNodes )
+    {
+        trickleDownHole( aStore, hole, aStore.take( aNumNodes ), aNumNodes - 1 );
+    }
+
+    aNumNodes--;
+    return maxValue;
+}
+
+template <class Store>
+long MinMaxIntervalEngine::maxIndex( const Store&, long aNumNodes )
+{
+    return ( aNumNodes == 1 ) ? 1 : 2;
+}
+
+// bubbleUp only ever looks at the node's low and its ancestors, so the values appended after aIndex do not disturb it
+template <class Store>
+void MinMaxIntervalEngine::heapifyAppended( Store& aStore, long aOldNumNodes, long aNumNodes )
+{
+    if( MinMaxHeapEngine::prefersRebuild( aOldNumNodes, aNumNodes ) )
+    {
+        build( aStore, aNumNodes );
+    }
+    else
+    {
+        for( long i = aOldNumNodes + 1; i <= aNumNodes; i++ )
+        {
+            bubbleUp( aStore, i );
+        }
+    }
+}
+
+// Trickling the low down leaves it the smallest value of the subtree, so the high then only moves down the highs
+template <class Store>
+void MinMaxIntervalEngine::buildNode( Store& aStore, long aNode, long aNumNodes )
+{
+    trickleDown( aStore, 2 * aNode - 1, aNumNodes );
+
+    if( 2 * aNode <= aNumNodes )
+    {
+        trickleDown( aStore, 2 * aNode, aNumNodes );
+    }
+}
+
+template <class Store>
+void MinMaxIntervalEngine::build( Store& aStore, long aNumNodes )
+{
+    for( long node = ( aNumNodes + 1 ) / 2; node >= 1; node-- )
+    {
+        buildNode( aStore, node, aNumNodes );
+    }
+}
+
+// The same split as MinMaxHeapEngine::buildParallel, counted in nodes rather than values
+template <class Store>
+void MinMaxIntervalEngine::buildParallel( Store& aStore, long aNumNodes, long aThreads )
+{
+    if( aThreads <= 0 && aNumNodes >= MinMaxHeapEngine::kParallelBuildMinimum )
+    {
+        aThreads = static_cast<long>( std::thread::hardware_concurrency() );
+    }
+
+    if( aThreads <= 1 || aNumNodes < MinMaxHeapEngine::kParallelBuildMinimum )
+    {
+        build( aStore, aNumNodes );
+        return;
+    }
+
+    long lastNode = ( aNumNodes + 1 ) / 2;
+    long depth = 0;
+
+    while( ( 1L << depth ) < 8 * aThreads && ( 4L << depth ) - 1 <= lastNode / 2 )
+    {
+        depth++;
+    }
+
+    long lastRoot = ( 2L << depth ) - 1;
+    std::atomic<long> nextRoot( 1L << depth );
+
+    auto worker = [&aStore, &nextRoot, lastRoot, aNumNodes]()
+    {
+        for( long root = nextRoot.fetch_add( 1 ); root <= lastRoot; root = nextRoot.fetch_add( 1 ) )
+        {
+            buildSubtree( aStore, root, aNumNodes );
+        }
+    };
+
+    MinMaxHeapEngine::runOnThreads( worker, aThreads );
+
+    for( long node = ( 1L << depth ) - 1; node >= 1; node-- )
+    {
+        buildNode( aStore, node, aNumNodes );
+    }
+}
+
+// Level k below aRoot holds the contiguous nodes aRoot * 2^k through ( aRoot + 1 ) * 2^k - 1.
+// Leaf nodes are included, their two values may still be out of order.
+template <class Store>
+void MinMaxIntervalEngine::buildSubtree( Store& aStore, long aRoot, long aNumNodes )
+{
+    long lastNode = ( aNumNodes + 1 ) / 2;
+    int levels = 0;
+
+    while( ( aRoot << levels ) <= lastNode )
+    {
+        levels++;
+    }
+
+    for( int level = levels - 1; level >= 0; level-- )
+    {
+        long first = aRoot << level;
+        long last = ( ( aRoot + 1 ) << level ) - 1;
+
+        for( long node = ( last < lastNode ) ? last : lastNode; node >= first; node-- )
+        {
+            buildNode( aStore, node, aNumNodes );
+        }
+    }
+}
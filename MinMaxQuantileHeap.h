@@ -0,0 +1,164 @@
+/**
+*	@file : MinMaxQuantileHeap.h
+*	@author :  Haaris Chaudhry
+*	@date : Mar 9, 2017
+*	Purpose: A double ended priority queue that also keeps a fixed set of quantiles (the median by
+*          default, or any increasing list such as 0.5, 0.9 and 0.99) readable in O(1).
+*
+*          The values are split over a chain of MinMaxHeap buckets, one more than there are quantiles.
+*          Every value of a bucket is ordered before every value of the next one, and the buckets
+*          below quantile q hold exactly its nearest rank, ceil( q * size ), values.  Quantile q is
+*          then the maximum of its bucket, and the overall minimum and maximum are the extremes of
+*          the first and last buckets.  An update moves at most one value across each boundary, so it
+*          costs O( quantiles * log size ) and every value is stored once.
+*/
+
+#ifndef MIN_MAX_QUANTILE_HEAP_H
+#define MIN_MAX_QUANTILE_HEAP_H
+
+#include "MinMaxHeap.h"
+#include <functional>
+#include <memory>
+#include <vector>
+
+template <class T, class Compare = std::less<T>, class Allocator = std::allocator<T> >
+class MinMaxQuantileHeap
+{
+public:
+    typedef T value_type;
+    typedef Compare value_compare;
+    typedef Allocator allocator_type;
+
+    /**
+    * The quantiles are kept to this many parts, 0.999 and 0.9999 are distinct but 0.9999999 is 1
+    */
+    static const long kResolution = 1000000;
+
+    /**
+    * Constructor for the median mode
+    * @param aCompare The strict weak ordering used to compare values
+    * @return An empty heap that keeps the median
+    */
+    explicit MinMaxQuantileHeap( const Compare& aCompare = Compare() );
+
+    /**
+    * Constructor for the quantile mode
+    * @param aQuantiles The quantiles to keep, strictly increasing and within (0, 1]. Throws
+    *        PrecondViolatedExcep otherwise.
+    * @param aCompare The strict weak ordering used to compare values
+    * @return An empty heap that keeps every quantile in aQuantiles
+    */
+    explicit MinMaxQuantileHeap( const std::vector<double>& aQuantiles, const Compare& aCompare = Compare() );
+
+    /**
+    * The insertion function, also moves the quantile boundaries
+    * @param aValue The value to be inserted
+    */
+    void insert( const T& aValue );
+
+    void insert( T&& aValue );
+
+    /**
+    * Deletes the minimum value
+    * @return The value that was deleted (throws PrecondViolatedExcep if the heap is empty)
+    */
+    T deleteMin();
+
+    /**
+    * Deletes the maximum value
+    * @return The value that was deleted (throws PrecondViolatedExcep if the heap is empty)
+    */
+    T deleteMax();
+
+    /**
+    * Reads the minimum value without removing it
+    * @return The minimum value (throws PrecondViolatedExcep if the heap is empty)
+    */
+    const T& peekMin() const;
+
+    /**
+    * Reads the maximum value without removing it
+    * @return The maximum value (throws PrecondViolatedExcep if the heap is empty)
+    */
+    const T& peekMax() const;
+
+    /**
+    * Reads the median, the lower one for an even size, in O(1)
+    * @return The value of nearest rank ceil( size / 2 ) (throws PrecondViolatedExcep if the heap is
+    *         empty or 0.5 is not one of its quantiles)
+    */
+    const T& median() const;
+
+    /**
+    * Reads a quantile in O(1)
+    * @param aWhich The position of the quantile in the list given to the constructor
+    * @return The value of nearest rank ceil( q * size ) (throws PrecondViolatedExcep if the heap is
+    *         empty or aWhich is not within [0, numQuantiles()))
+    */
+    const T& quantile( long aWhich ) const;
+
+    /**
+    * @return The number of quantiles kept
+    */
+    long numQuantiles() const;
+
+    /**
+    * @return The quantile at position aWhich, as rounded to kResolution (throws PrecondViolatedExcep
+    *         if aWhich is not within [0, numQuantiles()))
+    */
+    double fraction( long aWhich ) const;
+
+    /**
+    * Function that indicates if the heap is empty
+    * @return True if empty, false if not
+    */
+    bool isEmpty() const;
+
+    /**
+    * @return The number of values in the heap
+    */
+    long size() const;
+
+    /**
+    * Removes every value
+    */
+    void clear();
+
+private:
+    typedef MinMaxHeap<T, Compare, Allocator> Bucket;
+
+    /**
+    * Checks and stores the quantiles and creates the buckets
+    */
+    void configure( const std::vector<double>& aQuantiles );
+
+    /**
+    * @return The number of values the buckets up to and including aWhich hold with aSize values in all
+    */
+    long rank( long aWhich, long aSize ) const;
+
+    /**
+    * @return The first bucket a value belongs in, the first one whose maximum is not ordered before it
+    */
+    long bucketFor( const T& aValue ) const;
+
+    /**
+    * Inserts into bucket aBucket and carries the maximum of every bucket that overflows into the next
+    */
+    template <class U>
+    void insertInto( long aBucket, U&& aValue );
+
+    /**
+    * Moves values between neighbouring buckets until every boundary holds its rank again
+    */
+    void rebalance();
+
+    Compare mCompare;                   //!< The ordering of the heap values
+    std::vector<long> mQuantiles;       //!< The quantiles in parts of kResolution
+    std::vector<Bucket> mBuckets;       //!< One bucket below each quantile and one above the last
+    long mMedian;                       //!< The position of 0.5 in mQuantiles, -1 if it is not kept
+    long mNumNodes;                     //!< The number of values over all buckets
+};
+
+#include "MinMaxQuantileHeap.hpp"
+#endif // !MIN_MAX_QUANTILE_HEAP_H
@@ -0,0 +1,322 @@
+/**
+*	@file : MinMaxQuantileHeap.hpp
+*	@author :  Haaris Chaudhry
+*	@date : Mar 9, 2017
+*	Purpose: Implementation of the MinMaxQuantileHeap class template.
+*/
+
+#include "PrecondViolatedExcep.h"
+#include <cmath>
+#include <utility>
+
+template <class T, class Compare, class Allocator>
+MinMaxQuantileHeap<T, Compare, Allocator>::MinMaxQuantileHeap( const Compare& aCompare ) :
+    mCompare( aCompare ),
+    mMedian( -1 ),
+    mNumNodes( 0 )
+{
+    configure( std::vector<double>( 1, 0.5 ) );
+}
+
+template <class T, class Compare, class Allocator>
+MinMaxQuantileHeap<T, Compare, Allocator>::MinMaxQuantileHeap( const std::vector<double>& aQuantiles, const Compare& aCompare ) :
+    mCompare( aCompare ),
+    mMedian( -1 ),
+    mNumNodes( 0 )
+{
+    configure( aQuantiles );
+}
+
+// The quantiles are turned into whole parts so the ranks are exact, 0.9 * 10 in doubles is just above 9
+template <class T, class Compare, class Allocator>
+void MinMaxQuantileHeap<T, Compare, Allocator>::configure( const std::vector<double>& aQuantiles )
+{
+    for( size_t i = 0; i < aQuantiles.size(); i++ )
+    {
+        long parts = static_cast<long>( std::floor( aQuantiles[i] * kResolution + 0.5 ) );
+
+        if( !( aQuantiles[i] > 0.0 ) || parts <= 0 || parts > kResolution || ( !mQuantiles.empty() && parts <= mQuantiles.back() ) )
+        {
+            throw PrecondViolatedExcep( "Quantiles have to be increasing and within (0, 1]" );
+        }
+
+        if( 2 * parts == kResolution )
+        {
+            mMedian = static_cast<long>( i );
+        }
+
+        mQuantiles.push_back( parts );
+    }
+
+    if( mQuantiles.empty() )
+    {
+        throw PrecondViolatedExcep( "Quantiles have to be increasing and within (0, 1]" );
+    }
+
+    mBuckets.assign( mQuantiles.size() + 1, Bucket( 0, mCompare ) );
+}
+
+template <class T, class Compare, class Allocator>
+long MinMaxQuantileHeap<T, Compare, Allocator>::rank( long aWhich, long aSize ) const
+{
+    return ( mQuantiles[aWhich] * aSize + kResolution - 1 ) / kResolution;
+}
+
+template <class T, class Compare, class Allocator>
+long MinMaxQuantileHeap<T, Compare, Allocator>::bucketFor( const T& aValue ) const
+{
+    long last = static_cast<long>( mQuantiles.size() );
+
+    for( long i = 0; i < last; i++ )
+    {
+        if( !mBuckets[i].isEmpty() && !mCompare( mBuckets[i].peekMax(), aValue ) )
+        {
+            return i;
+        }
+    }
+
+    return last;
+}
+
+// A bucket below the new value only has to grow when its rank went up, which rebalance handles by
+// pulling the smallest value from above. At and above the new value's bucket each boundary that
+// would now hold one value too many passes its maximum on, through pushPopMax.
+template <class T, class Compare, class Allocator>
+template <class U>
+void MinMaxQuantileHeap<T, Compare, Allocator>::insertInto( long aBucket, U&& aValue )
+{
+    long last = static_cast<long>( mQuantiles.size() );
+    long below = 0;
+
+    for( long i = 0; i < aBucket; i++ )
+    {
+        below += mBuckets[i].size();
+    }
+
+    mNumNodes++;
+    long held = aBucket;
+
+    for( ; held < last; held++ )
+    {
+        below += mBuckets[held].size();
+
+        if( below + 1 <= rank( held, mNumNodes ) )
+        {
+            break;
+        }
+    }
+
+    if( held == aBucket )
+    {
+        mBuckets[aBucket].insert( std::forward<U>( aValue ) );
+    }
+    else
+    {
+        T carried = mBuckets[aBucket].pushPopMax( std::forward<U>( aValue ) );
+
+        for( long i = aBucket + 1; i < held; i++ )
+        {
+            carried = mBuckets[i].pushPopMax( std::move( carried ) );
+        }
+
+        mBuckets[held].insert( std::move( carried ) );
+    }
+
+    rebalance();
+}
+
+template <class T, class Compare, class Allocator>
+void MinMaxQuantileHeap<T, Compare, Allocator>::rebalance()
+{
+    long last = static_cast<long>( mQuantiles.size() );
+    long below = 0;
+
+    for( long i = 0; i < last; i++ )
+    {
+        below += mBuckets[i].size();
+        long target = rank( i, mNumNodes );
+
+        for( ; below > target; below-- )
+        {
+            mBuckets[i + 1].insert( mBuckets[i].deleteMax() );
+        }
+
+        // The next bucket can be empty when two quantiles share a rank, the value comes from the
+        // first bucket above that is not
+        for( ; below < target; below++ )
+        {
+            long from = i + 1;
+
+            while( mBuckets[from].isEmpty() )
+            {
+                from++;
+            }
+
+            mBuckets[i].insert( mBuckets[from].deleteMin() );
+        }
+    }
+}
+
+template <class T, class Compare, class Allocator>
+void MinMaxQuantileHeap<T, Compare, Allocator>::insert( const T& aValue )
+{
+    insertInto( bucketFor( aValue ), aValue );
+}
+
+template <class T, class Compare, class Allocator>
+void MinMaxQuantileHeap<T, Compare, Allocator>::insert( T&& aValue )
+{
+    insertInto( bucketFor( aValue ), std::move( aValue ) );
+}
+
+template <class T, class Compare, class Allocator>
+T MinMaxQuantileHeap<T, Compare, Allocator>::deleteMin()
+{
+    if( isEmpty() )
+    {
+        throw PrecondViolatedExcep( "deleteMin attempted on an empty heap" );
+    }
+
+    long first = 0;
+
+    while( mBuckets[first].isEmpty() )
+    {
+        first++;
+    }
+
+    T minValue = mBuckets[first].deleteMin();
+    mNumNodes--;
+    rebalance();
+    return minValue;
+}
+
+template <class T, class Compare, class Allocator>
+T MinMaxQuantileHeap<T, Compare, Allocator>::deleteMax()
+{
+    if( isEmpty() )
+    {
+        throw PrecondViolatedExcep( "deleteMax attempted on an empty heap" );
+    }
+
+    long last = static_cast<long>( mBuckets.size() ) - 1;
+
+    while( mBuckets[last].isEmpty() )
+    {
+        last--;
+    }
+
+    T maxValue = mBuckets[last].deleteMax();
+    mNumNodes--;
+    rebalance();
+    return maxValue;
+}
+
+template <class T, class Compare, class Allocator>
+const T& MinMaxQuantileHeap<T, Compare, Allocator>::peekMin() const
+{
+    if( isEmpty() )
+    {
+        throw PrecondViolatedExcep( "peekMin attempted on an empty heap" );
+    }
+
+    long first = 0;
+
+    while( mBuckets[first].isEmpty() )
+    {
+        first++;
+    }
+
+    return mBuckets[first].peekMin();
+}
+
+template <class T, class Compare, class Allocator>
+const T& MinMaxQuantileHeap<T, Compare, Allocator>::peekMax() const
+{
+    if( isEmpty() )
+    {
+        throw PrecondViolatedExcep( "peekMax attempted on an empty heap" );
+    }
+
+    long last = static_cast<long>( mBuckets.size() ) - 1;
+
+    while( mBuckets[last].isEmpty() )
+    {
+        last--;
+    }
+
+    return mBuckets[last].peekMax();
+}
+
+template <class T, class Compare, class Allocator>
+const T& MinMaxQuantileHeap<T, Compare, Allocator>::median() const
+{
+    if( mMedian < 0 )
+    {
+        throw PrecondViolatedExcep( "median attempted on a heap that does not keep 0.5" );
+    }
+
+    return quantile( mMedian );
+}
+
+// A bucket is only empty when its quantile shares its rank with the one below, which then has the
+// same value
+template <class T, class Compare, class Allocator>
+const T& MinMaxQuantileHeap<T, Compare, Allocator>::quantile( long aWhich ) const
+{
+    if( aWhich < 0 || aWhich >= numQuantiles() )
+    {
+        throw PrecondViolatedExcep( "quantile attempted with a position outside the quantiles" );
+    }
+
+    if( isEmpty() )
+    {
+        throw PrecondViolatedExcep( "quantile attempted on an empty heap" );
+    }
+
+    while( mBuckets[aWhich].isEmpty() )
+    {
+        aWhich--;
+    }
+
+    return mBuckets[aWhich].peekMax();
+}
+
+template <class T, class Compare, class Allocator>
+long MinMaxQuantileHeap<T, Compare, Allocator>::numQuantiles() const
+{
+    return static_cast<long>( mQuantiles.size() );
+}
+
+template <class T, class Compare, class Allocator>
+double MinMaxQuantileHeap<T, Compare, Allocator>::fraction( long aWhich ) const
+{
+    if( aWhich < 0 || aWhich >= numQuantiles() )
+    {
+        throw PrecondViolatedExcep( "fraction attempted with a position outside the quantiles" );
+    }
+
+    return static_cast<double>( mQuantiles[aWhich] ) / kResolution;
+}
+
+template <class T, class Compare, class Allocator>
+bool MinMaxQuantileHeap<T, Compare, Allocator>::isEmpty() const
+{
+    return ( mNumNodes == 0 );
+}
+
+template <class T, class Compare, class Allocator>
+long MinMaxQuantileHeap<T, Compare, Allocator>::size() const
+{
+    return mNumNodes;
+}
+
+template <class T, class Compare, class Allocator>
+void MinMaxQuantileHeap<T, Compare, Allocator>::clear()
+{
+    for( size_t i = 0; i < mBuckets.size(); i++ )
+    {
+        mBuckets[i].clear();
+    }
+
+    mNumNodes = 0;
+}
@@ -0,0 +1,125 @@
+/**
+*	@file : MinMaxQuantileHeapTest.cpp
+*	@author :  Haaris Chaudhry
+*	@date : Mar 9, 2017
+*	Purpose: Checks MinMaxQuantileHeap's quantiles, median and both ends against a std::multiset
+*          through random inserts and deletes from both ends.
+*/
+
+#include "MinMaxQuantileHeap.h"
+#include "MinMaxTest.h"
+#include <algorithm>
+#include <functional>
+#include <random>
+#include <set>
+#include <sstream>
+#include <vector>
+
+namespace
+{
+    // The nearest rank ceil( q * size ), counted in the same parts as the heap
+    template <class Heap>
+    long expectedRank( const Heap& aHeap, long aWhich, long aSize )
+    {
+        long parts = static_cast<long>( aHeap.fraction( aWhich ) * Heap::kResolution + 0.5 );
+        return ( parts * aSize + Heap::kResolution - 1 ) / Heap::kResolution;
+    }
+
+    // Stops at the first quantile that does not match
+    template <class Compare>
+    void checkQuantiles( const MinMaxTest::Run& aRun, const MinMaxQuantileHeap<long, Compare>& aHeap, const std::multiset<long, Compare>& aReference )
+    {
+        if( !MINMAX_CHECK_ENDS( aRun, aHeap, aReference ) || aReference.empty() )
+        {
+            return;
+        }
+
+        std::vector<long> sorted( aReference.begin(), aReference.end() );
+
+        for( long i = 0; i < aHeap.numQuantiles(); i++ )
+        {
+            if( !MINMAX_CHECK_EQUAL( aRun, aHeap.quantile( i ), sorted[expectedRank( aHeap, i, aHeap.size() ) - 1] ) )
+            {
+                return;
+            }
+        }
+    }
+
+    template <class Compare>
+    void runAgainstReference( const std::vector<double>& aQuantiles, long aRange, unsigned long aSeed, const char* aOrder )
+    {
+        MinMaxQuantileHeap<long, Compare> heap( aQuantiles );
+        std::multiset<long, Compare> reference;
+        std::ostringstream name;
+        name << aQuantiles.size() << " quantiles from " << aQuantiles.front() << ", " << aOrder << ", range " << aRange;
+
+        MinMaxTest::runSteps( name.str(), aSeed, 4000, [&]( std::mt19937& aRandom, const MinMaxTest::Run& aRun )
+        {
+            long choice = static_cast<long>( aRandom() % 10 );
+
+            if( choice < 6 || reference.empty() )
+            {
+                long value = static_cast<long>( aRandom() % aRange );
+                heap.insert( value );
+                reference.insert( value );
+            }
+            else if( !MINMAX_CHECK_DELETE( aRun, heap, reference, choice >= 8 ) )
+            {
+                return;
+            }
+
+            checkQuantiles( aRun, heap, reference );
+        } );
+    }
+}
+
+int main()
+{
+    std::mt19937 random( 2017 );
+    const long ranges[] = { 1L << 30, 50, 2 };
+
+    std::vector<std::vector<double> > quantileSets;
+    quantileSets.push_back( std::vector<double>( 1, 0.5 ) );
+    quantileSets.push_back( { 0.5, 0.9, 0.99 } );
+    quantileSets.push_back( { 0.001, 0.25, 0.5, 0.75, 1.0 } );
+    quantileSets.push_back( { 0.1, 0.100001 } );
+
+    for( size_t q = 0; q < quantileSets.size(); q++ )
+    {
+        for( size_t r = 0; r < sizeof( ranges ) / sizeof( ranges[0] ); r++ )
+        {
+            runAgainstReference<std::less<long> >( quantileSets[q], ranges[r], random(), "less" );
+            runAgainstReference<std::greater<long> >( quantileSets[q], ranges[r], random(), "greater" );
+        }
+    }
+
+    MinMaxQuantileHeap<long> medians;
+    std::vector<long> values;
+
+    for( long i = 0; i < 101; i++ )
+    {
+        long value = static_cast<long>( random() % 1000 );
+        medians.insert( value );
+        values.push_back( value );
+        std::sort( values.begin(), values.end() );
+        MINMAX_CHECK( medians.median() == values[( values.size() + 1 ) / 2 - 1] );
+    }
+
+    MinMaxQuantileHeap<long> tails( { 0.5, 0.9 } );
+    MINMAX_CHECK_THROWS( tails.median() );
+    MINMAX_CHECK_THROWS( tails.quantile( 0 ) );
+    tails.insert( 1 );
+    MINMAX_CHECK( tails.quantile( 1 ) == 1 );
+    MINMAX_CHECK_THROWS( tails.quantile( -1 ) );
+    MINMAX_CHECK_THROWS( tails.quantile( 2 ) );
+    MINMAX_CHECK_THROWS( tails.fraction( 2 ) );
+    MINMAX_CHECK_THROWS( MinMaxQuantileHeap<long>( { 0.9, 0.5 } ) );
+    MINMAX_CHECK_THROWS( MinMaxQuantileHeap<long>( { 0.0 } ) );
+    MINMAX_CHECK_THROWS( MinMaxQuantileHeap<long>( std::vector<double>() ) );
+
+    tails.clear();
+    MINMAX_CHECK( tails.isEmpty() );
+    MINMAX_CHECK_THROWS( tails.deleteMin() );
+
+    return MinMaxTest::report( "MinMaxQuantileHeapTest" );
+}
@@ -0,0 +1,120 @@
+/**
+*	@file : MinMaxSimd.h
+*	@author :  Haaris Chaudhry
+*	@date : Mar 9, 2017
+*	Purpose: Vector kernels that find the smallest or largest of a node's six descendants (children 2i..2i+1
+*          and grandchildren 4i..4i+3) in a handful of instructions.  Both groups are contiguous in the
+*          heap array, so they are loaded directly without gathering them into a scratch array.
+*          The kernels stay within 128 bit registers: six values need a three step reduction either way,
+*          and the 256 bit lane-crossing extract and broadcast only add latency to the dependent
+*          trickle-down loop.  SSE4.2 (for the 64 bit compare) is detected at runtime, doubles only need
+*          the SSE2 baseline, and anything else falls back to the engine's scalar scan.
+*          Define MINMAXHEAP_NO_SIMD to compile the kernels out.
+*/
+
+#ifndef MIN_MAX_SIMD_H
+#define MIN_MAX_SIMD_H
+
+#include <functional>
+
+#if !defined( MINMAXHEAP_NO_SIMD ) && defined( __GNUC__ ) && defined( __x86_64__ )
+#define MINMAXHEAP_HAVE_SIMD 1
+#include <immintrin.h>
+#endif
+
+class MinMaxSimd
+{
+public:
+    /**
+    * The best instruction set the current processor supports, detected once
+    */
+    enum Level
+    {
+        SCALAR = 0,
+        SSE42 = 1
+    };
+
+    /**
+    * @return The instruction set the kernels will use
+    */
+    static Level level();
+
+    /**
+    * Finds the extreme among the six descendants of a node. All six must exist.
+    * The first of several equal values wins, in the order children then grandchildren.
+    * @param aChildren The two children of the node
+    * @param aGrandchildren The four grandchildren of the node
+    * @return The position (0-1 children, 2-5 grandchildren) of the smallest (IsMax false) or
+    *         largest (IsMax true) value, or -1 if no kernel applies and the caller should scan itself
+    */
+    template <bool IsMax>
+    static int scan( const long* aChildren, const long* aGrandchildren );
+
+    template <bool IsMax>
+    static int scan( const long long* aChildren, const long long* aGrandchildren );
+
+    template <bool IsMax>
+    static int scan( const int* aChildren, const int* aGrandchildren );
+
+    template <bool IsMax>
+    static int scan( const double* aChildren, const double* aGrandchildren );
+
+private:
+#if defined( MINMAXHEAP_HAVE_SIMD )
+    static Level detect();
+
+    template <bool IsMax>
+    static __m128i pickInt64( __m128i aLeft, __m128i aRight );
+
+    template <bool IsMax>
+    static int scanInt64Sse42( const long long* aChildren, const long long* aGrandchildren );
+
+    template <bool IsMax>
+    static int scanInt32Sse42( const int* aChildren, const int* aGrandchildren );
+
+    template <bool IsMax>
+    static int scanDoubleSse2( const double* aChildren, const double* aGrandchildren );
+#endif
+};
+
+/**
+* Tells the engine whether a comparator orders keys like the vector kernels do.
+* Ascending is true for std::less (the heap minimum is the numeric minimum) and false for std::greater.
+*/
+template <class Compare>
+struct MinMaxSimdOrder
+{
+    static const bool kVectorizable = false;
+    static const bool kAscending = true;
+};
+
+template <class T>
+struct MinMaxSimdOrder< std::less<T> >
+{
+    static const bool kVectorizable = true;
+    static const bool kAscending = true;
+};
+
+template <class T>
+struct MinMaxSimdOrder< std::greater<T> >
+{
+    static const bool kVectorizable = true;
+    static const bool kAscending = false;
+};
+
+/**
+* Tells the engine whether MinMaxSimd has kernels for a key type
+*/
+template <class T>
+struct MinMaxSimdKey
+{
+    static const bool kSupported = false;
+};
+
+template <> struct MinMaxSimdKey<long> { static const bool kSupported = true; };
+template <> struct MinMaxSimdKey<long long> { static const bool kSupported = true; };
+template <> struct MinMaxSimdKey<int> { static const bool kSupported = true; };
+template <> struct MinMaxSimdKey<double> { static const bool kSupported = true; };
+
+#include "MinMaxSimd.hpp"
+#endif // !MIN_MAX_SIMD_H
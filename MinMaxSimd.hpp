@@ -0,0 +1,163 @@
+/**
+*	@file : MinMaxSimd.hpp
+*	@author :  Haaris Chaudhry
+*	@date : Mar 9, 2017
+*	Purpose: Implementation of the descendant scan kernels.
+*
+*          Every kernel works the same way: reduce the six values to the extreme with vector min/max,
+*          broadcast it, compare it against both groups for equality and take the lowest set bit of the
+*          combined mask.  That keeps the "first equal value wins" rule of the scalar scan.
+*/
+
+#if defined( MINMAXHEAP_HAVE_SIMD )
+
+// Ask the processor once, every later call reads the cached answer
+inline MinMaxSimd::Level MinMaxSimd::detect()
+{
+    __builtin_cpu_init();
+
+    if( __builtin_cpu_supports( "sse4.2" ) )
+    {
+        return SSE42;
+    }
+
+    return SCALAR;
+}
+
+inline MinMaxSimd::Level MinMaxSimd::level()
+{
+    static const Level sLevel = detect();
+    return sLevel;
+}
+
+// There is no 64 bit min/max instruction below AVX-512, so pick with a signed compare and a blend
+template <bool IsMax>
+__attribute__( ( target( "sse4.2" ) ) ) inline __m128i MinMaxSimd::pickInt64( __m128i aLeft, __m128i aRight )
+{
+    __m128i leftGreater = _mm_cmpgt_epi64( aLeft, aRight );
+    return IsMax ? _mm_blendv_epi8( aRight, aLeft, leftGreater ) : _mm_blendv_epi8( aLeft, aRight, leftGreater );
+}
+
+template <bool IsMax>
+__attribute__( ( target( "sse4.2" ) ) ) int MinMaxSimd::scanInt64Sse42( const long long* aChildren, const long long* aGrandchildren )
+{
+    __m128i children = _mm_loadu_si128( reinterpret_cast<const __m128i*>( aChildren ) );
+    __m128i grandchildrenLow = _mm_loadu_si128( reinterpret_cast<const __m128i*>( aGrandchildren ) );
+    __m128i grandchildrenHigh = _mm_loadu_si128( reinterpret_cast<const __m128i*>( aGrandchildren + 2 ) );
+
+    __m128i best = pickInt64<IsMax>( pickInt64<IsMax>( grandchildrenLow, grandchildrenHigh ), children );
+    best = pickInt64<IsMax>( best, _mm_shuffle_epi32( best, _MM_SHUFFLE( 1, 0, 3, 2 ) ) );
+
+    int mask = _mm_movemask_pd( _mm_castsi128_pd( _mm_cmpeq_epi64( children, best ) ) )
+        | ( _mm_movemask_pd( _mm_castsi128_pd( _mm_cmpeq_epi64( grandchildrenLow, best ) ) ) << 2 )
+        | ( _mm_movemask_pd( _mm_castsi128_pd( _mm_cmpeq_epi64( grandchildrenHigh, best ) ) ) << 4 );
+
+    return __builtin_ctz( mask );
+}
+
+// The two children only fill half a register, so they are duplicated into the upper lanes
+template <bool IsMax>
+__attribute__( ( target( "sse4.2" ) ) ) int MinMaxSimd::scanInt32Sse42( const int* aChildren, const int* aGrandchildren )
+{
+    __m128i children = _mm_loadl_epi64( reinterpret_cast<const __m128i*>( aChildren ) );
+    children = _mm_shuffle_epi32( children, _MM_SHUFFLE( 1, 0, 1, 0 ) );
+    __m128i grandchildren = _mm_loadu_si128( reinterpret_cast<const __m128i*>( aGrandchildren ) );
+
+    __m128i best = IsMax ? _mm_max_epi32( grandchildren, children ) : _mm_min_epi32( grandchildren, children );
+    __m128i swapped = _mm_shuffle_epi32( best, _MM_SHUFFLE( 1, 0, 3, 2 ) );
+    best = IsMax ? _mm_max_epi32( best, swapped ) : _mm_min_epi32( best, swapped );
+    swapped = _mm_shuffle_epi32( best, _MM_SHUFFLE( 2, 3, 0, 1 ) );
+    best = IsMax ? _mm_max_epi32( best, swapped ) : _mm_min_epi32( best, swapped );
+
+    int childMask = _mm_movemask_ps( _mm_castsi128_ps( _mm_cmpeq_epi32( children, best ) ) ) & 3;
+    int grandchildMask = _mm_movemask_ps( _mm_castsi128_ps( _mm_cmpeq_epi32( grandchildren, best ) ) );
+
+    return __builtin_ctz( childMask | ( grandchildMask << 2 ) );
+}
+
+// SSE2 is part of x86-64, so this kernel needs no runtime check.
+// A NaN makes min/max and the equality compare disagree, the mask is then empty and the scalar scan decides
+template <bool IsMax>
+int MinMaxSimd::scanDoubleSse2( const double* aChildren, const double* aGrandchildren )
+{
+    __m128d children = _mm_loadu_pd( aChildren );
+    __m128d low = _mm_loadu_pd( aGrandchildren );
+    __m128d high = _mm_loadu_pd( aGrandchildren + 2 );
+
+    __m128d best = IsMax ? _mm_max_pd( _mm_max_pd( low, high ), children ) : _mm_min_pd( _mm_min_pd( low, high ), children );
+    __m128d swapped = _mm_shuffle_pd( best, best, 1 );
+    best = IsMax ? _mm_max_pd( best, swapped ) : _mm_min_pd( best, swapped );
+
+    int mask = _mm_movemask_pd( _mm_cmpeq_pd( children, best ) )
+        | ( _mm_movemask_pd( _mm_cmpeq_pd( low, best ) ) << 2 )
+        | ( _mm_movemask_pd( _mm_cmpeq_pd( high, best ) ) << 4 );
+
+    return ( mask != 0 ) ? __builtin_ctz( mask ) : -1;
+}
+
+template <bool IsMax>
+inline int MinMaxSimd::scan( const long long* aChildren, const long long* aGrandchildren )
+{
+    if( level() >= SSE42 )
+    {
+        return scanInt64Sse42<IsMax>( aChildren, aGrandchildren );
+    }
+
+    return -1;
+}
+
+template <bool IsMax>
+inline int MinMaxSimd::scan( const int* aChildren, const int* aGrandchildren )
+{
+    if( level() >= SSE42 )
+    {
+        return scanInt32Sse42<IsMax>( aChildren, aGrandchildren );
+    }
+
+    return -1;
+}
+
+template <bool IsMax>
+inline int MinMaxSimd::scan( const double* aChildren, const double* aGrandchildren )
+{
+    return scanDoubleSse2<IsMax>( aChildren, aGrandchildren );
+}
+
+#else
+
+inline MinMaxSimd::Level MinMaxSimd::level()
+{
+    return SCALAR;
+}
+
+template <bool IsMax>
+inline int MinMaxSimd::scan( const long long*, const long long* )
+{
+    return -1;
+}
+
+template <bool IsMax>
+inline int MinMaxSimd::scan( const int*, const int* )
+{
+    return -1;
+}
+
+template <bool IsMax>
+inline int MinMaxSimd::scan( const double*, const double* )
+{
+    return -1;
+}
+
+#endif // MINMAXHEAP_HAVE_SIMD
+
+// long is 64 bits on LP64 targets and 32 bits on LLP64 ones, use whichever kernel matches
+template <bool IsMax>
+inline int MinMaxSimd::scan( const long* aChildren, const long* aGrandchildren )
+{
+    if( sizeof( long ) == sizeof( long long ) )
+    {
+        return scan<IsMax>( reinterpret_cast<const long long*>( aChildren ), reinterpret_cast<const long long*>( aGrandchildren ) );
+    }
+
+    return scan<IsMax>( reinterpret_cast<const int*>( aChildren ), reinterpret_cast<const int*>( aGrandchildren ) );
+}
@@ -0,0 +1,120 @@
+/**
+*	@file : MinMaxSnapshot.h
+*	@author :  Haaris Chaudhry
+*	@date : Mar 9, 2017
+*	Purpose: A binary snapshot of a min-max heap.  The file is a 64 byte header followed by the heap
+*          array exactly as it sits in memory (heap index i in element i - 1), so restoring it needs
+*          neither parsing nor heapifying: MinMaxHeap::loadSnapshot reads the array back in one block,
+*          and MinMaxSnapshot::adopt maps the file and works on the mapped array directly.
+*
+*          Only trivially copyable key types can be snapshotted.  The header records the format
+*          version, the byte order, the key type and size, the ordering and the array layout (which
+*          engine arranged it), and a snapshot is refused if any of them differ from the heap it is
+*          restored into.
+*/
+
+#ifndef MIN_MAX_SNAPSHOT_H
+#define MIN_MAX_SNAPSHOT_H
+
+#include "MappedFile.h"
+#include "MinMaxHeapView.h"
+#include <cstdint>
+#include <cstdio>
+#include <functional>
+#include <string>
+
+class MinMaxSnapshot
+{
+public:
+    /**
+    * The first 64 bytes of a snapshot file
+    */
+    struct Header
+    {
+        char mMagic[8];             //!< "MMHEAPSN"
+        std::uint32_t mVersion;     //!< The format version, kVersion when written
+        std::uint32_t mHeaderSize;  //!< The offset of the heap array in the file
+        std::uint32_t mByteOrder;   //!< kByteOrder as written by the machine that saved the snapshot
+        std::uint32_t mKeyType;     //!< The kind of key and its size, see keyType
+        std::uint32_t mLayout;      //!< How the array is laid out, kMinMaxLayout or kIntervalLayout
+        std::uint32_t mOrder;       //!< The ordering (see order)
+        std::uint64_t mSize;        //!< The number of values in the heap
+        char mReserved[24];         //!< Zero, pads the header so the array is 64 byte aligned
+    };
+
+    static const std::uint32_t kVersion = 1;
+    static const std::uint32_t kByteOrder = 0x01020304;
+    static const std::uint32_t kMinMaxLayout = 1;      //!< MinMaxHeapEngine::kLayout
+    static const std::uint32_t kIntervalLayout = 2;    //!< MinMaxIntervalEngine::kLayout
+
+    /**
+    * Writes a heap array to a snapshot file. The snapshot is written next to aPath and renamed over it
+    * once it is complete, so a crash while saving leaves the previous snapshot intact.
+    * @param aPath The path of the snapshot file
+    * @param aArray The heap array, heap index i in element i - 1
+    * @param aNumNodes The number of values in the heap
+    * @param aLayout How the engine that built the heap arranged the array
+    * @return None (throws PrecondViolatedExcep if the file cannot be written)
+    */
+    template <class T, class Compare>
+    static void save( const std::string& aPath, const T* aArray, long aNumNodes, std::uint32_t aLayout = kMinMaxLayout );
+
+    /**
+    * Opens a snapshot file and reads its header
+    * @param aPath The path of the snapshot file
+    * @param aNumNodes Set to the number of values in the snapshot
+    * @param aLayout The array layout the heap it is restored into expects
+    * @return The file, positioned at the heap array (throws PrecondViolatedExcep if the file cannot
+    *         be read or was written for a different key type, ordering, layout or format)
+    */
+    template <class T, class Compare>
+    static std::FILE* open( const std::string& aPath, long& aNumNodes, std::uint32_t aLayout = kMinMaxLayout );
+
+    /**
+    * Turns a mapped snapshot into a heap view over the mapping, without copying or heapifying.
+    * Changes made through the view stay in memory, the snapshot file is not modified.
+    * The view is a min-max heap, so only snapshots of MinMaxHeapEngine heaps can be adopted.
+    * @param aFile The snapshot file mapped COPY_ON_WRITE, it has to outlive the view
+    * @param aCompare The ordering the heap was saved with
+    * @return A full heap view over the mapped array (throws PrecondViolatedExcep if the snapshot
+    *         does not match, see open)
+    */
+    template <class T, class Compare = std::less<T> >
+    static MinMaxHeapView<T, Compare> adopt( MappedFile& aFile, const Compare& aCompare = Compare() );
+
+private:
+    /**
+    * @return The header describing a heap of aNumNodes values of type T ordered by Compare and laid out by aLayout
+    */
+    template <class T, class Compare>
+    static Header makeHeader( long aNumNodes, std::uint32_t aLayout );
+
+    /**
+    * Checks a header against the heap type it is restored into
+    * @param aHeader The header read from the file
+    * @param aFileBytes The size of the whole file, the values it claims to hold have to fit in it
+    * @param aPath The path of the file, for the error messages
+    * @param aLayout The array layout the heap expects
+    * @return The number of values in the snapshot (throws PrecondViolatedExcep if it does not match
+    *         or does not fit in the file)
+    */
+    template <class T, class Compare>
+    static long check( const Header& aHeader, long aFileBytes, const std::string& aPath, std::uint32_t aLayout );
+
+    /**
+    * @return 1 for signed integers, 2 for unsigned integers, 3 for floating point and 4 for any other
+    *         type in the top byte, and sizeof( T ) in the low 24 bits
+    */
+    template <class T>
+    static std::uint32_t keyType();
+
+    /**
+    * @return 1 for an ascending std::less, 2 for a descending std::greater, 0 for any other ordering,
+    *         which cannot be told apart and is trusted to match
+    */
+    template <class Compare>
+    static std::uint32_t order();
+};
+
+#include "MinMaxSnapshot.hpp"
+#endif // !MIN_MAX_SNAPSHOT_H
@@ -0,0 +1,189 @@
+/**
+*	@file : MinMaxSnapshot.hpp
+*	@author :  Haaris Chaudhry
+*	@date : Mar 9, 2017
+*	Purpose: Implementation of the min-max heap snapshot format.
+*/
+
+#include "PrecondViolatedExcep.h"
+#include <cstring>
+#include <limits>
+#include <type_traits>
+
+template <class T>
+std::uint32_t MinMaxSnapshot::keyType()
+{
+    std::uint32_t kind = std::is_floating_point<T>::value ? 3 : !std::is_integral<T>::value ? 4 : std::is_signed<T>::value ? 1 : 2;
+    return ( kind << 24 ) | static_cast<std::uint32_t>( sizeof( T ) );
+}
+
+template <class Compare>
+std::uint32_t MinMaxSnapshot::order()
+{
+    if( !MinMaxSimdOrder<Compare>::kVectorizable )
+    {
+        return 0;
+    }
+
+    return MinMaxSimdOrder<Compare>::kAscending ? 1 : 2;
+}
+
+template <class T, class Compare>
+MinMaxSnapshot::Header MinMaxSnapshot::makeHeader( long aNumNodes, std::uint32_t aLayout )
+{
+    Header header;
+    std::memset( &header, 0, sizeof( header ) );
+    std::memcpy( header.mMagic, "MMHEAPSN", sizeof( header.mMagic ) );
+    header.mVersion = kVersion;
+    header.mHeaderSize = sizeof( Header );
+    header.mByteOrder = kByteOrder;
+    header.mKeyType = keyType<T>();
+    header.mLayout = aLayout;
+    header.mOrder = order<Compare>();
+    header.mSize = static_cast<std::uint64_t>( aNumNodes );
+    return header;
+}
+
+// A snapshot from a newer version or another machine is refused rather than guessed at
+template <class T, class Compare>
+long MinMaxSnapshot::check( const Header& aHeader, long aFileBytes, const std::string& aPath, std::uint32_t aLayout )
+{
+    Header expected = makeHeader<T, Compare>( 0, aLayout );
+
+    if( std::memcmp( aHeader.mMagic, expected.mMagic, sizeof( expected.mMagic ) ) != 0 )
+    {
+        throw PrecondViolatedExcep( aPath + " is not a heap snapshot" );
+    }
+
+    if( aHeader.mVersion > kVersion || aHeader.mHeaderSize < sizeof( Header ) || aHeader.mLayout < kMinMaxLayout || aHeader.mLayout > kIntervalLayout )
+    {
+        throw PrecondViolatedExcep( aPath + " has an unsupported snapshot version" );
+    }
+
+    if( aHeader.mLayout != expected.mLayout )
+    {
+        throw PrecondViolatedExcep( aPath + " was saved from a heap with a different engine" );
+    }
+
+    if( aHeader.mByteOrder != kByteOrder )
+    {
+        throw PrecondViolatedExcep( aPath + " was saved with a different byte order" );
+    }
+
+    if( aHeader.mKeyType != expected.mKeyType || aHeader.mOrder != expected.mOrder )
+    {
+        throw PrecondViolatedExcep( aPath + " was saved from a heap of a different key type or ordering" );
+    }
+
+    if( aHeader.mSize > static_cast<std::uint64_t>( std::numeric_limits<long>::max() ) )
+    {
+        throw PrecondViolatedExcep( aPath + " is corrupt" );
+    }
+
+    long numNodes = static_cast<long>( aHeader.mSize );
+
+    if( aFileBytes < static_cast<long>( aHeader.mHeaderSize )
+        || ( aFileBytes - static_cast<long>( aHeader.mHeaderSize ) ) / static_cast<long>( sizeof( T ) ) < numNodes )
+    {
+        throw PrecondViolatedExcep( aPath + " is truncated" );
+    }
+
+    return numNodes;
+}
+
+template <class T, class Compare>
+void MinMaxSnapshot::save( const std::string& aPath, const T* aArray, long aNumNodes, std::uint32_t aLayout )
+{
+    static_assert( std::is_trivially_copyable<T>::value, "Only trivially copyable values can be snapshotted" );
+
+    std::string temporaryPath = aPath + ".tmp";
+    std::FILE* file = std::fopen( temporaryPath.c_str(), "wb" );
+
+    if( file == nullptr )
+    {
+        throw PrecondViolatedExcep( "Could not create " + temporaryPath );
+    }
+
+    Header header = makeHeader<T, Compare>( aNumNodes, aLayout );
+    bool written = std::fwrite( &header, sizeof( header ), 1, file ) == 1
+        && ( aNumNodes == 0 || static_cast<long>( std::fwrite( aArray, sizeof( T ), static_cast<size_t>( aNumNodes ), file ) ) == aNumNodes );
+
+    if( std::fclose( file ) != 0 || !written || std::rename( temporaryPath.c_str(), aPath.c_str() ) != 0 )
+    {
+        std::remove( temporaryPath.c_str() );
+        throw PrecondViolatedExcep( "Could not write " + aPath );
+    }
+}
+
+template <class T, class Compare>
+std::FILE* MinMaxSnapshot::open( const std::string& aPath, long& aNumNodes, std::uint32_t aLayout )
+{
+    static_assert( std::is_trivially_copyable<T>::value, "Only trivially copyable values can be snapshotted" );
+
+    std::FILE* file = std::fopen( aPath.c_str(), "rb" );
+
+    if( file == nullptr )
+    {
+        throw PrecondViolatedExcep( "Could not open " + aPath );
+    }
+
+    Header header;
+
+    if( std::fread( &header, sizeof( header ), 1, file ) != 1 )
+    {
+        std::fclose( file );
+        throw PrecondViolatedExcep( aPath + " is not a heap snapshot" );
+    }
+
+    // The size in the header is only trusted once the file is known to hold that many values
+    long fileBytes = ( std::fseek( file, 0, SEEK_END ) == 0 ) ? std::ftell( file ) : -1L;
+
+    if( fileBytes < 0 )
+    {
+        std::fclose( file );
+        throw PrecondViolatedExcep( "Could not read " + aPath );
+    }
+
+    try
+    {
+        aNumNodes = check<T, Compare>( header, fileBytes, aPath, aLayout );
+    }
+    catch( ... )
+    {
+        std::fclose( file );
+        throw;
+    }
+
+    if( std::fseek( file, static_cast<long>( header.mHeaderSize ), SEEK_SET ) != 0 )
+    {
+        std::fclose( file );
+        throw PrecondViolatedExcep( aPath + " is truncated" );
+    }
+
+    return file;
+}
+
+// A mapping starts on a page boundary and the header keeps the array 64 byte aligned within the file
+template <class T, class Compare>
+MinMaxHeapView<T, Compare> MinMaxSnapshot::adopt( MappedFile& aFile, const Compare& aCompare )
+{
+    static_assert( std::is_trivially_copyable<T>::value, "Only trivially copyable values can be snapshotted" );
+    static_assert( alignof( T ) <= sizeof( Header ), "The snapshot header does not keep this type aligned" );
+
+    if( aFile.size() < static_cast<long>( sizeof( Header ) ) )
+    {
+        throw PrecondViolatedExcep( "The mapped file is not a heap snapshot" );
+    }
+
+    Header header;
+    std::memcpy( &header, aFile.begin(), sizeof( header ) );
+    long numNodes = check<T, Compare>( header, aFile.size(), "The mapped file", kMinMaxLayout );
+
+    if( header.mHeaderSize % alignof( T ) != 0 )
+    {
+        throw PrecondViolatedExcep( "The mapped file does not keep its heap array aligned" );
+    }
+
+    T* array = reinterpret_cast<T*>( aFile.data() + header.mHeaderSize );
+    return MinMaxHeapView<T, Compare>::adopt( array, numNodes, numNodes, aCompare );
+}
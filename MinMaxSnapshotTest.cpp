@@ -0,0 +1,180 @@
+/**
+*	@file : MinMaxSnapshotTest.cpp
+*	@author :  Haaris Chaudhry
+*	@date : Mar 9, 2017
+*	Purpose: Checks that a snapshot restores the same heap under both engines and both orderings, that
+*          it is refused by a heap of another key type, ordering or engine and when the file is cut
+*          short or is not a snapshot at all, and that adopt maps a snapshot into a working heap view
+*          without writing to the file.
+*/
+
+#include "MinMaxHeap.h"
+#include "MinMaxTest.h"
+#include <algorithm>
+#include <cstdio>
+#include <fstream>
+#include <functional>
+#include <iterator>
+#include <random>
+#include <set>
+#include <sstream>
+#include <string>
+#include <vector>
+
+namespace
+{
+    const char* const kPath = "snapshottest.snapshot";
+
+    std::string fileBytes( const std::string& aPath )
+    {
+        std::ifstream file( aPath.c_str(), std::ios::binary );
+        std::ostringstream bytes;
+        bytes << file.rdbuf();
+        return bytes.str();
+    }
+
+    void writeBytes( const std::string& aPath, const std::string& aBytes )
+    {
+        std::ofstream file( aPath.c_str(), std::ios::binary | std::ios::trunc );
+        file.write( aBytes.data(), static_cast<std::streamsize>( aBytes.size() ) );
+    }
+
+    // Drains from both ends, the two halves joined hold the values in the heap's order
+    template <class Heap>
+    std::vector<long> drained( Heap& aHeap )
+    {
+        std::vector<long> low;
+        std::vector<long> high;
+        aHeap.drainBoth( std::back_inserter( low ), std::back_inserter( high ) );
+        low.insert( low.end(), high.rbegin(), high.rend() );
+        return low;
+    }
+
+    template <class Compare, class Engine>
+    void checkRoundTrip( std::mt19937& aRandom, long aNumValues )
+    {
+        typedef MinMaxHeap<long, Compare, std::allocator<long>, Engine> Heap;
+        std::vector<long> values( aNumValues );
+
+        for( long i = 0; i < aNumValues; i++ )
+        {
+            values[i] = static_cast<long>( aRandom() % 1000 );
+        }
+
+        Heap heap( 0, values.data(), aNumValues );
+        heap.saveSnapshot( kPath );
+
+        // Loading replaces whatever the heap held
+        Heap restored;
+        restored.insert( 5000 );
+        restored.loadSnapshot( kPath );
+        MINMAX_CHECK( restored.size() == aNumValues );
+
+        // The array comes back exactly as saved, so saving it again writes the same bytes
+        std::string saved = fileBytes( kPath );
+        restored.saveSnapshot( kPath );
+        MINMAX_CHECK( fileBytes( kPath ) == saved );
+
+        restored.insert( 500 );
+        heap.insert( 500 );
+        std::vector<long> expected = drained( heap );
+        MINMAX_CHECK( drained( restored ) == expected );
+        MINMAX_CHECK( std::is_sorted( expected.begin(), expected.end(), Compare() ) );
+    }
+}
+
+int main()
+{
+    std::mt19937 random( 2017 );
+    const long sizes[] = { 0, 1, 2, 1000 };
+
+    for( size_t s = 0; s < sizeof( sizes ) / sizeof( sizes[0] ); s++ )
+    {
+        checkRoundTrip<std::less<long>, MinMaxHeapEngine>( random, sizes[s] );
+        checkRoundTrip<std::greater<long>, MinMaxHeapEngine>( random, sizes[s] );
+        checkRoundTrip<std::less<long>, MinMaxIntervalEngine>( random, sizes[s] );
+        checkRoundTrip<std::greater<long>, MinMaxIntervalEngine>( random, sizes[s] );
+    }
+
+    std::vector<long> values( 1000 );
+
+    for( long i = 0; i < 1000; i++ )
+    {
+        values[i] = static_cast<long>( random() % 1000 );
+    }
+
+    MinMaxHeap<long> heap( 0, values.data(), 1000 );
+    heap.saveSnapshot( kPath );
+    const std::string saved = fileBytes( kPath );
+
+    // Another key type, even of the same size, another ordering or another engine
+    MinMaxHeap<int> ints;
+    MinMaxHeap<double> doubles;
+    MinMaxHeap<unsigned long> unsignedLongs;
+    MinMaxHeap<long, std::greater<long> > greater;
+    MinMaxHeap<long, std::less<long>, std::allocator<long>, MinMaxIntervalEngine> interval;
+    MINMAX_CHECK_THROWS( ints.loadSnapshot( kPath ) );
+    MINMAX_CHECK_THROWS( doubles.loadSnapshot( kPath ) );
+    MINMAX_CHECK_THROWS( unsignedLongs.loadSnapshot( kPath ) );
+    MINMAX_CHECK_THROWS( greater.loadSnapshot( kPath ) );
+    MINMAX_CHECK_THROWS( interval.loadSnapshot( kPath ) );
+
+    interval.insert( 1 );
+    interval.saveSnapshot( kPath );
+    MinMaxHeap<long> minMax;
+    MINMAX_CHECK_THROWS( minMax.loadSnapshot( kPath ) );
+
+    // Cut inside the header and inside the array; a failed load leaves the heap as it was
+    const size_t cuts[] = { 0, 10, sizeof( MinMaxSnapshot::Header ) - 1, sizeof( MinMaxSnapshot::Header ), saved.size() - sizeof( long ), saved.size() - 1 };
+
+    for( size_t c = 0; c < sizeof( cuts ) / sizeof( cuts[0] ); c++ )
+    {
+        writeBytes( kPath, saved.substr( 0, cuts[c] ) );
+        minMax.insert( 7 );
+        MINMAX_CHECK_THROWS( minMax.loadSnapshot( kPath ) );
+        MINMAX_CHECK( minMax.size() == 1 && minMax.peekMin() == 7 );
+        minMax.clear();
+    }
+
+    writeBytes( kPath, "not a heap snapshot, but longer than a snapshot header is, so the header is read in full" );
+    MINMAX_CHECK_THROWS( minMax.loadSnapshot( kPath ) );
+    std::remove( kPath );
+    MINMAX_CHECK_THROWS( minMax.loadSnapshot( kPath ) );
+
+    // Adopt works on the mapping in place, the file keeps the snapshot as saved
+    writeBytes( kPath, saved );
+
+    {
+        MappedFile mapped( kPath, MappedFile::COPY_ON_WRITE );
+        MinMaxHeapView<long> view = MinMaxSnapshot::adopt<long>( mapped );
+        MINMAX_CHECK( view.size() == 1000 && view.data() == reinterpret_cast<long*>( mapped.data() + sizeof( MinMaxSnapshot::Header ) ) );
+        MINMAX_CHECK( view.replaceMax( -1 ) == *std::max_element( values.begin(), values.end() ) && view.peekMin() == -1 );
+
+        std::multiset<long> reference( values.begin(), values.end() );
+        reference.erase( std::prev( reference.end() ) );
+        reference.insert( -1 );
+        MINMAX_CHECK( drained( view ) == std::vector<long>( reference.begin(), reference.end() ) );
+
+        MINMAX_CHECK_THROWS( MinMaxSnapshot::adopt<double>( mapped ) );
+        MINMAX_CHECK_THROWS( ( MinMaxSnapshot::adopt<long, std::greater<long> >( mapped ) ) );
+    }
+
+    MINMAX_CHECK( fileBytes( kPath ) == saved );
+
+    writeBytes( kPath, saved.substr( 0, saved.size() - 1 ) );
+
+    {
+        MappedFile mapped( kPath, MappedFile::COPY_ON_WRITE );
+        MINMAX_CHECK_THROWS( MinMaxSnapshot::adopt<long>( mapped ) );
+    }
+
+    writeBytes( kPath, saved.substr( 0, 10 ) );
+
+    {
+        MappedFile mapped( kPath, MappedFile::COPY_ON_WRITE );
+        MINMAX_CHECK_THROWS( MinMaxSnapshot::adopt<long>( mapped ) );
+    }
+
+    std::remove( kPath );
+    return MinMaxTest::report( "MinMaxSnapshotTest" );
+}
@@ -0,0 +1,227 @@
+/**
+*	@file : MinMaxStorage.cpp
+*	@author :  Haaris Chaudhry
+*	@date : Mar 9, 2017
+*	Purpose: Implementation of the MinMaxStorage class.
+*/
+
+#include "MinMaxStorage.h"
+#include "PrecondViolatedExcep.h"
+#include <cerrno>
+#include <cstdint>
+#include <cstdlib>
+#include <new>
+
+#if defined( __unix__ ) || defined( __APPLE__ )
+#define MIN_MAX_STORAGE_USE_MMAP 1
+#include <sys/mman.h>
+#include <unistd.h>
+#endif
+
+#if defined( __linux__ )
+#include <sys/syscall.h>
+#endif
+
+MinMaxStorage::MinMaxStorage( Policy aPolicy, int aNode ) :
+    mPolicy( aPolicy ),
+    mNode( aNode )
+{
+    if( mPolicy == NUMA_NODE && ( mNode < 0 || mNode > kMaxNode ) )
+    {
+        throw PrecondViolatedExcep( "MinMaxStorage attempted with a NUMA node out of range" );
+    }
+}
+
+void* MinMaxStorage::allocate( std::size_t aBytes ) const
+{
+    if( mPolicy == DEFAULT )
+    {
+        return ::operator new( aBytes );
+    }
+
+    return isMapped( aBytes ) ? allocateMapped( aBytes ) : allocateAligned( aBytes );
+}
+
+void MinMaxStorage::deallocate( void* aData, std::size_t aBytes ) const
+{
+    if( mPolicy == DEFAULT )
+    {
+        ::operator delete( aData );
+        return;
+    }
+
+#if defined( MIN_MAX_STORAGE_USE_MMAP )
+    if( isMapped( aBytes ) )
+    {
+        munmap( aData, mappedBytes( aBytes ) );
+        return;
+    }
+#endif
+
+    std::free( aData );
+}
+
+MinMaxStorage::Policy MinMaxStorage::policy() const
+{
+    return mPolicy;
+}
+
+int MinMaxStorage::node() const
+{
+    return mNode;
+}
+
+bool MinMaxStorage::operator==( const MinMaxStorage& aOther ) const
+{
+    return ( mPolicy == aOther.mPolicy && ( mPolicy != NUMA_NODE || mNode == aOther.mNode ) );
+}
+
+bool MinMaxStorage::operator!=( const MinMaxStorage& aOther ) const
+{
+    return !( *this == aOther );
+}
+
+// The decision only depends on the size, so deallocate finds the same backend allocate used
+bool MinMaxStorage::isMapped( std::size_t aBytes ) const
+{
+#if defined( MIN_MAX_STORAGE_USE_MMAP )
+    switch( mPolicy )
+    {
+    case HUGE_PAGES:
+    case HUGETLB:
+        return ( aBytes >= kHugePage );
+
+    case NUMA_NODE:
+        return ( aBytes >= kNumaMinimum );
+
+    default:
+        return false;
+    }
+#else
+    static_cast<void>( aBytes );
+    return false;
+#endif
+}
+
+std::size_t MinMaxStorage::mappedBytes( std::size_t aBytes ) const
+{
+    std::size_t granularity = kHugePage;
+
+#if defined( MIN_MAX_STORAGE_USE_MMAP )
+    if( mPolicy == NUMA_NODE )
+    {
+        granularity = static_cast<std::size_t>( sysconf( _SC_PAGESIZE ) );
+    }
+#endif
+
+    return ( aBytes + granularity - 1 ) / granularity * granularity;
+}
+
+void* MinMaxStorage::allocateAligned( std::size_t aBytes ) const
+{
+    void* data = nullptr;
+
+#if defined( MIN_MAX_STORAGE_USE_MMAP )
+    if( posix_memalign( &data, kCacheLine, aBytes ) != 0 )
+    {
+        data = nullptr;
+    }
+#else
+    data = std::malloc( aBytes );
+#endif
+
+    if( data == nullptr )
+    {
+        throw std::bad_alloc();
+    }
+
+    return data;
+}
+
+#if defined( MIN_MAX_STORAGE_USE_MMAP )
+
+// Transparent huge pages only back whole, aligned 2 MB extents, so the mapping is made one huge page
+// too long and trimmed to a huge page boundary at both ends. A NUMA binding is made before the first
+// touch, so every page is allocated on the node straight away. A node that does not exist or that the
+// process may not use fails the binding, and with it the allocation; only a kernel built without NUMA
+// support, where node 0 is all the memory there is, lets node 0 go unbound.
+void* MinMaxStorage::allocateMapped( std::size_t aBytes ) const
+{
+    std::size_t length = mappedBytes( aBytes );
+    int protection = PROT_READ | PROT_WRITE;
+    int flags = MAP_PRIVATE | MAP_ANONYMOUS;
+
+    if( mPolicy == NUMA_NODE )
+    {
+        void* mapping = mmap( nullptr, length, protection, flags, -1, 0 );
+
+        if( mapping == MAP_FAILED )
+        {
+            throw std::bad_alloc();
+        }
+
+#if defined( __linux__ ) && defined( SYS_mbind )
+        const int kBindPolicy = 2;  // MPOL_BIND
+        const int bitsPerWord = static_cast<int>( sizeof( unsigned long ) * 8 );
+        unsigned long nodeMask[kMaxNode / bitsPerWord + 1] = {};
+        nodeMask[mNode / bitsPerWord] |= 1UL << ( mNode % bitsPerWord );
+
+        if( syscall( SYS_mbind, mapping, length, kBindPolicy, nodeMask, sizeof( nodeMask ) * 8, 0 ) != 0
+            && !( errno == ENOSYS && mNode == 0 ) )
+        {
+            munmap( mapping, length );
+            throw std::bad_alloc();
+        }
+#endif
+
+        return mapping;
+    }
+
+#if defined( MAP_HUGETLB )
+    if( mPolicy == HUGETLB )
+    {
+        void* mapping = mmap( nullptr, length, protection, flags | MAP_HUGETLB, -1, 0 );
+
+        if( mapping != MAP_FAILED )
+        {
+            return mapping;
+        }
+    }
+#endif
+
+    void* mapping = mmap( nullptr, length + kHugePage, protection, flags, -1, 0 );
+
+    if( mapping == MAP_FAILED )
+    {
+        throw std::bad_alloc();
+    }
+
+    char* first = static_cast<char*>( mapping );
+    std::uintptr_t address = reinterpret_cast<std::uintptr_t>( first );
+    std::size_t head = ( kHugePage - address % kHugePage ) % kHugePage;
+
+    if( head > 0 )
+    {
+        munmap( first, head );
+    }
+
+    if( kHugePage - head > 0 )
+    {
+        munmap( first + head + length, kHugePage - head );
+    }
+
+#if defined( MADV_HUGEPAGE )
+    madvise( first + head, length, MADV_HUGEPAGE );
+#endif
+
+    return first + head;
+}
+
+#else
+
+void* MinMaxStorage::allocateMapped( std::size_t aBytes ) const
+{
+    return allocateAligned( aBytes );
+}
+
+#endif
@@ -0,0 +1,142 @@
+/**
+*	@file : MinMaxStorage.h
+*	@author :  Haaris Chaudhry
+*	@date : Mar 9, 2017
+*	Purpose: Where a heap array's memory comes from.  MinMaxStorage describes one backend and
+*          MinMaxStorageAllocator is a standard allocator over it, so any heap that takes an
+*          Allocator picks its backend per instance:
+*
+*              MinMaxStorageAllocator<long> hugePages( MinMaxStorage( MinMaxStorage::HUGE_PAGES ) );
+*              MinMaxHeap<long, std::less<long>, MinMaxStorageAllocator<long> > heap( 0, std::less<long>(), hugePages );
+*
+*          ALIGNED starts every array on a cache line.  HUGE_PAGES maps large arrays on 2 MB
+*          boundaries and asks for transparent huge pages, HUGETLB takes them from the reserved huge
+*          page pool and falls back to HUGE_PAGES when the pool is empty; either way a deep trickle
+*          down through a multi gigabyte heap needs far fewer TLB entries.  NUMA_NODE binds large
+*          arrays to one memory node instead of the node of whichever thread touched them first.
+*          Arrays under one huge page (HUGE_PAGES, HUGETLB) or 64 KB (NUMA_NODE) are only aligned.
+*          The mapped backends need a POSIX system, and NUMA binding Linux; elsewhere they behave
+*          like ALIGNED.  On Linux a NUMA_NODE allocation whose binding fails, for a node that does
+*          not exist or is not allowed, throws std::bad_alloc rather than land on another node.
+*/
+
+#ifndef MIN_MAX_STORAGE_H
+#define MIN_MAX_STORAGE_H
+
+#include <cstddef>
+#include <type_traits>
+
+class MinMaxStorage
+{
+public:
+    /**
+    * The backends
+    */
+    enum Policy
+    {
+        DEFAULT = 0,    //!< operator new
+        ALIGNED = 1,    //!< Aligned to a cache line
+        HUGE_PAGES = 2, //!< Transparent huge pages through madvise( MADV_HUGEPAGE )
+        HUGETLB = 3,    //!< Reserved huge pages through MAP_HUGETLB
+        NUMA_NODE = 4   //!< Bound to one NUMA node through mbind
+    };
+
+    static const std::size_t kCacheLine = 64;
+    static const std::size_t kHugePage = 2UL << 20;
+    static const std::size_t kNumaMinimum = 64UL << 10;
+    static const int kMaxNode = 1022;   //!< The highest node NUMA_NODE takes, the binding's mask has 1024 bits
+
+    /**
+    * Constructor for the MinMaxStorage
+    * @param aPolicy The backend
+    * @param aNode The memory node for NUMA_NODE, 0 to kMaxNode (throws PrecondViolatedExcep otherwise),
+    *        ignored for the other backends
+    * @return A description of the backend, allocations are made through it
+    */
+    explicit MinMaxStorage( Policy aPolicy = DEFAULT, int aNode = 0 );
+
+    /**
+    * Allocates memory, aligned at least to a cache line except for DEFAULT
+    * @param aBytes The number of bytes, at least 1
+    * @return The memory (throws std::bad_alloc if there is none, or if NUMA_NODE cannot bind it)
+    */
+    void* allocate( std::size_t aBytes ) const;
+
+    /**
+    * Returns memory allocated by an equal MinMaxStorage
+    * @param aData The memory
+    * @param aBytes The number of bytes it was allocated with
+    */
+    void deallocate( void* aData, std::size_t aBytes ) const;
+
+    /**
+    * @return The backend
+    */
+    Policy policy() const;
+
+    /**
+    * @return The memory node for NUMA_NODE
+    */
+    int node() const;
+
+    /**
+    * Two storages are equal when each can release the other's memory
+    */
+    bool operator==( const MinMaxStorage& aOther ) const;
+    bool operator!=( const MinMaxStorage& aOther ) const;
+
+private:
+    /**
+    * @return True if an allocation of aBytes is mapped rather than taken from the aligned heap
+    */
+    bool isMapped( std::size_t aBytes ) const;
+
+    /**
+    * @return aBytes rounded up to the granularity the mapping is made with
+    */
+    std::size_t mappedBytes( std::size_t aBytes ) const;
+
+    void* allocateAligned( std::size_t aBytes ) const;
+    void* allocateMapped( std::size_t aBytes ) const;
+
+    Policy mPolicy; //!< The backend
+    int mNode;      //!< The memory node for NUMA_NODE
+};
+
+/**
+* A standard allocator over a MinMaxStorage. The storage travels with the heap's array when the heap
+* is moved or swapped, so the array is always released by the backend that allocated it.
+*/
+template <class T>
+class MinMaxStorageAllocator
+{
+public:
+    typedef T value_type;
+    typedef std::true_type propagate_on_container_move_assignment;
+    typedef std::true_type propagate_on_container_swap;
+
+    MinMaxStorageAllocator( const MinMaxStorage& aStorage = MinMaxStorage() );
+
+    template <class U>
+    MinMaxStorageAllocator( const MinMaxStorageAllocator<U>& aOther );
+
+    T* allocate( std::size_t aCount );
+    void deallocate( T* aData, std::size_t aCount );
+
+    /**
+    * @return The backend
+    */
+    const MinMaxStorage& storage() const;
+
+private:
+    MinMaxStorage mStorage; //!< The backend
+};
+
+template <class T, class U>
+bool operator==( const MinMaxStorageAllocator<T>& aLeft, const MinMaxStorageAllocator<U>& aRight );
+
+template <class T, class U>
+bool operator!=( const MinMaxStorageAllocator<T>& aLeft, const MinMaxStorageAllocator<U>& aRight );
+
+#include "MinMaxStorage.hpp"
+#endif // !MIN_MAX_STORAGE_H
@@ -0,0 +1,56 @@
+/**
+*	@file : MinMaxStorage.hpp
+*	@author :  Haaris Chaudhry
+*	@date : Mar 9, 2017
+*	Purpose: Implementation of the MinMaxStorageAllocator class template.
+*/
+
+#include <new>
+
+template <class T>
+MinMaxStorageAllocator<T>::MinMaxStorageAllocator( const MinMaxStorage& aStorage ) :
+    mStorage( aStorage )
+{
+}
+
+template <class T>
+template <class U>
+MinMaxStorageAllocator<T>::MinMaxStorageAllocator( const MinMaxStorageAllocator<U>& aOther ) :
+    mStorage( aOther.storage() )
+{
+}
+
+template <class T>
+T* MinMaxStorageAllocator<T>::allocate( std::size_t aCount )
+{
+    if( aCount > static_cast<std::size_t>( -1 ) / sizeof( T ) )
+    {
+        throw std::bad_alloc();
+    }
+
+    return static_cast<T*>( mStorage.allocate( ( aCount > 0 ? aCount : 1 ) * sizeof( T ) ) );
+}
+
+template <class T>
+void MinMaxStorageAllocator<T>::deallocate( T* aData, std::size_t aCount )
+{
+    mStorage.deallocate( aData, ( aCount > 0 ? aCount : 1 ) * sizeof( T ) );
+}
+
+template <class T>
+const MinMaxStorage& MinMaxStorageAllocator<T>::storage() const
+{
+    return mStorage;
+}
+
+template <class T, class U>
+bool operator==( const MinMaxStorageAllocator<T>& aLeft, const MinMaxStorageAllocator<U>& aRight )
+{
+    return ( aLeft.storage() == aRight.storage() );
+}
+
+template <class T, class U>
+bool operator!=( const MinMaxStorageAllocator<T>& aLeft, const MinMaxStorageAllocator<U>& aRight )
+{
+    return !( aLeft == aRight );
+}
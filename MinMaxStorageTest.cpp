@@ -0,0 +1,127 @@
+/**
+*	@file : MinMaxStorageTest.cpp
+*	@author :  Haaris Chaudhry
+*	@date : Mar 9, 2017
+*	Purpose: Checks that every MinMaxStorage backend hands out aligned, writable memory on both sides of
+*          its mapping threshold, that NUMA_NODE refuses nodes out of range and fails rather than leave
+*          memory unbound, and that a heap runs on each backend, including melds of heaps on two
+*          different backends.
+*/
+
+#include "MinMaxStorage.h"
+#include "MinMaxHeap.h"
+#include "MinMaxTest.h"
+#include <algorithm>
+#include <cstdint>
+#include <cstring>
+#include <functional>
+#include <new>
+
+namespace
+{
+    typedef MinMaxHeap<long, std::less<long>, MinMaxStorageAllocator<long> > StorageHeap;
+
+    bool allocates( const MinMaxStorage& aStorage, std::size_t aBytes )
+    {
+        void* data = aStorage.allocate( aBytes );
+        bool aligned = ( aStorage.policy() == MinMaxStorage::DEFAULT ) || reinterpret_cast<std::uintptr_t>( data ) % MinMaxStorage::kCacheLine == 0;
+        std::memset( data, 0x5a, aBytes );
+        aStorage.deallocate( data, aBytes );
+        return aligned;
+    }
+}
+
+int main()
+{
+    const MinMaxStorage::Policy policies[] = { MinMaxStorage::DEFAULT, MinMaxStorage::ALIGNED, MinMaxStorage::HUGE_PAGES, MinMaxStorage::HUGETLB, MinMaxStorage::NUMA_NODE };
+    const std::size_t sizes[] = { 1, 100, MinMaxStorage::kNumaMinimum, MinMaxStorage::kHugePage - 8, MinMaxStorage::kHugePage, 3 * MinMaxStorage::kHugePage + 8 };
+
+    for( size_t p = 0; p < sizeof( policies ) / sizeof( policies[0] ); p++ )
+    {
+        MinMaxStorage storage( policies[p] );
+
+        for( size_t s = 0; s < sizeof( sizes ) / sizeof( sizes[0] ); s++ )
+        {
+            MINMAX_CHECK( allocates( storage, sizes[s] ) );
+        }
+
+        StorageHeap heap( 0, std::less<long>(), MinMaxStorageAllocator<long>( storage ) );
+
+        for( long i = 0; i < 100000; i++ )
+        {
+            heap.insert( ( i * 7919 ) % 100000 );
+        }
+
+        MINMAX_CHECK( heap.peekMin() == 0 && heap.peekMax() == 99999 && heap.size() == 100000 );
+        MINMAX_CHECK( heap.get_allocator().storage() == storage );
+    }
+
+    // Node 0 always exists, no system has kMaxNode nodes
+    MINMAX_CHECK_THROWS( MinMaxStorage( MinMaxStorage::NUMA_NODE, -1 ) );
+    MINMAX_CHECK_THROWS( MinMaxStorage( MinMaxStorage::NUMA_NODE, MinMaxStorage::kMaxNode + 1 ) );
+    MINMAX_CHECK( MinMaxStorage( MinMaxStorage::ALIGNED, -1 ).policy() == MinMaxStorage::ALIGNED );
+    MINMAX_CHECK( allocates( MinMaxStorage( MinMaxStorage::NUMA_NODE, 0 ), MinMaxStorage::kNumaMinimum ) );
+
+#if defined( __linux__ )
+    bool refused = false;
+
+    try
+    {
+        allocates( MinMaxStorage( MinMaxStorage::NUMA_NODE, MinMaxStorage::kMaxNode ), MinMaxStorage::kNumaMinimum );
+    }
+    catch( std::bad_alloc& )
+    {
+        refused = true;
+    }
+
+    MINMAX_CHECK( refused );
+#endif
+
+    // The larger heap's array and backend are kept, each array is still freed by its own backend
+    const MinMaxStorage::Policy pairs[][2] = { { MinMaxStorage::ALIGNED, MinMaxStorage::HUGE_PAGES }, { MinMaxStorage::HUGE_PAGES, MinMaxStorage::DEFAULT }, { MinMaxStorage::NUMA_NODE, MinMaxStorage::ALIGNED } };
+    const long meldSizes[][2] = { { 10, 400000 }, { 400000, 10 }, { 300000, 300000 } };
+
+    for( size_t p = 0; p < sizeof( pairs ) / sizeof( pairs[0] ); p++ )
+    {
+        for( size_t s = 0; s < sizeof( meldSizes ) / sizeof( meldSizes[0] ); s++ )
+        {
+            MinMaxStorage left( pairs[p][0] );
+            MinMaxStorage right( pairs[p][1] );
+            StorageHeap heap( 0, std::less<long>(), MinMaxStorageAllocator<long>( left ) );
+            StorageHeap other( 0, std::less<long>(), MinMaxStorageAllocator<long>( right ) );
+
+            for( long i = 0; i < meldSizes[s][0]; i++ )
+            {
+                heap.insert( 2 * i );
+            }
+
+            for( long i = 0; i < meldSizes[s][1]; i++ )
+            {
+                other.insert( 2 * i + 1 );
+            }
+
+            bool otherLarger = meldSizes[s][0] < meldSizes[s][1];
+            heap.meld( other );
+            MINMAX_CHECK( heap.size() == meldSizes[s][0] + meldSizes[s][1] && other.isEmpty() );
+            MINMAX_CHECK( heap.get_allocator().storage() == ( otherLarger ? right : left ) );
+            MINMAX_CHECK( other.get_allocator().storage() == ( otherLarger ? left : right ) );
+
+            long expected = 0;
+            bool ordered = true;
+
+            while( !heap.isEmpty() && expected < 2 * std::min( meldSizes[s][0], meldSizes[s][1] ) )
+            {
+                ordered = ordered && ( heap.deleteMin() == expected++ );
+            }
+
+            MINMAX_CHECK( ordered );
+            other.insert( 5 );
+            MINMAX_CHECK( other.peekMax() == 5 );
+        }
+    }
+
+    MINMAX_CHECK( MinMaxStorage( MinMaxStorage::NUMA_NODE, 1 ) != MinMaxStorage( MinMaxStorage::NUMA_NODE, 2 ) );
+    MINMAX_CHECK( MinMaxStorage( MinMaxStorage::ALIGNED, 1 ) == MinMaxStorage( MinMaxStorage::ALIGNED, 2 ) );
+
+    return MinMaxTest::report( "MinMaxStorageTest" );
+}
@@ -0,0 +1,159 @@
+/**
+*	@file : MinMaxTest.h
+*	@author :  Haaris Chaudhry
+*	@date : Mar 9, 2017
+*	Purpose: The checks shared by the test programs (make check).  A failed check prints its file, line
+*          and expression and the run goes on; report then returns the exit status of the program.
+*
+*          Randomized tests drive their ops through runSteps, which seeds the ops of every run on its
+*          own and stops the run at its first failed step.  The step checks print the run's name,
+*          seed and op, and the two values for MINMAX_CHECK_EQUAL, so a failure can be replayed.
+*/
+
+#ifndef MIN_MAX_TEST_H
+#define MIN_MAX_TEST_H
+
+#include "PrecondViolatedExcep.h"
+#include <cstdio>
+#include <iterator>
+#include <random>
+#include <set>
+#include <sstream>
+#include <string>
+
+namespace MinMaxTest
+{
+    /**
+    * @return The number of checks that failed so far
+    */
+    inline long& failures()
+    {
+        static long sFailures = 0;
+        return sFailures;
+    }
+
+    inline void check( bool aPassed, const char* aExpression, const char* aFile, int aLine )
+    {
+        if( !aPassed )
+        {
+            std::printf( "%s:%d: check failed: %s\n", aFile, aLine, aExpression );
+            failures()++;
+        }
+    }
+
+    /**
+    * A randomized run, what a failed step prints so the run can be replayed
+    */
+    struct Run
+    {
+        Run( const std::string& aName, unsigned long aSeed ) : mName( aName ), mSeed( aSeed ), mOp( 0 ) {}
+
+        std::string mName;      //!< What is being run, with its parameters
+        unsigned long mSeed;    //!< The seed of the run's ops
+        long mOp;               //!< The op being checked
+    };
+
+    inline bool checkStep( const Run& aRun, bool aPassed, const std::string& aMessage, const char* aFile, int aLine )
+    {
+        if( !aPassed )
+        {
+            std::printf( "%s:%d: %s, seed %lu, op %ld: check failed: %s\n", aFile, aLine, aRun.mName.c_str(), aRun.mSeed, aRun.mOp, aMessage.c_str() );
+            failures()++;
+        }
+
+        return aPassed;
+    }
+
+    template <class Actual, class Expected>
+    bool checkEqual( const Run& aRun, const Actual& aActual, const Expected& aExpected, const char* aExpression, const char* aFile, int aLine )
+    {
+        if( aActual == aExpected )
+        {
+            return true;
+        }
+
+        std::ostringstream message;
+        message << aExpression << ", got " << aActual << ", expected " << aExpected;
+        return checkStep( aRun, false, message.str(), aFile, aLine );
+    }
+
+    /**
+    * Calls aStep( random, run ) aNumOps times, or until one of its checks fails
+    * @param aName Names the run in a failure, with the parameters that tell it apart
+    * @param aSeed Seeds the random numbers handed to aStep
+    * @param aNumOps The number of steps
+    * @param aStep The op, it reads run.mOp and reports through the step checks
+    * @return True if every step passed
+    */
+    template <class Step>
+    bool runSteps( const std::string& aName, unsigned long aSeed, long aNumOps, Step aStep )
+    {
+        std::mt19937 random( aSeed );
+        Run run( aName, aSeed );
+        long before = failures();
+
+        for( ; run.mOp < aNumOps && failures() == before; run.mOp++ )
+        {
+            aStep( random, run );
+        }
+
+        return ( failures() == before );
+    }
+
+    /**
+    * Checks a double ended heap's size and both ends against a std::multiset holding the same values
+    */
+    template <class Heap, class T, class Compare>
+    bool checkEnds( const Run& aRun, const Heap& aHeap, const std::multiset<T, Compare>& aReference, const char* aFile, int aLine )
+    {
+        return checkEqual( aRun, aHeap.size(), static_cast<long>( aReference.size() ), "size()", aFile, aLine )
+            && checkEqual( aRun, aHeap.isEmpty(), aReference.empty(), "isEmpty()", aFile, aLine )
+            && ( aReference.empty()
+                 || ( checkEqual( aRun, aHeap.peekMin(), *aReference.begin(), "peekMin()", aFile, aLine )
+                      && checkEqual( aRun, aHeap.peekMax(), *aReference.rbegin(), "peekMax()", aFile, aLine ) ) );
+    }
+
+    /**
+    * Deletes from one end of a double ended heap and of the std::multiset holding the same values
+    * @param aMax True for deleteMax, false for deleteMin
+    */
+    template <class Heap, class T, class Compare>
+    bool checkDelete( const Run& aRun, Heap& aHeap, std::multiset<T, Compare>& aReference, bool aMax, const char* aFile, int aLine )
+    {
+        typename std::multiset<T, Compare>::iterator end = aMax ? std::prev( aReference.end() ) : aReference.begin();
+        T expected = *end;
+        aReference.erase( end );
+        return aMax ? checkEqual( aRun, aHeap.deleteMax(), expected, "deleteMax()", aFile, aLine )
+                    : checkEqual( aRun, aHeap.deleteMin(), expected, "deleteMin()", aFile, aLine );
+    }
+
+    /**
+    * Prints a one line summary
+    * @param aName The name of the test program
+    * @return 0 if every check passed, 1 otherwise
+    */
+    inline int report( const char* aName )
+    {
+        std::printf( "%s: %s\n", aName, ( failures() == 0 ) ? "passed" : "FAILED" );
+        return ( failures() == 0 ) ? 0 : 1;
+    }
+}
+
+#define MINMAX_CHECK( aExpression ) MinMaxTest::check( ( aExpression ), #aExpression, __FILE__, __LINE__ )
+
+// Passes if aStatement throws PrecondViolatedExcep
+#define MINMAX_CHECK_THROWS( aStatement ) \
+    do \
+    { \
+        bool thrown = false; \
+        try { aStatement; } catch( PrecondViolatedExcep& ) { thrown = true; } \
+        MinMaxTest::check( thrown, #aStatement " throws", __FILE__, __LINE__ ); \
+    } while( false )
+
+// The checks for a step of a MinMaxTest::Run, each is true if it passed
+#define MINMAX_CHECK_STEP( aRun, aExpression ) MinMaxTest::checkStep( ( aRun ), ( aExpression ), #aExpression, __FILE__, __LINE__ )
+#define MINMAX_CHECK_EQUAL( aRun, aActual, aExpected ) MinMaxTest::checkEqual( ( aRun ), ( aActual ), ( aExpected ), #aActual, __FILE__, __LINE__ )
+#define MINMAX_CHECK_ENDS( aRun, aHeap, aReference ) MinMaxTest::checkEnds( ( aRun ), ( aHeap ), ( aReference ), __FILE__, __LINE__ )
+#define MINMAX_CHECK_DELETE( aRun, aHeap, aReference, aMax ) MinMaxTest::checkDelete( ( aRun ), ( aHeap ), ( aReference ), ( aMax ), __FILE__, __LINE__ )
+
+#endif // !MIN_MAX_TEST_H
@@ -2,44 +2,42 @@
 *	@file : QNode.h
 *	@author :  Haaris Chaudhry
 *	@date : 2016.2.12
-*	Purpose: QNode header file.  The QNode class will simulate a "node" that holds an integer
-*          value and points to another node.
+*	Purpose: QNode header file.  The QNode class will simulate a "node" that holds a fixed size block of
+*          values and points to another node.  The slots are raw storage, the Queue decides which of
+*          them hold live values.
 */
 
 #ifndef QNODE_H
 #define QNODE_H
 
+#include <type_traits>
+
 template <class T>
 class QNode
 {
 public:
+    static const int CAPACITY = ( sizeof( T ) < 4096 / 16 ) ? static_cast<int>( 4096 / sizeof( T ) ) : 16; //!< Slots per node, about a page
+
     /**
     *  @pre None
-    *  @post Creates and initializes a QNode object with default values.
-    *  @return Initialized QNode class with default values (m_value = 0 and m_next = nullptr)
+    *  @post Creates a QNode object with uninitialized slots.
+    *  @return Initialized QNode class with m_next = nullptr
     */
     QNode();
 
     /**
-    *  @pre A type T parameter
-    *  @post Creates and initializes a QNode object with passed in value.
-    *  @return Initialized QNode class with m_value = val and m_next = nullptr
-    */
-    QNode( T val );
-
-    /**
-    *  @pre None
+    *  @pre 0 <= aIndex < CAPACITY
     *  @post None
-    *  @return Returns the m_value contained in the QNode object
+    *  @return Returns the address of slot aIndex, which may or may not hold a constructed value
     */
-    T getValue() const;
+    T* slot( int aIndex );
 
     /**
-    *  @pre A type T parameter
-    *  @post Sets the m_value to the passed in value.
-    *  @return None
+    *  @pre 0 <= aIndex < CAPACITY
+    *  @post None
+    *  @return Returns the address of slot aIndex, which may or may not hold a constructed value
     */
-    void setValue( T val );
+    const T* slot( int aIndex ) const;
 
     /**
     *  @pre None
@@ -56,9 +54,9 @@ public:
     void setNext( QNode<T>* next );
 
 private:
-    T m_value; //The type T value contained within the QNode object
+    typename std::aligned_storage<sizeof( T ), alignof( T )>::type m_slots[CAPACITY]; //The raw storage for the values
     QNode<T>* m_next; //The pointer that points to the next QNode object
 };
 
 #include "QNode.hpp"
-#endif
\ No newline at end of file
+#endif
@@ -5,37 +5,27 @@
 *	Purpose: The QNode implementation file.
 */
 
-//The default constructor sets m_value and m_next to 0 and nullptr respectively.
-//These values are set by way of the set methods
-
-
 template <class T>
-QNode<T>::QNode()
-{
-    m_value = T();
-    setNext( nullptr );
-}
+const int QNode<T>::CAPACITY;
 
-//Using the set methods, this constructor sets m_value and m_next to val and nullptr respectively.
+//The default constructor leaves the slots alone and sets m_next to nullptr.
 template <class T>
-QNode<T>::QNode( T val )
+QNode<T>::QNode()
 {
-    setValue( val );
     setNext( nullptr );
 }
 
-//Returns the value of m_value contained within the called QNode object
+//Returns the address of a slot, the caller constructs and destroys the value in it
 template <class T>
-T QNode<T>::getValue() const
+T* QNode<T>::slot( int aIndex )
 {
-    return m_value;
+    return reinterpret_cast<T*>( &m_slots[aIndex] );
 }
 
-//Sets the m_value contained within the called QNode object
 template <class T>
-void QNode<T>::setValue( T val )
+const T* QNode<T>::slot( int aIndex ) const
 {
-    m_value = val;
+    return reinterpret_cast<const T*>( &m_slots[aIndex] );
 }
 
 //Returns the pointer of the called object that is pointing another QNode (or nullptr)
@@ -50,4 +40,4 @@ template <class T>
 void QNode<T>::setNext( QNode<T>* next )
 {
     m_next = next;
-}
\ No newline at end of file
+}
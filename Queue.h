@@ -2,8 +2,10 @@
 *	@file : Queue.h
 *	@author :  Haaris Chaudhry
 *	@date : 2015.2.27
-*	Purpose: The queue class will simulate a queue where first in items are first out.  This particular class will utilize an interface
-*				provided by QueueInterface.h.
+*	Purpose: The queue class will simulate a queue where first in items are first out.  The items live in a
+*				chain of fixed size QNode blocks, items are added at the back block and removed from the
+*				front block, so both ends are O(1).  Emptied blocks go to a pool and are reused before any
+*				new block is allocated.
 */
 
 #ifndef QUEUE_H
@@ -11,45 +13,157 @@
 
 #include "QNode.h"
 #include "PrecondViolatedExcep.h"
+#include <cstddef>
+#include <iterator>
 #include <string>
 
 template <class ItemType>
 class Queue
 {
 public:
+    /**
+    *  A forward iterator over the items from front to back.  Enqueueing or dequeueing invalidates it.
+    */
+    template <class Value, class Node>
+    class BasicIterator
+    {
+    public:
+        typedef std::forward_iterator_tag iterator_category;
+        typedef Value value_type;
+        typedef std::ptrdiff_t difference_type;
+        typedef Value* pointer;
+        typedef Value& reference;
+
+        BasicIterator();
+        BasicIterator( Node* aNode, int aIndex );
+
+        /**
+        *  @pre An iterator over the same Queue.
+        *  @post Lets a mutable iterator convert to a const one (but not the other way around).
+        *  @return An iterator at the same position.
+        */
+        template <class OtherValue, class OtherNode>
+        BasicIterator( const BasicIterator<OtherValue, OtherNode>& aOther );
+
+        reference operator*() const;
+        pointer operator->() const;
+        BasicIterator& operator++();
+        BasicIterator operator++( int );
+        bool operator==( const BasicIterator& aOther ) const;
+        bool operator!=( const BasicIterator& aOther ) const;
+
+    private:
+        template <class OtherValue, class OtherNode>
+        friend class BasicIterator;
+
+        Node* m_node; //The block the iterator is in
+        int m_index; //The slot within that block
+    };
+
+    typedef BasicIterator<ItemType, QNode<ItemType> > iterator;
+    typedef BasicIterator<const ItemType, const QNode<ItemType> > const_iterator;
+
     /**
     *  @pre None.
     *  @post None.
-    *  @return None (this is the destructor, it deallocates the memory reserved by every Node that was created).
+    *  @return None (this is the destructor, it deallocates every block, including the pooled ones).
     */
     ~Queue();
 
     /**
     *  @pre None.
-    *  @post Creates a Queue object with a m_front member variable that points to nullptr and a m_size of 0.
+    *  @post Creates a Queue object with no blocks and a m_size of 0.
     *  @return A Queue object.
     */
     Queue();
 
+    /**
+    *  @pre Another Queue.
+    *  @post Creates a Queue holding copies of the items of aOther, in the same order.
+    *  @return A Queue object.
+    */
+    Queue( const Queue& aOther );
+
+    /**
+    *  @pre Another Queue.
+    *  @post Takes over the blocks of aOther, which is left empty.
+    *  @return A Queue object.
+    */
+    Queue( Queue&& aOther ) noexcept;
+
+    /**
+    *  @pre Another Queue.
+    *  @post This queue holds copies of (or, when moving, the blocks of) aOther's items.
+    *  @return This queue.
+    */
+    Queue& operator=( const Queue& aOther );
+    Queue& operator=( Queue&& aOther ) noexcept;
+
+    /**
+    *  @pre Another Queue.
+    *  @post Exchanges the blocks of the two queues.
+    *  @return None.
+    */
+    void swap( Queue& aOther ) noexcept;
+
     /**
     *  @pre A value of type ItemType.
-    *  @post Adds a Node with a value of type ItemType to the end of the Queue.
+    *  @post Adds the value to the end of the Queue.
+    *  @return None. (throws a PrecondViolatedExcep exception if memory allocation was unsuccessful)
+    */
+    void enqueue( const ItemType& newEntry );
+
+    /**
+    *  @pre A value of type ItemType that can be moved from.
+    *  @post Moves the value to the end of the Queue.
     *  @return None. (throws a PrecondViolatedExcep exception if memory allocation was unsuccessful)
     */
-    void enqueue( const ItemType& newEntry ) throw ( PrecondViolatedExcep );
+    void enqueue( ItemType&& newEntry );
+
+    /**
+    *  @pre Arguments for one of ItemType's constructors.
+    *  @post Constructs a value in place at the end of the Queue.
+    *  @return None. (throws a PrecondViolatedExcep exception if memory allocation was unsuccessful)
+    */
+    template <class... Args>
+    void emplace( Args&&... args );
+
+    /**
+    *  @pre A range of values convertible to ItemType.
+    *  @post Adds every value to the end of the Queue, in order, filling each block in one pass.
+    *  @return None. (throws a PrecondViolatedExcep exception if memory allocation was unsuccessful)
+    */
+    template <class InputIterator>
+    void enqueueRange( InputIterator aFirst, InputIterator aLast );
+
     /**
     *  @pre None
-    *  @post Removes a Node from the front of the Queue.
+    *  @post Removes the item at the front of the Queue.
     *  @return None (throws PrecondViolatedExcep if a removal is attempted on empty queue.)
     */
-    void dequeue() throw( PrecondViolatedExcep );
+    void dequeue();
+
+    /**
+    *  @pre None
+    *  @post Moves the front item out of the Queue and removes it.
+    *  @return The front item (throws PrecondViolatedExcep if a removal is attempted on empty queue.)
+    */
+    ItemType pop();
+
+    /**
+    *  @pre An output iterator with room for up to aCount items.
+    *  @post Moves up to aCount items from the front of the Queue to aOut and removes them.
+    *  @return The number of items that were moved out.
+    */
+    template <class OutputIterator>
+    long dequeueRange( OutputIterator aOut, long aCount );
 
     /**
     *  @pre None
     *  @post None
     *  @return Returns a value of type ItemType contained within the front Node of the Queue (throws PrecondViolatedExcep if peek attempted on empty Queue).
     */
-    ItemType peekFront() const throw( PrecondViolatedExcep );
+    ItemType peekFront() const;
 
     /**
     *  @pre None.
@@ -58,10 +172,81 @@ public:
     */
     bool isEmpty() const;
 
+    /**
+    *  @pre None.
+    *  @post None.
+    *  @return Returns the number of items in the Queue.
+    */
+    long size() const;
+
+    /**
+    *  @pre None.
+    *  @post Removes every item; the blocks are kept in the pool for reuse.
+    *  @return None.
+    */
+    void clear();
+
+    /**
+    *  @pre None.
+    *  @post Deallocates the pooled blocks that hold no items.
+    *  @return None.
+    */
+    void shrink_to_fit();
+
+    /**
+    *  @pre None.
+    *  @post None.
+    *  @return Iterators to the front item and one past the back item.
+    */
+    iterator begin();
+    iterator end();
+    const_iterator begin() const;
+    const_iterator end() const;
+
 private:
-    QNode <ItemType>* m_front;  //A Node pointer of type ItemType that points to the first Node of the Queue.
-    int m_size; //A member variable that keeps track of the number of nodes in the Queue.
+    /**
+    *  @pre None.
+    *  @post Finds the slot after the back item, in the back block or else in a block at the head of the
+    *        pool, allocating one if the pool is empty. The queue itself is not changed.
+    *  @return The address of the free slot (throws PrecondViolatedExcep if memory allocation was unsuccessful).
+    */
+    ItemType* backSlot();
+
+    /**
+    *  @pre An item was constructed in the slot backSlot returned.
+    *  @post Counts the slot as used, linking its block in after the back block if it came from the pool.
+    *  @return None.
+    */
+    void commitBackSlot();
+
+    /**
+    *  @pre The Queue is not empty and the front slot has been destroyed.
+    *  @post Advances past the front slot, returning the front block to the pool once it is used up.
+    *  @return None.
+    */
+    void popFrontSlot();
+
+    /**
+    *  @pre A block that holds no items.
+    *  @post Puts the block in the pool.
+    *  @return None.
+    */
+    void recycle( QNode<ItemType>* aNode );
+
+    /**
+    *  @pre None.
+    *  @post Deallocates every block in the pool.
+    *  @return None.
+    */
+    void releasePool();
+
+    QNode<ItemType>* m_front; //The block holding the front item (nullptr if no block is in use)
+    QNode<ItemType>* m_back; //The block new items are added to
+    QNode<ItemType>* m_pool; //A chain of empty blocks waiting to be reused
+    int m_head; //The slot of the front item within m_front
+    int m_tail; //One past the slot of the back item within m_back
+    long m_size; //A member variable that keeps track of the number of items in the Queue.
 };
 
 #include "Queue.hpp"
-#endif
\ No newline at end of file
+#endif
@@ -5,40 +5,270 @@
 *	Purpose: Implementation of the Queue class.
 */
 
+#include <new>
+#include <utility>
+
 template <class ItemType>
 Queue<ItemType>::Queue()
 {
     m_front = nullptr;
+    m_back = nullptr;
+    m_pool = nullptr;
+    m_head = 0;
+    m_tail = 0;
     m_size = 0;
 }
 
-//ItemTypehe destructor will loop through the list and deallocate the memory held by each QNode
+//The destructor destroys the remaining items, then deallocates the blocks in the chain and in the pool
 template <class ItemType>
 Queue<ItemType>::~Queue()
 {
-    QNode<ItemType>* temp = nullptr;  //we need a temp variable to hold the QNode to be deleted
+    clear();
+    releasePool();
+}
+
+//If a copy throws, the blocks taken so far have to be given back here since the destructor will not run
+template <class ItemType>
+Queue<ItemType>::Queue( const Queue& aOther ) :
+    Queue()
+{
+    try
+    {
+        enqueueRange( aOther.begin(), aOther.end() );
+    }
+    catch( ... )
+    {
+        clear();
+        releasePool();
+        throw;
+    }
+}
+
+template <class ItemType>
+Queue<ItemType>::Queue( Queue&& aOther ) noexcept :
+    Queue()
+{
+    swap( aOther );
+}
+
+template <class ItemType>
+Queue<ItemType>& Queue<ItemType>::operator=( const Queue& aOther )
+{
+    if( this != &aOther )
+    {
+        Queue copy( aOther );
+        swap( copy );
+    }
+
+    return *this;
+}
+
+template <class ItemType>
+Queue<ItemType>& Queue<ItemType>::operator=( Queue&& aOther ) noexcept
+{
+    if( this != &aOther )
+    {
+        Queue moved( std::move( aOther ) );
+        swap( moved );
+    }
+
+    return *this;
+}
+
+template <class ItemType>
+void Queue<ItemType>::swap( Queue& aOther ) noexcept
+{
+    std::swap( m_front, aOther.m_front );
+    std::swap( m_back, aOther.m_back );
+    std::swap( m_pool, aOther.m_pool );
+    std::swap( m_head, aOther.m_head );
+    std::swap( m_tail, aOther.m_tail );
+    std::swap( m_size, aOther.m_size );
+}
+
+//Adds a copy of newEntry after the back item
+template <class ItemType>
+void Queue<ItemType>::enqueue( const ItemType& newEntry )
+{
+    emplace( newEntry );
+}
+
+template <class ItemType>
+void Queue<ItemType>::enqueue( ItemType&& newEntry )
+{
+    emplace( std::move( newEntry ) );
+}
+
+//The slot only counts as used once the constructor has returned
+template <class ItemType>
+template <class... Args>
+void Queue<ItemType>::emplace( Args&&... args )
+{
+    ItemType* slot = backSlot();
+    ::new( static_cast<void*>( slot ) ) ItemType( std::forward<Args>( args )... );
+    commitBackSlot();
+}
+
+//Only the first value of each block goes through backSlot, the rest of the block is filled directly
+template <class ItemType>
+template <class InputIterator>
+void Queue<ItemType>::enqueueRange( InputIterator aFirst, InputIterator aLast )
+{
+    while( aFirst != aLast )
+    {
+        ItemType* slot = backSlot();
+        ::new( static_cast<void*>( slot ) ) ItemType( *aFirst );
+        commitBackSlot();
+        ++aFirst;
+
+        while( aFirst != aLast && m_tail < QNode<ItemType>::CAPACITY )
+        {
+            ::new( static_cast<void*>( m_back->slot( m_tail ) ) ) ItemType( *aFirst );
+            m_tail++;
+            m_size++;
+            ++aFirst;
+        }
+    }
+}
+
+template <class ItemType>
+void Queue<ItemType>::dequeue()
+{
+    if( isEmpty() )
+    {
+        throw PrecondViolatedExcep( "Removal attempted on an empty queue" );
+    }
 
+    m_front->slot( m_head )->~ItemType();
+    popFrontSlot();
+}
+
+template <class ItemType>
+ItemType Queue<ItemType>::pop()
+{
+    if( isEmpty() )
+    {
+        throw PrecondViolatedExcep( "Removal attempted on an empty queue" );
+    }
+
+    ItemType* front = m_front->slot( m_head );
+    ItemType value( std::move( *front ) );
+    front->~ItemType();
+    popFrontSlot();
+    return value;
+}
+
+template <class ItemType>
+template <class OutputIterator>
+long Queue<ItemType>::dequeueRange( OutputIterator aOut, long aCount )
+{
+    long moved = 0;
+
+    while( moved < aCount && !isEmpty() )
+    {
+        ItemType* front = m_front->slot( m_head );
+        *aOut = std::move( *front );
+        ++aOut;
+        front->~ItemType();
+        popFrontSlot();
+        moved++;
+    }
+
+    return moved;
+}
+
+template <class ItemType>
+ItemType Queue<ItemType>::peekFront() const
+{
+    if( isEmpty() )
+    {
+        throw PrecondViolatedExcep( "Peek attempted on an empty queue" );
+    }
+    else
+    {
+        return *m_front->slot( m_head );
+    }
+}
+
+template <class ItemType>
+bool Queue<ItemType>::isEmpty() const
+{
+    return ( m_size == 0 );
+}
+
+template <class ItemType>
+long Queue<ItemType>::size() const
+{
+    return m_size;
+}
+
+//Every block in the chain goes to the pool, so refilling the queue allocates nothing
+template <class ItemType>
+void Queue<ItemType>::clear()
+{
     while( !isEmpty() )
     {
-        temp = m_front;  //temp point to the first QNode in the list
-        m_front = m_front->getNext();  //m_front then points to the second QNode in the list
-        delete temp;  //the QNode that temp is pointing to is deleted
-        m_size--; //a QNode has been deleted in the list, so we decrease the size
+        m_front->slot( m_head )->~ItemType();
+        popFrontSlot();
+    }
+
+    if( m_front != nullptr )
+    {
+        recycle( m_front );
     }
 
-    m_front = nullptr; //set m_front to nullptr because there are no more QNode objects to point to
+    m_front = nullptr;
+    m_back = nullptr;
+    m_head = 0;
+    m_tail = 0;
+}
+
+template <class ItemType>
+void Queue<ItemType>::shrink_to_fit()
+{
+    releasePool();
 }
 
-//Adds a QNode object to the front of the list
 template <class ItemType>
-void Queue<ItemType>::enqueue( const ItemType& newEntry ) throw ( PrecondViolatedExcep )
+typename Queue<ItemType>::iterator Queue<ItemType>::begin()
 {
-    if( m_front == nullptr )  //Is the list empty? Then m_front will point to this new QNode object
+    return iterator( m_front, m_head );
+}
+
+template <class ItemType>
+typename Queue<ItemType>::iterator Queue<ItemType>::end()
+{
+    return iterator( m_back, m_tail );
+}
+
+template <class ItemType>
+typename Queue<ItemType>::const_iterator Queue<ItemType>::begin() const
+{
+    return const_iterator( m_front, m_head );
+}
+
+template <class ItemType>
+typename Queue<ItemType>::const_iterator Queue<ItemType>::end() const
+{
+    return const_iterator( m_back, m_tail );
+}
+
+//A new block is only needed once the back block is full, pooled blocks are used before new ones. The
+//block stays at the head of the pool until commitBackSlot, so a constructor that throws leaves the
+//chain as it was.
+template <class ItemType>
+ItemType* Queue<ItemType>::backSlot()
+{
+    if( m_back != nullptr && m_tail < QNode<ItemType>::CAPACITY )
+    {
+        return m_back->slot( m_tail );
+    }
+
+    if( m_pool == nullptr )
     {
         try
         {
-            m_front = new QNode<ItemType>( newEntry );
-            m_size++;
+            recycle( new QNode<ItemType>() );
         }
         catch( std::bad_alloc& e )
         {
@@ -46,66 +276,151 @@ void Queue<ItemType>::enqueue( const ItemType& newEntry ) throw ( PrecondViolate
             throw PrecondViolatedExcep( message );
         }
     }
-    else  //If the list is not empty, then newNode is a pointer that will point to a new QNode object
+
+    return m_pool->slot( 0 );
+}
+
+template <class ItemType>
+void Queue<ItemType>::commitBackSlot()
+{
+    if( m_back == nullptr || m_tail == QNode<ItemType>::CAPACITY )
     {
-        try
+        QNode<ItemType>* node = m_pool;
+        m_pool = node->getNext();
+        node->setNext( nullptr );
+
+        if( m_back == nullptr )
         {
-            QNode<ItemType>* newNode = new QNode<ItemType>( newEntry );  //ItemTypehe object pointed to by newNode will have newEntry as its m_value
-            QNode<ItemType>* temp = m_front;
-            while( temp->getNext() != nullptr )
-            {
-                temp = temp->getNext();
-            }
-            temp->setNext( newNode );
-            m_size++;  //we added a new QNode object to the list, so we should increment the size
+            m_front = node;
+            m_head = 0;
         }
-        catch( std::bad_alloc& e )
+        else
         {
-            std::string message = "Memory could not be allocated";
-            throw PrecondViolatedExcep( message );
+            m_back->setNext( node );
         }
+
+        m_back = node;
+        m_tail = 0;
     }
+
+    m_tail++;
+    m_size++;
 }
 
+//Once the last item is gone both ends restart at slot 0 of the same block, so an emptied queue keeps
+//its block instead of walking into a new one
 template <class ItemType>
-void Queue<ItemType>::dequeue() throw( PrecondViolatedExcep )
+void Queue<ItemType>::popFrontSlot()
 {
-    if( m_front == nullptr )
+    m_head++;
+    m_size--;
+
+    if( m_size == 0 )
     {
-        throw PrecondViolatedExcep( "Removal attempted on an empty queue" );
+        m_head = 0;
+        m_tail = 0;
     }
-    else
+    else if( m_head == QNode<ItemType>::CAPACITY )
     {
-        QNode<ItemType>* temp = m_front;
+        QNode<ItemType>* used = m_front;
         m_front = m_front->getNext();
-        delete temp;
-        m_size--;
+        m_head = 0;
+        recycle( used );
     }
 }
 
 template <class ItemType>
-ItemType Queue<ItemType>::peekFront() const throw( PrecondViolatedExcep )
+void Queue<ItemType>::recycle( QNode<ItemType>* aNode )
 {
-    if( isEmpty() )
-    {
-        throw PrecondViolatedExcep( "Peek attempted on an empty queue" );
-    }
-    else
-    {
-        return m_front->getValue();
-    }
+    aNode->setNext( m_pool );
+    m_pool = aNode;
 }
 
 template <class ItemType>
-bool Queue<ItemType>::isEmpty() const
+void Queue<ItemType>::releasePool()
 {
-    if( m_size == 0 )
+    while( m_pool != nullptr )
     {
-        return true;
+        QNode<ItemType>* temp = m_pool;
+        m_pool = m_pool->getNext();
+        delete temp;
     }
-    else
+}
+
+template <class ItemType>
+template <class Value, class Node>
+Queue<ItemType>::BasicIterator<Value, Node>::BasicIterator() :
+    m_node( nullptr ),
+    m_index( 0 )
+{
+}
+
+template <class ItemType>
+template <class Value, class Node>
+Queue<ItemType>::BasicIterator<Value, Node>::BasicIterator( Node* aNode, int aIndex ) :
+    m_node( aNode ),
+    m_index( aIndex )
+{
+}
+
+template <class ItemType>
+template <class Value, class Node>
+template <class OtherValue, class OtherNode>
+Queue<ItemType>::BasicIterator<Value, Node>::BasicIterator( const BasicIterator<OtherValue, OtherNode>& aOther ) :
+    m_node( aOther.m_node ),
+    m_index( aOther.m_index )
+{
+}
+
+template <class ItemType>
+template <class Value, class Node>
+Value& Queue<ItemType>::BasicIterator<Value, Node>::operator*() const
+{
+    return *m_node->slot( m_index );
+}
+
+template <class ItemType>
+template <class Value, class Node>
+Value* Queue<ItemType>::BasicIterator<Value, Node>::operator->() const
+{
+    return m_node->slot( m_index );
+}
+
+//The back block is the only one without a successor, so stepping off its last slot lands on end()
+template <class ItemType>
+template <class Value, class Node>
+typename Queue<ItemType>::template BasicIterator<Value, Node>& Queue<ItemType>::BasicIterator<Value, Node>::operator++()
+{
+    m_index++;
+
+    if( m_index == QNode<ItemType>::CAPACITY && m_node->getNext() != nullptr )
     {
-        return false;
+        m_node = m_node->getNext();
+        m_index = 0;
     }
+
+    return *this;
+}
+
+template <class ItemType>
+template <class Value, class Node>
+typename Queue<ItemType>::template BasicIterator<Value, Node> Queue<ItemType>::BasicIterator<Value, Node>::operator++( int )
+{
+    BasicIterator previous = *this;
+    ++( *this );
+    return previous;
+}
+
+template <class ItemType>
+template <class Value, class Node>
+bool Queue<ItemType>::BasicIterator<Value, Node>::operator==( const BasicIterator& aOther ) const
+{
+    return m_node == aOther.m_node && m_index == aOther.m_index;
 }
 
+template <class ItemType>
+template <class Value, class Node>
+bool Queue<ItemType>::BasicIterator<Value, Node>::operator!=( const BasicIterator& aOther ) const
+{
+    return !( *this == aOther );
+}
@@ -0,0 +1,154 @@
+/**
+*	@file : QueueTest.cpp
+*	@author :  Haaris Chaudhry
+*	@date : Mar 9, 2017
+*	Purpose: Checks Queue against a std::deque through random single and range enqueues and dequeues
+*          across block boundaries, and that an item whose constructor throws while a new block is
+*          being started leaves the queue as it was.
+*/
+
+#include "Queue.h"
+#include "MinMaxTest.h"
+#include <algorithm>
+#include <deque>
+#include <random>
+#include <string>
+#include <vector>
+
+namespace
+{
+    // Throws from its constructor while sThrowing is set
+    struct Fragile
+    {
+        static bool sThrowing;
+
+        Fragile( long aValue ) : mValue( aValue )
+        {
+            if( sThrowing )
+            {
+                throw PrecondViolatedExcep( "constructor failed" );
+            }
+        }
+
+        long mValue;
+    };
+
+    bool Fragile::sThrowing = false;
+
+    void runAgainstReference( long aMaxRun, unsigned long aSeed )
+    {
+        Queue<long> queue;
+        std::deque<long> reference;
+        long next = 0;
+
+        MinMaxTest::runSteps( "runs up to " + std::to_string( aMaxRun ), aSeed, 3000, [&]( std::mt19937& aRandom, const MinMaxTest::Run& aRun )
+        {
+            long choice = static_cast<long>( aRandom() % 8 );
+            long count = 1 + static_cast<long>( aRandom() % aMaxRun );
+
+            if( choice == 0 )
+            {
+                std::vector<long> values;
+
+                for( long i = 0; i < count; i++ )
+                {
+                    values.push_back( next++ );
+                }
+
+                queue.enqueueRange( values.begin(), values.end() );
+                reference.insert( reference.end(), values.begin(), values.end() );
+            }
+            else if( choice == 1 )
+            {
+                for( long i = 0; i < count; i++ )
+                {
+                    queue.enqueue( next );
+                    reference.push_back( next++ );
+                }
+            }
+            else if( choice < 6 )
+            {
+                // Dequeues are more frequent, so the queue keeps emptying out and starting over
+                std::vector<long> out( count );
+                long moved = queue.dequeueRange( out.begin(), count );
+
+                if( !MINMAX_CHECK_EQUAL( aRun, moved, std::min( count, static_cast<long>( reference.size() ) ) )
+                    || !MINMAX_CHECK_STEP( aRun, std::equal( out.begin(), out.begin() + moved, reference.begin() ) ) )
+                {
+                    return;
+                }
+
+                reference.erase( reference.begin(), reference.begin() + moved );
+            }
+            else if( choice == 6 && !reference.empty() )
+            {
+                if( !MINMAX_CHECK_EQUAL( aRun, queue.pop(), reference.front() ) )
+                {
+                    return;
+                }
+
+                reference.pop_front();
+            }
+            else if( !reference.empty() )
+            {
+                queue.dequeue();
+                reference.pop_front();
+            }
+
+            MINMAX_CHECK_EQUAL( aRun, queue.size(), static_cast<long>( reference.size() ) )
+                && ( reference.empty() || MINMAX_CHECK_EQUAL( aRun, queue.peekFront(), reference.front() ) )
+                && MINMAX_CHECK_STEP( aRun, std::equal( reference.begin(), reference.end(), queue.begin() ) );
+        } );
+    }
+}
+
+int main()
+{
+    std::mt19937 random( 2017 );
+    runAgainstReference( 3, random() );
+    runAgainstReference( QNode<long>::CAPACITY + 1, random() );
+    runAgainstReference( 5 * QNode<long>::CAPACITY, random() );
+
+    // The back block is full, so the next item starts a block; its constructor throws
+    Queue<Fragile> queue;
+    const long capacity = QNode<Fragile>::CAPACITY;
+
+    for( long i = 0; i < capacity; i++ )
+    {
+        queue.emplace( i );
+    }
+
+    Fragile::sThrowing = true;
+    MINMAX_CHECK_THROWS( queue.emplace( -1 ) );
+    Fragile::sThrowing = false;
+    MINMAX_CHECK( queue.size() == capacity );
+
+    std::vector<long> values( 2 * capacity, -2 );
+    Fragile::sThrowing = true;
+    MINMAX_CHECK_THROWS( queue.enqueueRange( values.begin(), values.end() ) );
+    Fragile::sThrowing = false;
+    MINMAX_CHECK( queue.size() == capacity );
+
+    while( !queue.isEmpty() )
+    {
+        queue.dequeue();
+    }
+
+    queue.emplace( 42 );
+    MINMAX_CHECK( queue.peekFront().mValue == 42 && queue.size() == 1 );
+    queue.emplace( 43 );
+    MINMAX_CHECK( queue.pop().mValue == 42 && queue.pop().mValue == 43 && queue.isEmpty() );
+
+    queue.clear();
+    MINMAX_CHECK_THROWS( queue.dequeue() );
+    MINMAX_CHECK_THROWS( queue.peekFront() );
+
+    Queue<std::string> words;
+    words.enqueue( "a" );
+    words.enqueue( "b" );
+    Queue<std::string> copy( words );
+    words.pop();
+    MINMAX_CHECK( copy.size() == 2 && copy.peekFront() == "a" && words.peekFront() == "b" );
+
+    return MinMaxTest::report( "QueueTest" );
+}
@@ -0,0 +1,212 @@
+/**
+*	@file : ShardedMinMaxHeap.h
+*	@author :  Haaris Chaudhry
+*	@date : Mar 9, 2017
+*	Purpose: A concurrent double ended priority queue spread over several MinMaxHeap shards, each
+*          behind its own lock and on its own cache lines, so threads working on different shards
+*          never contend.  Inserts go to a random shard.
+*
+*          In RELAXED mode a pop samples two random shards and takes the better of their extremes
+*          (the MultiQueue two-choice rule), so it locks two shards instead of all of them and may
+*          return a value that is close to, but not exactly, the global extreme.  How close is
+*          measured on a sample of the pops and reported by relaxation().  In EXACT mode a pop locks
+*          every shard and always returns the global extreme.
+*/
+
+#ifndef SHARDED_MIN_MAX_HEAP_H
+#define SHARDED_MIN_MAX_HEAP_H
+
+#include "MinMaxHeap.h"
+#include <atomic>
+#include <functional>
+#include <memory>
+#include <mutex>
+
+template <class T, class Compare = std::less<T>, class Allocator = std::allocator<T> >
+class ShardedMinMaxHeap
+{
+public:
+    typedef T value_type;
+    typedef Compare value_compare;
+    typedef Allocator allocator_type;
+
+    /**
+    * How pops choose their shard
+    */
+    enum Mode
+    {
+        RELAXED,    //!< The better of two random shards
+        EXACT       //!< The best of all shards
+    };
+
+    /**
+    * How far relaxed pops strayed from the global extreme, measured on one pop in kSamplePeriod
+    */
+    struct Relaxation
+    {
+        long mSampled;      //!< The number of pops measured
+        long mMissed;       //!< Measured pops that did not return the global extreme
+        long mRankError;    //!< Summed over the measured pops, the shards whose extreme was better
+        long mMaxRankError; //!< The largest rank error of a single measured pop
+
+        /**
+        * @return The average number of shards holding a better value than the one popped
+        */
+        double meanRankError() const;
+    };
+
+    static const long kSamplePeriod = 64;
+
+    /**
+    * Constructor for the ShardedMinMaxHeap
+    * @param aNumShards The number of shards, 0 for twice the number of hardware threads
+    * @param aMode How pops choose their shard
+    * @param aCompare The strict weak ordering used to compare values
+    * @return An empty sharded heap
+    */
+    explicit ShardedMinMaxHeap( long aNumShards = 0, Mode aMode = RELAXED, const Compare& aCompare = Compare() );
+
+    /**
+    * The destructor
+    */
+    ~ShardedMinMaxHeap();
+
+    /**
+    * Inserts a value into a random shard, safe to call from any thread
+    * @param aValue The value to be inserted
+    */
+    void insert( const T& aValue );
+
+    void insert( T&& aValue );
+
+    /**
+    * Deletes the minimum value, or a value close to it in RELAXED mode
+    * @param aValue Receives the deleted value
+    * @return True if a value was deleted, false if every shard was empty
+    */
+    bool tryPopMin( T& aValue );
+
+    /**
+    * Deletes the maximum value, or a value close to it in RELAXED mode
+    * @param aValue Receives the deleted value
+    * @return True if a value was deleted, false if every shard was empty
+    */
+    bool tryPopMax( T& aValue );
+
+    /**
+    * Deletes the minimum value, or a value close to it in RELAXED mode
+    * @return The value that was deleted (throws PrecondViolatedExcep if the heap is empty)
+    */
+    T popMin();
+
+    /**
+    * Deletes the maximum value, or a value close to it in RELAXED mode
+    * @return The value that was deleted (throws PrecondViolatedExcep if the heap is empty)
+    */
+    T popMax();
+
+    /**
+    * @return The number of values, only a snapshot while other threads are inserting or popping
+    */
+    long size() const;
+
+    /**
+    * @return True if every shard was empty when the size was read
+    */
+    bool isEmpty() const;
+
+    /**
+    * @return The number of shards
+    */
+    long numShards() const;
+
+    /**
+    * @return How pops choose their shard
+    */
+    Mode mode() const;
+
+    /**
+    * Changes how pops choose their shard, not to be called while other threads are popping
+    */
+    void setMode( Mode aMode );
+
+    /**
+    * @return How far the measured relaxed pops strayed from the global extreme
+    */
+    Relaxation relaxation() const;
+
+    /**
+    * Zeroes the relaxation measurements
+    */
+    void resetRelaxation();
+
+private:
+    ShardedMinMaxHeap( const ShardedMinMaxHeap& );
+    ShardedMinMaxHeap& operator=( const ShardedMinMaxHeap& );
+
+    /**
+    * One lock and one heap, padded to whole cache lines so neighbouring shards never share one
+    */
+    struct alignas( 64 ) Shard
+    {
+        explicit Shard( const Compare& aCompare );
+
+        std::mutex mLock;                           //!< Guards mHeap
+        MinMaxHeap<T, Compare, Allocator> mHeap;    //!< The values of this shard
+        std::atomic<long> mSize;                    //!< mHeap.size(), readable without the lock
+    };
+
+    /**
+    * Inserts a value into a random shard
+    */
+    template <class U>
+    void push( U&& aValue );
+
+    /**
+    * Deletes from the better of two random shards, falling back to popExact once both are empty
+    */
+    template <bool IsMax>
+    bool popRelaxed( T& aValue );
+
+    /**
+    * Locks every shard in order and deletes the global extreme
+    */
+    template <bool IsMax>
+    bool popExact( T& aValue );
+
+    /**
+    * Counts the shards other than aSkip whose extreme beats aValue, for the relaxation measurements
+    */
+    template <bool IsMax>
+    void measure( const T& aValue, long aSkip );
+
+    /**
+    * @return True if aLeft belongs before aRight at the min (IsMax false) or max (IsMax true) end
+    */
+    template <bool IsMax>
+    bool better( const T& aLeft, const T& aRight ) const;
+
+    /**
+    * @return The extreme of a non-empty shard
+    */
+    template <bool IsMax>
+    static const T& extreme( const Shard& aShard );
+
+    /**
+    * @return A random number from a generator private to the calling thread
+    */
+    static unsigned long random();
+
+    Compare mCompare;                           //!< The ordering of the values
+    long mNumShards;                            //!< The number of shards
+    Mode mMode;                                 //!< How pops choose their shard
+    std::unique_ptr<char[]> mStorage;           //!< The raw memory the shards live in
+    Shard* mShards;                             //!< The shards, 64 byte aligned inside mStorage
+    std::atomic<long> mSampled;                 //!< See Relaxation
+    std::atomic<long> mMissed;
+    std::atomic<long> mRankError;
+    std::atomic<long> mMaxRankError;
+};
+
+#include "ShardedMinMaxHeap.hpp"
+#endif // !SHARDED_MIN_MAX_HEAP_H
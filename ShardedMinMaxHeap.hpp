@@ -0,0 +1,355 @@
+/**
+*	@file : ShardedMinMaxHeap.hpp
+*	@author :  Haaris Chaudhry
+*	@date : Mar 9, 2017
+*	Purpose: Implementation of the ShardedMinMaxHeap class template.
+*/
+
+#include "PrecondViolatedExcep.h"
+#include <cstdint>
+#include <new>
+#include <thread>
+#include <utility>
+
+template <class T, class Compare, class Allocator>
+double ShardedMinMaxHeap<T, Compare, Allocator>::Relaxation::meanRankError() const
+{
+    return ( mSampled == 0 ) ? 0.0 : static_cast<double>( mRankError ) / static_cast<double>( mSampled );
+}
+
+template <class T, class Compare, class Allocator>
+ShardedMinMaxHeap<T, Compare, Allocator>::Shard::Shard( const Compare& aCompare ) :
+    mHeap( 0, aCompare ),
+    mSize( 0 )
+{
+}
+
+// operator new only promises 16 byte alignment before C++17, so the shards are placed by hand
+template <class T, class Compare, class Allocator>
+ShardedMinMaxHeap<T, Compare, Allocator>::ShardedMinMaxHeap( long aNumShards, Mode aMode, const Compare& aCompare ) :
+    mCompare( aCompare ),
+    mNumShards( aNumShards ),
+    mMode( aMode ),
+    mShards( nullptr ),
+    mSampled( 0 ),
+    mMissed( 0 ),
+    mRankError( 0 ),
+    mMaxRankError( 0 )
+{
+    if( mNumShards <= 0 )
+    {
+        long threads = static_cast<long>( std::thread::hardware_concurrency() );
+        mNumShards = 2 * ( threads > 0 ? threads : 1 );
+    }
+
+    std::size_t bytes = static_cast<std::size_t>( mNumShards ) * sizeof( Shard );
+    std::size_t space = bytes + alignof( Shard );
+    mStorage.reset( new char[space] );
+    void* first = mStorage.get();
+    mShards = static_cast<Shard*>( std::align( alignof( Shard ), bytes, first, space ) );
+
+    long constructed = 0;
+
+    try
+    {
+        for( ; constructed < mNumShards; constructed++ )
+        {
+            new( mShards + constructed ) Shard( mCompare );
+        }
+    }
+    catch( ... )
+    {
+        while( constructed > 0 )
+        {
+            mShards[--constructed].~Shard();
+        }
+
+        throw;
+    }
+}
+
+template <class T, class Compare, class Allocator>
+ShardedMinMaxHeap<T, Compare, Allocator>::~ShardedMinMaxHeap()
+{
+    for( long i = 0; i < mNumShards; i++ )
+    {
+        mShards[i].~Shard();
+    }
+}
+
+template <class T, class Compare, class Allocator>
+void ShardedMinMaxHeap<T, Compare, Allocator>::insert( const T& aValue )
+{
+    push( aValue );
+}
+
+template <class T, class Compare, class Allocator>
+void ShardedMinMaxHeap<T, Compare, Allocator>::insert( T&& aValue )
+{
+    push( std::move( aValue ) );
+}
+
+template <class T, class Compare, class Allocator>
+template <class U>
+void ShardedMinMaxHeap<T, Compare, Allocator>::push( U&& aValue )
+{
+    Shard& shard = mShards[random() % static_cast<unsigned long>( mNumShards )];
+    std::lock_guard<std::mutex> lock( shard.mLock );
+    shard.mHeap.insert( std::forward<U>( aValue ) );
+    shard.mSize.store( shard.mHeap.size(), std::memory_order_relaxed );
+}
+
+template <class T, class Compare, class Allocator>
+bool ShardedMinMaxHeap<T, Compare, Allocator>::tryPopMin( T& aValue )
+{
+    return ( mMode == EXACT ) ? popExact<false>( aValue ) : popRelaxed<false>( aValue );
+}
+
+template <class T, class Compare, class Allocator>
+bool ShardedMinMaxHeap<T, Compare, Allocator>::tryPopMax( T& aValue )
+{
+    return ( mMode == EXACT ) ? popExact<true>( aValue ) : popRelaxed<true>( aValue );
+}
+
+template <class T, class Compare, class Allocator>
+T ShardedMinMaxHeap<T, Compare, Allocator>::popMin()
+{
+    T value;
+
+    if( !tryPopMin( value ) )
+    {
+        throw PrecondViolatedExcep( "popMin attempted on an empty heap" );
+    }
+
+    return value;
+}
+
+template <class T, class Compare, class Allocator>
+T ShardedMinMaxHeap<T, Compare, Allocator>::popMax()
+{
+    T value;
+
+    if( !tryPopMax( value ) )
+    {
+        throw PrecondViolatedExcep( "popMax attempted on an empty heap" );
+    }
+
+    return value;
+}
+
+// Two distinct shards are locked together (std::lock cannot deadlock) and the better extreme wins.
+// Picks that turn out empty are retried a few times, after which only a full scan can tell whether
+// the whole heap is empty.
+template <class T, class Compare, class Allocator>
+template <bool IsMax>
+bool ShardedMinMaxHeap<T, Compare, Allocator>::popRelaxed( T& aValue )
+{
+    if( mNumShards == 1 )
+    {
+        return popExact<IsMax>( aValue );
+    }
+
+    unsigned long numShards = static_cast<unsigned long>( mNumShards );
+
+    for( int attempt = 0; attempt < 4; attempt++ )
+    {
+        long first = static_cast<long>( random() % numShards );
+        long second = static_cast<long>( ( first + 1 + random() % ( numShards - 1 ) ) % numShards );
+
+        if( mShards[first].mSize.load( std::memory_order_relaxed ) == 0 && mShards[second].mSize.load( std::memory_order_relaxed ) == 0 )
+        {
+            continue;
+        }
+
+        std::unique_lock<std::mutex> firstLock( mShards[first].mLock, std::defer_lock );
+        std::unique_lock<std::mutex> secondLock( mShards[second].mLock, std::defer_lock );
+        std::lock( firstLock, secondLock );
+
+        long chosen = first;
+
+        if( mShards[first].mHeap.isEmpty() || ( !mShards[second].mHeap.isEmpty() && better<IsMax>( extreme<IsMax>( mShards[second] ), extreme<IsMax>( mShards[first] ) ) ) )
+        {
+            chosen = second;
+        }
+
+        Shard& shard = mShards[chosen];
+
+        if( shard.mHeap.isEmpty() )
+        {
+            continue;
+        }
+
+        aValue = IsMax ? shard.mHeap.deleteMax() : shard.mHeap.deleteMin();
+        shard.mSize.store( shard.mHeap.size(), std::memory_order_relaxed );
+        firstLock.unlock();
+        secondLock.unlock();
+
+        if( random() % kSamplePeriod == 0 )
+        {
+            measure<IsMax>( aValue, chosen );
+        }
+
+        return true;
+    }
+
+    return popExact<IsMax>( aValue );
+}
+
+// Every shard is locked in index order, so exact pops never deadlock with each other
+template <class T, class Compare, class Allocator>
+template <bool IsMax>
+bool ShardedMinMaxHeap<T, Compare, Allocator>::popExact( T& aValue )
+{
+    long best = -1;
+
+    for( long i = 0; i < mNumShards; i++ )
+    {
+        mShards[i].mLock.lock();
+
+        if( !mShards[i].mHeap.isEmpty() && ( best < 0 || better<IsMax>( extreme<IsMax>( mShards[i] ), extreme<IsMax>( mShards[best] ) ) ) )
+        {
+            best = i;
+        }
+    }
+
+    if( best >= 0 )
+    {
+        Shard& shard = mShards[best];
+        aValue = IsMax ? shard.mHeap.deleteMax() : shard.mHeap.deleteMin();
+        shard.mSize.store( shard.mHeap.size(), std::memory_order_relaxed );
+    }
+
+    for( long i = mNumShards - 1; i >= 0; i-- )
+    {
+        mShards[i].mLock.unlock();
+    }
+
+    return ( best >= 0 );
+}
+
+// The other shards are visited one at a time after the pop, so the count is a close estimate of the
+// error at the moment of the pop rather than an exact one
+template <class T, class Compare, class Allocator>
+template <bool IsMax>
+void ShardedMinMaxHeap<T, Compare, Allocator>::measure( const T& aValue, long aSkip )
+{
+    long rankError = 0;
+
+    for( long i = 0; i < mNumShards; i++ )
+    {
+        if( i == aSkip )
+        {
+            continue;
+        }
+
+        std::lock_guard<std::mutex> lock( mShards[i].mLock );
+
+        if( !mShards[i].mHeap.isEmpty() && better<IsMax>( extreme<IsMax>( mShards[i] ), aValue ) )
+        {
+            rankError++;
+        }
+    }
+
+    mSampled.fetch_add( 1, std::memory_order_relaxed );
+    mRankError.fetch_add( rankError, std::memory_order_relaxed );
+
+    if( rankError > 0 )
+    {
+        mMissed.fetch_add( 1, std::memory_order_relaxed );
+    }
+
+    long largest = mMaxRankError.load( std::memory_order_relaxed );
+
+    while( rankError > largest && !mMaxRankError.compare_exchange_weak( largest, rankError, std::memory_order_relaxed ) )
+    {
+    }
+}
+
+template <class T, class Compare, class Allocator>
+template <bool IsMax>
+bool ShardedMinMaxHeap<T, Compare, Allocator>::better( const T& aLeft, const T& aRight ) const
+{
+    return IsMax ? mCompare( aRight, aLeft ) : mCompare( aLeft, aRight );
+}
+
+template <class T, class Compare, class Allocator>
+template <bool IsMax>
+const T& ShardedMinMaxHeap<T, Compare, Allocator>::extreme( const Shard& aShard )
+{
+    return IsMax ? aShard.mHeap.peekMax() : aShard.mHeap.peekMin();
+}
+
+// xorshift64*, seeded per thread from the thread's id and the address of its state
+template <class T, class Compare, class Allocator>
+unsigned long ShardedMinMaxHeap<T, Compare, Allocator>::random()
+{
+    static thread_local unsigned long long state = 0;
+
+    if( state == 0 )
+    {
+        state = static_cast<unsigned long long>( std::hash<std::thread::id>()( std::this_thread::get_id() ) );
+        state ^= static_cast<unsigned long long>( reinterpret_cast<std::uintptr_t>( &state ) ) | 1;
+    }
+
+    state ^= state >> 12;
+    state ^= state << 25;
+    state ^= state >> 27;
+    return static_cast<unsigned long>( ( state * 2685821657736338717ULL ) >> 32 );
+}
+
+template <class T, class Compare, class Allocator>
+long ShardedMinMaxHeap<T, Compare, Allocator>::size() const
+{
+    long total = 0;
+
+    for( long i = 0; i < mNumShards; i++ )
+    {
+        total += mShards[i].mSize.load( std::memory_order_relaxed );
+    }
+
+    return total;
+}
+
+template <class T, class Compare, class Allocator>
+bool ShardedMinMaxHeap<T, Compare, Allocator>::isEmpty() const
+{
+    return ( size() == 0 );
+}
+
+template <class T, class Compare, class Allocator>
+long ShardedMinMaxHeap<T, Compare, Allocator>::numShards() const
+{
+    return mNumShards;
+}
+
+template <class T, class Compare, class Allocator>
+typename ShardedMinMaxHeap<T, Compare, Allocator>::Mode ShardedMinMaxHeap<T, Compare, Allocator>::mode() const
+{
+    return mMode;
+}
+
+template <class T, class Compare, class Allocator>
+void ShardedMinMaxHeap<T, Compare, Allocator>::setMode( Mode aMode )
+{
+    mMode = aMode;
+}
+
+template <class T, class Compare, class Allocator>
+typename ShardedMinMaxHeap<T, Compare, Allocator>::Relaxation ShardedMinMaxHeap<T, Compare, Allocator>::relaxation() const
+{
+    Relaxation relaxation;
+    relaxation.mSampled = mSampled.load( std::memory_order_relaxed );
+    relaxation.mMissed = mMissed.load( std::memory_order_relaxed );
+    relaxation.mRankError = mRankError.load( std::memory_order_relaxed );
+    relaxation.mMaxRankError = mMaxRankError.load( std::memory_order_relaxed );
+    return relaxation;
+}
+
+template <class T, class Compare, class Allocator>
+void ShardedMinMaxHeap<T, Compare, Allocator>::resetRelaxation()
+{
+    mSampled.store( 0, std::memory_order_relaxed );
+    mMissed.store( 0, std::memory_order_relaxed );
+    mRankError.store( 0, std::memory_order_relaxed );
+    mMaxRankError.store( 0, std::memory_order_relaxed );
+}
@@ -0,0 +1,193 @@
+/**
+*	@file : SmallMinMaxHeap.h
+*	@author :  Haaris Chaudhry
+*	@date : Mar 9, 2017
+*	Purpose: A min-max heap of at most N values kept inside the object itself, for the many tiny
+*          heaps that live on the stack or inside other objects.  It never allocates, copying it
+*          copies the array, and because the depth of the tree is known at compile time the sift
+*          routines are unrolled into straight line code with one early exit per level pair instead
+*          of loops over a heap array reached through a pointer.
+*
+*          The N slots are always alive, so T has to be default constructible.  A deleted value's
+*          slot keeps the moved-from value until the slot is reused or the heap is cleared.
+*          The constructor, size, isEmpty, isFull, capacity and peekMin are constexpr.
+*/
+
+#ifndef SMALL_MIN_MAX_HEAP_H
+#define SMALL_MIN_MAX_HEAP_H
+
+#include "MinMaxHeapEngine.h"
+#include "PrecondViolatedExcep.h"
+#include <functional>
+#include <type_traits>
+#include <utility>
+
+template <class T, long N, class Compare = std::less<T> >
+class SmallMinMaxHeap
+{
+public:
+    typedef T value_type;
+    typedef Compare value_compare;
+
+    static_assert( N >= 1, "A SmallMinMaxHeap holds at least one value" );
+
+    /**
+    * Constructor for the SmallMinMaxHeap
+    * @param aCompare The strict weak ordering used to compare values
+    * @return An empty heap
+    */
+    constexpr explicit SmallMinMaxHeap( const Compare& aCompare = Compare() );
+
+    /**
+    * Constructor for the SmallMinMaxHeap, copies an array and heapifies it bottom up
+    * @param values an array of values to be inserted into the heap
+    * @param valuesSize the size of the array, at most N (throws PrecondViolatedExcep otherwise)
+    * @param aCompare The strict weak ordering used to compare values
+    * @return A heap containing the values in values
+    */
+    SmallMinMaxHeap( const T values[], long valuesSize, const Compare& aCompare = Compare() );
+
+    /**
+    * The insertion function, also heapifies the value
+    * @param aValue The value to be inserted (throws PrecondViolatedExcep if the heap is full)
+    */
+    void insert( const T& aValue );
+
+    void insert( T&& aValue );
+
+    /**
+    * Deletes the minimum value
+    * @return The value that was deleted (throws PrecondViolatedExcep if the heap is empty)
+    */
+    T deleteMin();
+
+    /**
+    * Deletes the maximum value
+    * @return The value that was deleted (throws PrecondViolatedExcep if the heap is empty)
+    */
+    T deleteMax();
+
+    /**
+    * Reads the minimum value without removing it
+    * @return The minimum value (throws PrecondViolatedExcep if the heap is empty)
+    */
+    constexpr const T& peekMin() const;
+
+    /**
+    * Reads the maximum value without removing it
+    * @return The maximum value (throws PrecondViolatedExcep if the heap is empty)
+    */
+    const T& peekMax() const;
+
+    /**
+    * Function that indicates if the heap is empty
+    * @return True if empty, false if not
+    */
+    constexpr bool isEmpty() const;
+
+    /**
+    * @return True if the heap holds N values and the next insert would throw
+    */
+    constexpr bool isFull() const;
+
+    /**
+    * @return The number of values in the heap
+    */
+    constexpr long size() const;
+
+    /**
+    * @return The most values the heap can hold, N
+    */
+    static constexpr long capacity();
+
+    /**
+    * Removes every value, each slot is reset to a default constructed T
+    */
+    void clear();
+
+private:
+    /**
+    * @return The number of levels of a tree of aNumNodes nodes
+    */
+    static constexpr int levels( long aNumNodes );
+
+    /**
+    * @return The most steps a hole can take up or down the tree, each step moves it one or two levels
+    */
+    static constexpr int steps();
+
+    typedef std::integral_constant<int, 0> NoSteps;
+
+    template <int Steps>
+    using StepsLeft = std::integral_constant<int, Steps>;
+
+    /**
+    * Accesses a value by its heap index (the root is at index 1)
+    */
+    T& at( long aIndex );
+    const T& at( long aIndex ) const;
+
+    /**
+    * Orders two values for a min level (IsMax false) or a max level (IsMax true)
+    * @return True if aLeft belongs above aRight on that kind of level
+    */
+    template <bool IsMax>
+    bool precedes( const T& aLeft, const T& aRight ) const;
+
+    /**
+    * @return The child or grandchild of aIndex that belongs highest on aIndex's kind of level
+    */
+    template <bool IsMax>
+    long extremeDescendant( long aIndex ) const;
+
+    /**
+    * @return The index of the maximum
+    */
+    long maxIndex() const;
+
+    /**
+    * Appends a value and bubbles it up
+    */
+    template <class U>
+    void push( U&& aValue );
+
+    /**
+    * Removes the value at aIndex (the root or the maximum) and fills its slot from the end of the heap
+    */
+    T removeAt( long aIndex );
+
+    /**
+    * Fills the hole at aHole with aHeld, moving it down through the heap to its proper spot
+    */
+    void trickleDownHole( long aHole, T& aHeld );
+
+    /**
+    * One step of a trickle down per instantiation, Steps counts the steps that are still allowed
+    */
+    template <bool IsMax, int Steps>
+    void trickleDownLevel( long aHole, T& aHeld, StepsLeft<Steps> );
+
+    template <bool IsMax>
+    void trickleDownLevel( long aHole, T& aHeld, NoSteps );
+
+    /**
+    * One grandparent climbed per instantiation
+    */
+    template <bool IsMax, int Steps>
+    void bubbleUpLevel( long aHole, T& aHeld, StepsLeft<Steps> );
+
+    template <bool IsMax>
+    void bubbleUpLevel( long aHole, T& aHeld, NoSteps );
+
+    /**
+    * Moves the last value up the heap to its proper spot
+    */
+    void bubbleUp();
+
+    Compare mCompare;   //!< The ordering of the heap values
+    T mValues[N];       //!< The heap, heap index i lives in slot i - 1
+    long mNumNodes;     //!< The number of values in the heap
+};
+
+#include "SmallMinMaxHeap.hpp"
+#endif // !SMALL_MIN_MAX_HEAP_H
@@ -0,0 +1,362 @@
+/**
+*	@file : SmallMinMaxHeap.hpp
+*	@author :  Haaris Chaudhry
+*	@date : Mar 9, 2017
+*	Purpose: Implementation of the SmallMinMaxHeap class template.
+*/
+
+template <class T, long N, class Compare>
+constexpr SmallMinMaxHeap<T, N, Compare>::SmallMinMaxHeap( const Compare& aCompare ) :
+    mCompare( aCompare ),
+    mValues(),
+    mNumNodes( 0 )
+{
+}
+
+// Copy the values in, then trickle down every parent starting from the last one
+template <class T, long N, class Compare>
+SmallMinMaxHeap<T, N, Compare>::SmallMinMaxHeap( const T values[], long valuesSize, const Compare& aCompare ) :
+    mCompare( aCompare ),
+    mValues(),
+    mNumNodes( 0 )
+{
+    if( valuesSize > N )
+    {
+        throw PrecondViolatedExcep( "SmallMinMaxHeap constructed with more values than its capacity" );
+    }
+
+    for( long i = 0; i < valuesSize; i++ )
+    {
+        mValues[i] = values[i];
+    }
+
+    mNumNodes = valuesSize;
+
+    for( long i = mNumNodes / 2; i >= 1; i-- )
+    {
+        T held = std::move( at( i ) );
+        trickleDownHole( i, held );
+    }
+}
+
+template <class T, long N, class Compare>
+constexpr int SmallMinMaxHeap<T, N, Compare>::levels( long aNumNodes )
+{
+    return ( aNumNodes == 0 ) ? 0 : 1 + levels( aNumNodes >> 1 );
+}
+
+// From the root a hole reaches the last level, levels( N ) - 1, in this many grandchild steps
+template <class T, long N, class Compare>
+constexpr int SmallMinMaxHeap<T, N, Compare>::steps()
+{
+    return levels( N ) / 2;
+}
+
+template <class T, long N, class Compare>
+constexpr long SmallMinMaxHeap<T, N, Compare>::capacity()
+{
+    return N;
+}
+
+template <class T, long N, class Compare>
+constexpr bool SmallMinMaxHeap<T, N, Compare>::isEmpty() const
+{
+    return ( mNumNodes == 0 );
+}
+
+template <class T, long N, class Compare>
+constexpr bool SmallMinMaxHeap<T, N, Compare>::isFull() const
+{
+    return ( mNumNodes == N );
+}
+
+template <class T, long N, class Compare>
+constexpr long SmallMinMaxHeap<T, N, Compare>::size() const
+{
+    return mNumNodes;
+}
+
+template <class T, long N, class Compare>
+constexpr const T& SmallMinMaxHeap<T, N, Compare>::peekMin() const
+{
+    return ( mNumNodes == 0 ) ? throw PrecondViolatedExcep( "peekMin attempted on an empty heap" ) : mValues[0];
+}
+
+template <class T, long N, class Compare>
+const T& SmallMinMaxHeap<T, N, Compare>::peekMax() const
+{
+    if( isEmpty() )
+    {
+        throw PrecondViolatedExcep( "peekMax attempted on an empty heap" );
+    }
+
+    return at( maxIndex() );
+}
+
+template <class T, long N, class Compare>
+void SmallMinMaxHeap<T, N, Compare>::clear()
+{
+    for( long i = 0; i < mNumNodes; i++ )
+    {
+        mValues[i] = T();
+    }
+
+    mNumNodes = 0;
+}
+
+template <class T, long N, class Compare>
+void SmallMinMaxHeap<T, N, Compare>::insert( const T& aValue )
+{
+    push( aValue );
+}
+
+template <class T, long N, class Compare>
+void SmallMinMaxHeap<T, N, Compare>::insert( T&& aValue )
+{
+    push( std::move( aValue ) );
+}
+
+template <class T, long N, class Compare>
+template <class U>
+void SmallMinMaxHeap<T, N, Compare>::push( U&& aValue )
+{
+    if( isFull() )
+    {
+        throw PrecondViolatedExcep( "insert attempted on a full heap" );
+    }
+
+    mValues[mNumNodes] = std::forward<U>( aValue );
+    mNumNodes++;
+    bubbleUp();
+}
+
+template <class T, long N, class Compare>
+T SmallMinMaxHeap<T, N, Compare>::deleteMin()
+{
+    if( isEmpty() )
+    {
+        throw PrecondViolatedExcep( "deleteMin attempted on an empty heap" );
+    }
+
+    return removeAt( 1 );
+}
+
+template <class T, long N, class Compare>
+T SmallMinMaxHeap<T, N, Compare>::deleteMax()
+{
+    if( isEmpty() )
+    {
+        throw PrecondViolatedExcep( "deleteMax attempted on an empty heap" );
+    }
+
+    return removeAt( maxIndex() );
+}
+
+// The last value is carried straight into the hole left at aIndex
+template <class T, long N, class Compare>
+T SmallMinMaxHeap<T, N, Compare>::removeAt( long aIndex )
+{
+    T removedValue = std::move( at( aIndex ) );
+
+    if( aIndex != mNumNodes )
+    {
+        T lastValue = std::move( at( mNumNodes ) );
+        mNumNodes--;
+        trickleDownHole( aIndex, lastValue );
+    }
+    else
+    {
+        mNumNodes--;
+    }
+
+    return removedValue;
+}
+
+template <class T, long N, class Compare>
+T& SmallMinMaxHeap<T, N, Compare>::at( long aIndex )
+{
+    return mValues[aIndex - 1];
+}
+
+template <class T, long N, class Compare>
+const T& SmallMinMaxHeap<T, N, Compare>::at( long aIndex ) const
+{
+    return mValues[aIndex - 1];
+}
+
+template <class T, long N, class Compare>
+template <bool IsMax>
+bool SmallMinMaxHeap<T, N, Compare>::precedes( const T& aLeft, const T& aRight ) const
+{
+    return IsMax ? mCompare( aRight, aLeft ) : mCompare( aLeft, aRight );
+}
+
+// With all four grandchildren present the scan is a fixed tournament of five comparisons. The winners
+// are picked arithmetically rather than with branches, which mispredict half the time on random keys.
+// The edge of the heap falls back to a bounded loop.
+template <class T, long N, class Compare>
+template <bool IsMax>
+long SmallMinMaxHeap<T, N, Compare>::extremeDescendant( long aIndex ) const
+{
+    long first = 4 * aIndex;
+
+    if( first + 3 <= mNumNodes )
+    {
+        long left = first + precedes<IsMax>( at( first + 1 ), at( first ) );
+        long right = first + 2 + precedes<IsMax>( at( first + 3 ), at( first + 2 ) );
+        long grandchild = left + ( right - left ) * precedes<IsMax>( at( right ), at( left ) );
+        long child = 2 * aIndex + precedes<IsMax>( at( 2 * aIndex + 1 ), at( 2 * aIndex ) );
+        return child + ( grandchild - child ) * precedes<IsMax>( at( grandchild ), at( child ) );
+    }
+
+    long best = 2 * aIndex;
+
+    if( best + 1 <= mNumNodes && precedes<IsMax>( at( best + 1 ), at( best ) ) )
+    {
+        best++;
+    }
+
+    for( long i = first; i <= mNumNodes; i++ )
+    {
+        if( precedes<IsMax>( at( i ), at( best ) ) )
+        {
+            best = i;
+        }
+    }
+
+    return best;
+}
+
+template <class T, long N, class Compare>
+long SmallMinMaxHeap<T, N, Compare>::maxIndex() const
+{
+    if( mNumNodes <= 2 )
+    {
+        return mNumNodes;
+    }
+
+    return mCompare( at( 3 ), at( 2 ) ) ? 2 : 3;
+}
+
+template <class T, long N, class Compare>
+void SmallMinMaxHeap<T, N, Compare>::trickleDownHole( long aHole, T& aHeld )
+{
+    if( MinMaxHeapEngine::isMinLevel( aHole ) )
+    {
+        trickleDownLevel<false>( aHole, aHeld, StepsLeft<steps()>() );
+    }
+    else
+    {
+        trickleDownLevel<true>( aHole, aHeld, StepsLeft<steps()>() );
+    }
+}
+
+// The same step as MinMaxHeapEngine::trickleDownLevel. Every instantiation is one step, so the whole
+// trickle down inlines into steps() copies with no loop
+template <class T, long N, class Compare>
+template <bool IsMax, int Steps>
+void SmallMinMaxHeap<T, N, Compare>::trickleDownLevel( long aHole, T& aHeld, StepsLeft<Steps> )
+{
+    if( 2 * aHole > mNumNodes )
+    {
+        at( aHole ) = std::move( aHeld );
+        return;
+    }
+
+    long m = extremeDescendant<IsMax>( aHole );
+
+    if( !precedes<IsMax>( at( m ), aHeld ) )
+    {
+        at( aHole ) = std::move( aHeld );
+        return;
+    }
+
+    at( aHole ) = std::move( at( m ) );
+
+    if( m < 4 * aHole )
+    {
+        at( m ) = std::move( aHeld );      // A child has no descendants on our kind of level
+        return;
+    }
+
+    long parentIndexOfM = m >> 1;
+
+    if( precedes<IsMax>( at( parentIndexOfM ), aHeld ) )
+    {
+        std::swap( at( parentIndexOfM ), aHeld );
+    }
+
+    trickleDownLevel<IsMax>( m, aHeld, StepsLeft<Steps - 1>() );
+}
+
+// Out of steps, the hole is on the last level
+template <class T, long N, class Compare>
+template <bool IsMax>
+void SmallMinMaxHeap<T, N, Compare>::trickleDownLevel( long aHole, T& aHeld, NoSteps )
+{
+    at( aHole ) = std::move( aHeld );
+}
+
+template <class T, long N, class Compare>
+template <bool IsMax, int Steps>
+void SmallMinMaxHeap<T, N, Compare>::bubbleUpLevel( long aHole, T& aHeld, StepsLeft<Steps> )
+{
+    if( aHole <= 3 || !precedes<IsMax>( aHeld, at( aHole >> 2 ) ) )
+    {
+        at( aHole ) = std::move( aHeld );
+        return;
+    }
+
+    at( aHole ) = std::move( at( aHole >> 2 ) );
+    bubbleUpLevel<IsMax>( aHole >> 2, aHeld, StepsLeft<Steps - 1>() );
+}
+
+template <class T, long N, class Compare>
+template <bool IsMax>
+void SmallMinMaxHeap<T, N, Compare>::bubbleUpLevel( long aHole, T& aHeld, NoSteps )
+{
+    at( aHole ) = std::move( aHeld );
+}
+
+// The same decision as MinMaxHeapEngine::bubbleUp, the value is only taken out if it has to move
+template <class T, long N, class Compare>
+void SmallMinMaxHeap<T, N, Compare>::bubbleUp()
+{
+    long index = mNumNodes;
+
+    if( index <= 1 )
+    {
+        return;
+    }
+
+    long parentIndex = index >> 1;
+    bool minLevel = MinMaxHeapEngine::isMinLevel( index );
+
+    if( minLevel ? mCompare( at( parentIndex ), at( index ) ) : mCompare( at( index ), at( parentIndex ) ) )
+    {
+        T held = std::move( at( index ) );
+        at( index ) = std::move( at( parentIndex ) );
+
+        if( minLevel )
+        {
+            bubbleUpLevel<true>( parentIndex, held, StepsLeft<steps()>() );
+        }
+        else
+        {
+            bubbleUpLevel<false>( parentIndex, held, StepsLeft<steps()>() );
+        }
+    }
+    else if( index > 3 && ( minLevel ? mCompare( at( index ), at( index >> 2 ) ) : mCompare( at( index >> 2 ), at( index ) ) ) )
+    {
+        T held = std::move( at( index ) );
+
+        if( minLevel )
+        {
+            bubbleUpLevel<false>( index, held, StepsLeft<steps()>() );
+        }
+        else
+        {
+            bubbleUpLevel<true>( index, held, StepsLeft<steps()>() );
+        }
+    }
+}
@@ -0,0 +1,131 @@
+/**
+*	@file : SmallMinMaxHeapTest.cpp
+*	@author :  Haaris Chaudhry
+*	@date : Mar 9, 2017
+*	Purpose: Checks SmallMinMaxHeap against a std::multiset for N = 1, 2, 7, 64 and 100, whose trees
+*          end on a single level, a full level, and part way through one.  Random inserts run the heap
+*          up to full and deletes from both ends run it back down to empty; the array constructor is
+*          checked at every size up to N, and the constexpr members are checked at compile time.
+*/
+
+#include "SmallMinMaxHeap.h"
+#include "MinMaxTest.h"
+#include <functional>
+#include <random>
+#include <set>
+#include <string>
+#include <vector>
+
+namespace
+{
+    constexpr SmallMinMaxHeap<long, 7> kEmpty{};
+    static_assert( kEmpty.isEmpty() && !kEmpty.isFull() && kEmpty.size() == 0, "A new SmallMinMaxHeap is empty" );
+    static_assert( SmallMinMaxHeap<long, 7>::capacity() == 7 && SmallMinMaxHeap<long, 1>::capacity() == 1, "capacity() is N" );
+    static_assert( SmallMinMaxHeap<long, 1, std::greater<long> >().size() == 0, "The constructor is constexpr for any ordering" );
+
+    template <long N, class Compare>
+    void runAgainstReference( long aRange, unsigned long aSeed )
+    {
+        typedef SmallMinMaxHeap<long, N, Compare> Heap;
+        Heap heap;
+        std::multiset<long, Compare> reference;
+
+        MinMaxTest::runSteps( "N " + std::to_string( N ) + ", range " + std::to_string( aRange ), aSeed, 20 * N + 200, [&]( std::mt19937& aRandom, const MinMaxTest::Run& aRun )
+        {
+            // Runs of inserts alternate with runs of deletes, so the heap keeps filling and emptying
+            bool inserting = ( aRun.mOp / ( N + 3 ) ) % 2 == 0;
+            long value = static_cast<long>( aRandom() % aRange );
+
+            if( inserting )
+            {
+                if( reference.size() == static_cast<size_t>( N ) )
+                {
+                    if( !MINMAX_CHECK_STEP( aRun, heap.isFull() ) )
+                    {
+                        return;
+                    }
+
+                    MINMAX_CHECK_THROWS( heap.insert( value ) );
+                }
+                else
+                {
+                    heap.insert( value );
+                    reference.insert( value );
+                }
+            }
+            else if( reference.empty() )
+            {
+                MINMAX_CHECK_THROWS( heap.deleteMin() );
+                MINMAX_CHECK_THROWS( heap.deleteMax() );
+                MINMAX_CHECK_THROWS( heap.peekMin() );
+                MINMAX_CHECK_THROWS( heap.peekMax() );
+            }
+            else if( !MINMAX_CHECK_DELETE( aRun, heap, reference, aRandom() % 2 == 0 ) )
+            {
+                return;
+            }
+
+            MINMAX_CHECK_ENDS( aRun, heap, reference ) && MINMAX_CHECK_EQUAL( aRun, heap.isFull(), reference.size() == static_cast<size_t>( N ) );
+        } );
+
+        // A copy owns its own array
+        Heap copy( heap );
+        heap.clear();
+        MINMAX_CHECK( heap.isEmpty() && copy.size() == static_cast<long>( reference.size() ) );
+    }
+
+    template <long N>
+    void checkArrayConstructor( std::mt19937& aRandom )
+    {
+        std::vector<long> values( N + 1 );
+
+        for( long i = 0; i <= N; i++ )
+        {
+            values[i] = static_cast<long>( aRandom() % 50 );
+        }
+
+        for( long count = 0; count <= N; count++ )
+        {
+            SmallMinMaxHeap<long, N> heap( values.data(), count );
+            std::multiset<long> reference( values.begin(), values.begin() + count );
+            MinMaxTest::Run run( "array of " + std::to_string( count ) + ", N " + std::to_string( N ), 0 );
+
+            for( bool isMax = false; !reference.empty(); isMax = !isMax )
+            {
+                if( !MINMAX_CHECK_ENDS( run, heap, reference ) || !MINMAX_CHECK_DELETE( run, heap, reference, isMax ) )
+                {
+                    break;
+                }
+            }
+
+            MINMAX_CHECK( heap.isEmpty() );
+        }
+
+        MINMAX_CHECK_THROWS( ( SmallMinMaxHeap<long, N>( values.data(), N + 1 ) ) );
+    }
+}
+
+int main()
+{
+    std::mt19937 random( 2017 );
+    const long ranges[] = { 1L << 30, 10, 2 };
+
+    for( size_t r = 0; r < sizeof( ranges ) / sizeof( ranges[0] ); r++ )
+    {
+        runAgainstReference<1, std::less<long> >( ranges[r], random() );
+        runAgainstReference<2, std::less<long> >( ranges[r], random() );
+        runAgainstReference<7, std::less<long> >( ranges[r], random() );
+        runAgainstReference<64, std::less<long> >( ranges[r], random() );
+        runAgainstReference<100, std::less<long> >( ranges[r], random() );
+        runAgainstReference<7, std::greater<long> >( ranges[r], random() );
+        runAgainstReference<100, std::greater<long> >( ranges[r], random() );
+    }
+
+    checkArrayConstructor<1>( random );
+    checkArrayConstructor<2>( random );
+    checkArrayConstructor<7>( random );
+    checkArrayConstructor<64>( random );
+    checkArrayConstructor<100>( random );
+
+    return MinMaxTest::report( "SmallMinMaxHeapTest" );
+}
@@ -0,0 +1,979 @@
+/**
+*	@file : bench.cpp
+*	@author :  Haaris Chaudhry
+*	@date : Mar 9, 2017
+*	Purpose: Microbenchmarks for MinMaxHeap against the two standard ways of getting a double ended
+*          priority queue: a pair of std::priority_queue (a min heap and a max heap that lazily skip
+*          the values deleted through the other one) and a std::multiset.
+*
+*          Every operation is timed on random, sorted, reverse sorted and duplicate heavy keys, at sizes
+*          from L1 resident to well beyond the last level cache.  Small sizes are repeated so each
+*          measurement runs long enough to time.  Results are nanoseconds per value.
+*
+*          The tables that follow, in the order they are printed:
+*
+*          The binary MinMaxHeap against MinMaxDaryHeap at arity 4 and 8, on random keys.
+*
+*          MinMaxHeap over each MinMaxStorage backend.
+*
+*          The sharded and flat combining containers against one MinMaxHeap behind a mutex, with every
+*          thread inserting and popping from both ends, in millions of operations per second.
+*
+*          The two MinMaxHeap engines, the min-max heap and the interval heap, on every kind of key.
+*
+*          Tiny short lived heaps, a fresh MinMaxHeap per round against a SmallMinMaxHeap on the stack.
+*
+*          30% of the values cancelled by key before the rest are drained, LazyEraseMinMaxHeap against
+*          the pq pair and the multiset, on random keys.
+*
+*          Keys that carry a 48 byte payload, KeyedMinMaxHeap's parallel arrays against a MinMaxHeap of
+*          56 byte structs, one insert and one deleteMin per entry.
+*
+*          Usage: minmaxbench [largest size]     (make bench builds and runs it)
+*/
+
+#include "FlatCombiningMinMaxHeap.h"
+#include "KeyedMinMaxHeap.h"
+#include "LazyEraseMinMaxHeap.h"
+#include "MinMaxDaryHeap.h"
+#include "MinMaxHeap.h"
+#include "MinMaxHeapView.h"
+#include "MinMaxIntervalEngine.h"
+#include "MinMaxStorage.h"
+#include "ShardedMinMaxHeap.h"
+#include "SmallMinMaxHeap.h"
+#include <algorithm>
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <functional>
+#include <iterator>
+#include <mutex>
+#include <queue>
+#include <random>
+#include <set>
+#include <string>
+#include <thread>
+#include <unordered_map>
+#include <vector>
+
+namespace
+{
+    const long kMinValuesPerRun = 1L << 21;     // Small sizes are repeated until this many values were timed
+    long sChecksum = 0;                         // Keeps the compiler from dropping unused results
+
+    /**
+    * The heap under test, with the bottom up insertRange as its build
+    */
+    class MinMaxHeapAdapter
+    {
+    public:
+        static const char* name() { return "MinMaxHeap"; }
+        void build( const std::vector<long>& aValues ) { mHeap.insertRange( aValues.begin(), aValues.end() ); }
+        void insert( long aValue ) { mHeap.insert( aValue ); }
+        long deleteMin() { return mHeap.deleteMin(); }
+        long deleteMax() { return mHeap.deleteMax(); }
+
+    private:
+        MinMaxHeap<long> mHeap;
+    };
+
+    /**
+    * A min heap and a max heap holding the same values. A value deleted from one heap is remembered
+    * and skipped when it reaches the top of the other one.
+    */
+    class PriorityQueuePairAdapter
+    {
+    public:
+        static const char* name() { return "pq pair"; }
+
+        void build( const std::vector<long>& aValues )
+        {
+            mMin = MinQueue( std::greater<long>(), aValues );
+            mMax = MaxQueue( std::less<long>(), aValues );
+        }
+
+        void insert( long aValue )
+        {
+            mMin.push( aValue );
+            mMax.push( aValue );
+        }
+
+        // Both heaps skip the value once it reaches their top, neither one ever drops it earlier
+        void erase( long aValue )
+        {
+            mGoneFromMin[aValue]++;
+            mGoneFromMax[aValue]++;
+        }
+
+        long deleteMin()
+        {
+            skipDeleted( mMin, mGoneFromMin );
+            long value = mMin.top();
+            mMin.pop();
+            mGoneFromMax[value]++;
+            return value;
+        }
+
+        long deleteMax()
+        {
+            skipDeleted( mMax, mGoneFromMax );
+            long value = mMax.top();
+            mMax.pop();
+            mGoneFromMin[value]++;
+            return value;
+        }
+
+    private:
+        typedef std::priority_queue<long, std::vector<long>, std::greater<long> > MinQueue;
+        typedef std::priority_queue<long, std::vector<long>, std::less<long> > MaxQueue;
+        typedef std::unordered_map<long, long> Pending;
+
+        template <class Queue>
+        static void skipDeleted( Queue& aQueue, Pending& aGone )
+        {
+            while( !aGone.empty() )
+            {
+                Pending::iterator gone = aGone.find( aQueue.top() );
+
+                if( gone == aGone.end() )
+                {
+                    return;
+                }
+
+                if( --gone->second == 0 )
+                {
+                    aGone.erase( gone );
+                }
+
+                aQueue.pop();
+            }
+        }
+
+        MinQueue mMin;
+        MaxQueue mMax;
+        Pending mGoneFromMin;   //!< Values deleted through mMax that mMin still holds
+        Pending mGoneFromMax;   //!< Values deleted through mMin that mMax still holds
+    };
+
+    class MultisetAdapter
+    {
+    public:
+        static const char* name() { return "multiset"; }
+        void build( const std::vector<long>& aValues ) { mSet.insert( aValues.begin(), aValues.end() ); }
+        void insert( long aValue ) { mSet.insert( aValue ); }
+        void erase( long aValue ) { mSet.erase( mSet.find( aValue ) ); }
+
+        long deleteMin()
+        {
+            long value = *mSet.begin();
+            mSet.erase( mSet.begin() );
+            return value;
+        }
+
+        long deleteMax()
+        {
+            std::multiset<long>::iterator last = std::prev( mSet.end() );
+            long value = *last;
+            mSet.erase( last );
+            return value;
+        }
+
+    private:
+        std::multiset<long> mSet;
+    };
+
+    /**
+    * Cancels by key with tombstones, compacting at the default ratio
+    */
+    class LazyEraseAdapter
+    {
+    public:
+        static const char* name() { return "lazy erase"; }
+        void insert( long aValue ) { mHeap.insert( aValue ); }
+        void erase( long aValue ) { mHeap.eraseLazy( aValue ); }
+        long deleteMin() { return mHeap.deleteMin(); }
+        long deleteMax() { return mHeap.deleteMax(); }
+
+    private:
+        LazyEraseMinMaxHeap<long> mHeap;
+    };
+
+    /**
+    * The d-ary heap, Arity children per node
+    */
+    template <int Arity>
+    class DaryHeapAdapter
+    {
+    public:
+        static const char* name() { return ( Arity == 4 ) ? "4-ary" : ( Arity == 8 ) ? "8-ary" : "d-ary"; }
+        void build( const std::vector<long>& aValues ) { mHeap.insertRange( aValues.begin(), aValues.end() ); }
+        void insert( long aValue ) { mHeap.insert( aValue ); }
+        long deleteMin() { return mHeap.deleteMin(); }
+        long deleteMax() { return mHeap.deleteMax(); }
+
+    private:
+        MinMaxDaryHeap<long, Arity> mHeap;
+    };
+
+    /**
+    * MinMaxHeap on the interval heap engine
+    */
+    class IntervalHeapAdapter
+    {
+    public:
+        static const char* name() { return "interval"; }
+        void build( const std::vector<long>& aValues ) { mHeap.insertRange( aValues.begin(), aValues.end() ); }
+        void insert( long aValue ) { mHeap.insert( aValue ); }
+        long deleteMin() { return mHeap.deleteMin(); }
+        long deleteMax() { return mHeap.deleteMax(); }
+
+    private:
+        MinMaxHeap<long, std::less<long>, std::allocator<long>, MinMaxIntervalEngine> mHeap;
+    };
+
+    /**
+    * MinMaxHeap on one of the MinMaxStorage backends
+    */
+    template <MinMaxStorage::Policy Policy>
+    class StorageHeapAdapter
+    {
+    public:
+        typedef MinMaxHeap<long, std::less<long>, MinMaxStorageAllocator<long> > Heap;
+
+        StorageHeapAdapter() : mHeap( 0, std::less<long>(), MinMaxStorageAllocator<long>( MinMaxStorage( Policy ) ) ) {}
+        void build( const std::vector<long>& aValues ) { mHeap.insertRange( aValues.begin(), aValues.end() ); }
+        void insert( long aValue ) { mHeap.insert( aValue ); }
+        long deleteMin() { return mHeap.deleteMin(); }
+        long deleteMax() { return mHeap.deleteMax(); }
+
+    private:
+        Heap mHeap;
+    };
+
+    /**
+    * A 48 byte payload, about the size of a job descriptor
+    */
+    struct Payload48
+    {
+        long mWords[6];
+    };
+
+    /**
+    * A key and its payload in one 56 byte value, the layout a plain MinMaxHeap needs
+    */
+    struct KeyedEntry
+    {
+        long mKey;
+        Payload48 mPayload;
+    };
+
+    struct KeyedEntryLess
+    {
+        bool operator()( const KeyedEntry& aLeft, const KeyedEntry& aRight ) const { return aLeft.mKey < aRight.mKey; }
+    };
+
+    Payload48 makePayload( long aKey )
+    {
+        Payload48 payload = { { aKey, 1, 2, 3, 4, 5 } };
+        return payload;
+    }
+
+    /**
+    * The keys and payloads in two parallel arrays
+    */
+    class KeyedHeapAdapter
+    {
+    public:
+        static const char* name() { return "keyed"; }
+        void insert( long aValue ) { mHeap.insert( aValue, makePayload( aValue ) ); }
+
+        long deleteMin()
+        {
+            std::pair<long, Payload48> entry = mHeap.deleteMin();
+            return entry.first + entry.second.mWords[5];
+        }
+
+    private:
+        KeyedMinMaxHeap<long, Payload48> mHeap;
+    };
+
+    /**
+    * The keys and payloads together in one array of structs
+    */
+    class StructHeapAdapter
+    {
+    public:
+        static const char* name() { return "struct"; }
+
+        void insert( long aValue )
+        {
+            KeyedEntry entry = { aValue, makePayload( aValue ) };
+            mHeap.insert( entry );
+        }
+
+        long deleteMin()
+        {
+            KeyedEntry entry = mHeap.deleteMin();
+            return entry.mKey + entry.mPayload.mWords[5];
+        }
+
+    private:
+        MinMaxHeap<KeyedEntry, KeyedEntryLess> mHeap;
+    };
+
+    /**
+    * The concurrent containers. Each is shared by all the threads of a run.
+    */
+    class LockedHeapAdapter
+    {
+    public:
+        static const char* name() { return "mutex"; }
+
+        void insert( long aValue )
+        {
+            std::lock_guard<std::mutex> lock( mLock );
+            mHeap.insert( aValue );
+        }
+
+        bool tryPopMin( long& aValue )
+        {
+            std::lock_guard<std::mutex> lock( mLock );
+
+            if( mHeap.isEmpty() )
+            {
+                return false;
+            }
+
+            aValue = mHeap.deleteMin();
+            return true;
+        }
+
+        bool tryPopMax( long& aValue )
+        {
+            std::lock_guard<std::mutex> lock( mLock );
+
+            if( mHeap.isEmpty() )
+            {
+                return false;
+            }
+
+            aValue = mHeap.deleteMax();
+            return true;
+        }
+
+    private:
+        std::mutex mLock;
+        MinMaxHeap<long> mHeap;
+    };
+
+    template <ShardedMinMaxHeap<long>::Mode Mode>
+    class ShardedAdapter
+    {
+    public:
+        static const char* name() { return ( Mode == ShardedMinMaxHeap<long>::RELAXED ) ? "sharded" : "exact"; }
+        ShardedAdapter() : mHeap( 0, Mode ) {}
+        void insert( long aValue ) { mHeap.insert( aValue ); }
+        bool tryPopMin( long& aValue ) { return mHeap.tryPopMin( aValue ); }
+        bool tryPopMax( long& aValue ) { return mHeap.tryPopMax( aValue ); }
+        double meanRankError() const { return mHeap.relaxation().meanRankError(); }
+
+    private:
+        ShardedMinMaxHeap<long> mHeap;
+    };
+
+    class FlatCombiningAdapter
+    {
+    public:
+        static const char* name() { return "combining"; }
+        void insert( long aValue ) { mHeap.insert( aValue ); }
+        bool tryPopMin( long& aValue ) { return mHeap.tryPopMin( aValue ); }
+        bool tryPopMax( long& aValue ) { return mHeap.tryPopMax( aValue ); }
+
+    private:
+        FlatCombiningMinMaxHeap<long> mHeap;
+    };
+
+    enum Workload
+    {
+        RANDOM,
+        SORTED,
+        REVERSE,
+        DUPLICATES
+    };
+
+    const char* workloadName( Workload aWorkload )
+    {
+        switch( aWorkload )
+        {
+        case RANDOM:
+            return "random";
+        case SORTED:
+            return "sorted";
+        case REVERSE:
+            return "reverse";
+        default:
+            return "dups";
+        }
+    }
+
+    std::vector<long> makeKeys( Workload aWorkload, long aSize, unsigned aSeed )
+    {
+        std::mt19937_64 random( aSeed );
+        std::vector<long> keys( aSize );
+
+        for( long i = 0; i < aSize; i++ )
+        {
+            keys[i] = ( aWorkload == DUPLICATES ) ? static_cast<long>( random() % 16 ) : static_cast<long>( random() >> 1 );
+        }
+
+        if( aWorkload == SORTED )
+        {
+            std::sort( keys.begin(), keys.end() );
+        }
+        else if( aWorkload == REVERSE )
+        {
+            std::sort( keys.begin(), keys.end(), std::greater<long>() );
+        }
+
+        return keys;
+    }
+
+    double secondsSince( std::chrono::steady_clock::time_point aStart )
+    {
+        return std::chrono::duration<double>( std::chrono::steady_clock::now() - aStart ).count();
+    }
+
+    long repetitions( long aSize )
+    {
+        return std::max( 1L, kMinValuesPerRun / aSize );
+    }
+
+    /**
+    * The operations, each returns the nanoseconds per value. Only the timed part is measured, the
+    * containers are filled and destroyed outside of it.
+    */
+    template <class Adapter>
+    double timeInsert( const std::vector<long>& aKeys )
+    {
+        double seconds = 0;
+        long reps = repetitions( static_cast<long>( aKeys.size() ) );
+
+        for( long r = 0; r < reps; r++ )
+        {
+            Adapter container;
+            std::chrono::steady_clock::time_point start = std::chrono::steady_clock::now();
+
+            for( size_t i = 0; i < aKeys.size(); i++ )
+            {
+                container.insert( aKeys[i] );
+            }
+
+            seconds += secondsSince( start );
+        }
+
+        return seconds * 1e9 / ( static_cast<double>( reps ) * aKeys.size() );
+    }
+
+    template <class Adapter>
+    double timeBuild( const std::vector<long>& aKeys )
+    {
+        double seconds = 0;
+        long reps = repetitions( static_cast<long>( aKeys.size() ) );
+
+        for( long r = 0; r < reps; r++ )
+        {
+            Adapter container;
+            std::chrono::steady_clock::time_point start = std::chrono::steady_clock::now();
+            container.build( aKeys );
+            seconds += secondsSince( start );
+            sChecksum += container.deleteMin();
+        }
+
+        return seconds * 1e9 / ( static_cast<double>( reps ) * aKeys.size() );
+    }
+
+    // IsMax picks deleteMax, otherwise deleteMin
+    template <class Adapter, bool IsMax>
+    double timeDrain( const std::vector<long>& aKeys )
+    {
+        double seconds = 0;
+        long reps = repetitions( static_cast<long>( aKeys.size() ) );
+
+        for( long r = 0; r < reps; r++ )
+        {
+            Adapter container;
+            container.build( aKeys );
+            std::chrono::steady_clock::time_point start = std::chrono::steady_clock::now();
+
+            for( size_t i = 0; i < aKeys.size(); i++ )
+            {
+                sChecksum += IsMax ? container.deleteMax() : container.deleteMin();
+            }
+
+            seconds += secondsSince( start );
+        }
+
+        return seconds * 1e9 / ( static_cast<double>( reps ) * aKeys.size() );
+    }
+
+    // Starts half full, then inserts, deletes the minimum and deletes the maximum in a 2:1:1 ratio,
+    // so the size stays around half the key count
+    template <class Adapter>
+    double timeMixed( const std::vector<long>& aKeys )
+    {
+        long half = static_cast<long>( aKeys.size() ) / 2;
+        std::vector<long> prefill( aKeys.begin(), aKeys.begin() + half );
+        double seconds = 0;
+        long reps = repetitions( static_cast<long>( aKeys.size() ) );
+        long operations = 0;
+
+        for( long r = 0; r < reps; r++ )
+        {
+            Adapter container;
+            container.build( prefill );
+            std::chrono::steady_clock::time_point start = std::chrono::steady_clock::now();
+
+            for( long i = half; i < static_cast<long>( aKeys.size() ); i++ )
+            {
+                container.insert( aKeys[i] );
+                sChecksum += ( i & 1 ) ? container.deleteMax() : container.deleteMin();
+                container.insert( aKeys[i] ^ 1 );
+                sChecksum += ( i & 1 ) ? container.deleteMin() : container.deleteMax();
+                operations += 4;
+            }
+
+            seconds += secondsSince( start );
+        }
+
+        return seconds * 1e9 / static_cast<double>( operations );
+    }
+
+    /**
+    * The array constructor of MinMaxHeap, a copy of the keys followed by one serial bottom up build
+    */
+    double timeArrayConstructor( const std::vector<long>& aKeys )
+    {
+        double seconds = 0;
+        long reps = repetitions( static_cast<long>( aKeys.size() ) );
+
+        for( long r = 0; r < reps; r++ )
+        {
+            std::chrono::steady_clock::time_point start = std::chrono::steady_clock::now();
+            MinMaxHeap<long> heap( 0, aKeys.data(), static_cast<long>( aKeys.size() ) );
+            seconds += secondsSince( start );
+            sChecksum += heap.peekMin();
+        }
+
+        return seconds * 1e9 / ( static_cast<double>( reps ) * aKeys.size() );
+    }
+
+    // The same build on every hardware thread, the heap is identical to the serial one
+    double timeParallelConstructor( const std::vector<long>& aKeys )
+    {
+        double seconds = 0;
+        long reps = repetitions( static_cast<long>( aKeys.size() ) );
+
+        for( long r = 0; r < reps; r++ )
+        {
+            std::chrono::steady_clock::time_point start = std::chrono::steady_clock::now();
+            MinMaxHeap<long> heap( 0, aKeys.data(), static_cast<long>( aKeys.size() ), 0 );
+            seconds += secondsSince( start );
+            sChecksum += heap.peekMin();
+        }
+
+        return seconds * 1e9 / ( static_cast<double>( reps ) * aKeys.size() );
+    }
+
+    double timeQueueConstructor( const std::vector<long>& aKeys )
+    {
+        double seconds = 0;
+        long reps = repetitions( static_cast<long>( aKeys.size() ) );
+
+        for( long r = 0; r < reps; r++ )
+        {
+            Queue<long> queue;
+            queue.enqueueRange( aKeys.begin(), aKeys.end() );
+            std::chrono::steady_clock::time_point start = std::chrono::steady_clock::now();
+            MinMaxHeap<long> heap( 0, queue );
+            seconds += secondsSince( start );
+            sChecksum += heap.peekMin();
+        }
+
+        return seconds * 1e9 / ( static_cast<double>( reps ) * aKeys.size() );
+    }
+
+    double timeViewConstructor( const std::vector<long>& aKeys )
+    {
+        double seconds = 0;
+        long reps = repetitions( static_cast<long>( aKeys.size() ) );
+        std::vector<long> buffer( aKeys.size() );
+
+        for( long r = 0; r < reps; r++ )
+        {
+            std::copy( aKeys.begin(), aKeys.end(), buffer.begin() );
+            std::chrono::steady_clock::time_point start = std::chrono::steady_clock::now();
+            MinMaxHeapView<long> view( buffer.data(), buffer.data() + buffer.size() );
+            seconds += secondsSince( start );
+            sChecksum += view.peekMin();
+        }
+
+        return seconds * 1e9 / ( static_cast<double>( reps ) * aKeys.size() );
+    }
+
+    void printRow( const char* aWorkload, long aSize, const char* aOperation, double aHeap, double aPair, double aSet )
+    {
+        std::printf( "%-8s %10ld  %-12s %11.1f %11.1f %11.1f\n", aWorkload, aSize, aOperation, aHeap, aPair, aSet );
+    }
+
+    void printConstructorRow( const char* aWorkload, long aSize, const char* aOperation, double aHeap )
+    {
+        std::printf( "%-8s %10ld  %-12s %11.1f %11s %11s\n", aWorkload, aSize, aOperation, aHeap, "-", "-" );
+    }
+
+    void runSize( Workload aWorkload, long aSize )
+    {
+        std::vector<long> keys = makeKeys( aWorkload, aSize, 12345u );
+        const char* name = workloadName( aWorkload );
+
+        printRow( name, aSize, "insert", timeInsert<MinMaxHeapAdapter>( keys ), timeInsert<PriorityQueuePairAdapter>( keys ), timeInsert<MultisetAdapter>( keys ) );
+        printRow( name, aSize, "build", timeBuild<MinMaxHeapAdapter>( keys ), timeBuild<PriorityQueuePairAdapter>( keys ), timeBuild<MultisetAdapter>( keys ) );
+        printConstructorRow( name, aSize, "ctor array", timeArrayConstructor( keys ) );
+        printConstructorRow( name, aSize, "ctor threads", timeParallelConstructor( keys ) );
+        printConstructorRow( name, aSize, "ctor queue", timeQueueConstructor( keys ) );
+        printConstructorRow( name, aSize, "ctor view", timeViewConstructor( keys ) );
+        printRow( name, aSize, "deleteMin", timeDrain<MinMaxHeapAdapter, false>( keys ), timeDrain<PriorityQueuePairAdapter, false>( keys ), timeDrain<MultisetAdapter, false>( keys ) );
+        printRow( name, aSize, "deleteMax", timeDrain<MinMaxHeapAdapter, true>( keys ), timeDrain<PriorityQueuePairAdapter, true>( keys ), timeDrain<MultisetAdapter, true>( keys ) );
+        printRow( name, aSize, "mixed", timeMixed<MinMaxHeapAdapter>( keys ), timeMixed<PriorityQueuePairAdapter>( keys ), timeMixed<MultisetAdapter>( keys ) );
+    }
+
+    /**
+    * The binary heap against the 4-ary and 8-ary ones, same columns as runSize
+    */
+    void runArity( long aSize )
+    {
+        std::vector<long> keys = makeKeys( RANDOM, aSize, 12345u );
+        const char* name = workloadName( RANDOM );
+
+        printRow( name, aSize, "insert", timeInsert<MinMaxHeapAdapter>( keys ), timeInsert<DaryHeapAdapter<4> >( keys ), timeInsert<DaryHeapAdapter<8> >( keys ) );
+        printRow( name, aSize, "build", timeBuild<MinMaxHeapAdapter>( keys ), timeBuild<DaryHeapAdapter<4> >( keys ), timeBuild<DaryHeapAdapter<8> >( keys ) );
+        printRow( name, aSize, "deleteMin", timeDrain<MinMaxHeapAdapter, false>( keys ), timeDrain<DaryHeapAdapter<4>, false>( keys ), timeDrain<DaryHeapAdapter<8>, false>( keys ) );
+        printRow( name, aSize, "deleteMax", timeDrain<MinMaxHeapAdapter, true>( keys ), timeDrain<DaryHeapAdapter<4>, true>( keys ), timeDrain<DaryHeapAdapter<8>, true>( keys ) );
+        printRow( name, aSize, "mixed", timeMixed<MinMaxHeapAdapter>( keys ), timeMixed<DaryHeapAdapter<4> >( keys ), timeMixed<DaryHeapAdapter<8> >( keys ) );
+    }
+
+    void printEngineRow( const char* aWorkload, long aSize, const char* aOperation, double aMinMax, double aInterval )
+    {
+        std::printf( "%-8s %10ld  %-12s %11.1f %11.1f\n", aWorkload, aSize, aOperation, aMinMax, aInterval );
+    }
+
+    /**
+    * The min-max heap engine against the interval heap engine
+    */
+    void runEngine( Workload aWorkload, long aSize )
+    {
+        std::vector<long> keys = makeKeys( aWorkload, aSize, 12345u );
+        const char* name = workloadName( aWorkload );
+
+        printEngineRow( name, aSize, "insert", timeInsert<MinMaxHeapAdapter>( keys ), timeInsert<IntervalHeapAdapter>( keys ) );
+        printEngineRow( name, aSize, "build", timeBuild<MinMaxHeapAdapter>( keys ), timeBuild<IntervalHeapAdapter>( keys ) );
+        printEngineRow( name, aSize, "deleteMin", timeDrain<MinMaxHeapAdapter, false>( keys ), timeDrain<IntervalHeapAdapter, false>( keys ) );
+        printEngineRow( name, aSize, "deleteMax", timeDrain<MinMaxHeapAdapter, true>( keys ), timeDrain<IntervalHeapAdapter, true>( keys ) );
+        printEngineRow( name, aSize, "mixed", timeMixed<MinMaxHeapAdapter>( keys ), timeMixed<IntervalHeapAdapter>( keys ) );
+    }
+
+    /**
+    * Inserts every key with its payload, then takes them all out again through deleteMin
+    * @return Nanoseconds per entry, one insert and one deleteMin
+    */
+    template <class Adapter>
+    double timeKeyed( const std::vector<long>& aKeys )
+    {
+        double seconds = 0;
+        long reps = repetitions( static_cast<long>( aKeys.size() ) );
+
+        for( long r = 0; r < reps; r++ )
+        {
+            Adapter container;
+            std::chrono::steady_clock::time_point start = std::chrono::steady_clock::now();
+
+            for( size_t i = 0; i < aKeys.size(); i++ )
+            {
+                container.insert( aKeys[i] );
+            }
+
+            for( size_t i = 0; i < aKeys.size(); i++ )
+            {
+                sChecksum += container.deleteMin();
+            }
+
+            seconds += secondsSince( start );
+        }
+
+        return seconds * 1e9 / ( static_cast<double>( reps ) * aKeys.size() );
+    }
+
+    void runKeyed( long aSize )
+    {
+        std::vector<long> keys = makeKeys( RANDOM, aSize, 12345u );
+
+        std::printf( "%10ld %11.1f %11.1f\n", aSize, timeKeyed<KeyedHeapAdapter>( keys ), timeKeyed<StructHeapAdapter>( keys ) );
+    }
+
+    void printStorageRow( long aSize, const char* aOperation, const double aTimes[5] )
+    {
+        std::printf( "%10ld  %-12s %11.1f %11.1f %11.1f %11.1f %11.1f\n", aSize, aOperation, aTimes[0], aTimes[1], aTimes[2], aTimes[3], aTimes[4] );
+    }
+
+    /**
+    * A fresh heap per round, filled with aSize values and then emptied from both ends the way a
+    * request handler uses one
+    */
+    template <class Heap>
+    double timeSmallRounds( const std::vector<long>& aKeys, long aSize )
+    {
+        long rounds = static_cast<long>( aKeys.size() ) / aSize;
+        std::chrono::steady_clock::time_point start = std::chrono::steady_clock::now();
+
+        for( long round = 0; round < rounds; round++ )
+        {
+            Heap heap;
+
+            for( long i = 0; i < aSize; i++ )
+            {
+                heap.insert( aKeys[round * aSize + i] );
+            }
+
+            while( !heap.isEmpty() )
+            {
+                sChecksum += heap.deleteMin();
+
+                if( !heap.isEmpty() )
+                {
+                    sChecksum += heap.deleteMax();
+                }
+            }
+        }
+
+        return secondsSince( start ) * 1e9 / ( static_cast<double>( rounds ) * aSize );
+    }
+
+    void runSmall( long aSize )
+    {
+        std::vector<long> keys = makeKeys( RANDOM, 1L << 22, 12345u );
+
+        std::printf( "%10ld %11.1f %11.1f\n", aSize, timeSmallRounds<MinMaxHeap<long> >( keys, aSize ), timeSmallRounds<SmallMinMaxHeap<long, 64> >( keys, aSize ) );
+    }
+
+    /**
+    * Inserts every key, cancels three in ten of them by key and drains the rest from both ends, the
+    * way an order book or a timer wheel sees its entries
+    */
+    template <class Adapter>
+    double timeCancel( const std::vector<long>& aKeys )
+    {
+        double seconds = 0;
+        long reps = repetitions( static_cast<long>( aKeys.size() ) );
+
+        for( long r = 0; r < reps; r++ )
+        {
+            Adapter container;
+            std::chrono::steady_clock::time_point start = std::chrono::steady_clock::now();
+            long live = 0;
+
+            for( size_t i = 0; i < aKeys.size(); i++ )
+            {
+                container.insert( aKeys[i] );
+                live++;
+
+                if( i % 10 == 9 )
+                {
+                    for( size_t j = i - 9; j < i - 6; j++ )
+                    {
+                        container.erase( aKeys[j] );
+                        live--;
+                    }
+                }
+            }
+
+            for( ; live > 0; live-- )
+            {
+                sChecksum += ( live & 1 ) ? container.deleteMax() : container.deleteMin();
+            }
+
+            seconds += secondsSince( start );
+        }
+
+        return seconds * 1e9 / ( static_cast<double>( reps ) * aKeys.size() );
+    }
+
+    void runCancel( long aSize )
+    {
+        std::vector<long> keys = makeKeys( RANDOM, aSize, 12345u );
+
+        std::printf( "%10ld %11.1f %11.1f %11.1f\n", aSize, timeCancel<LazyEraseAdapter>( keys ), timeCancel<PriorityQueuePairAdapter>( keys ), timeCancel<MultisetAdapter>( keys ) );
+    }
+
+    /**
+    * MinMaxHeap over every storage backend, NUMA bound to node 0
+    */
+    void runStorage( long aSize )
+    {
+        std::vector<long> keys = makeKeys( RANDOM, aSize, 12345u );
+        double build[5] = { timeBuild<StorageHeapAdapter<MinMaxStorage::DEFAULT> >( keys ), timeBuild<StorageHeapAdapter<MinMaxStorage::ALIGNED> >( keys ),
+                            timeBuild<StorageHeapAdapter<MinMaxStorage::HUGE_PAGES> >( keys ), timeBuild<StorageHeapAdapter<MinMaxStorage::HUGETLB> >( keys ),
+                            timeBuild<StorageHeapAdapter<MinMaxStorage::NUMA_NODE> >( keys ) };
+        double deleteMin[5] = { timeDrain<StorageHeapAdapter<MinMaxStorage::DEFAULT>, false>( keys ), timeDrain<StorageHeapAdapter<MinMaxStorage::ALIGNED>, false>( keys ),
+                                timeDrain<StorageHeapAdapter<MinMaxStorage::HUGE_PAGES>, false>( keys ), timeDrain<StorageHeapAdapter<MinMaxStorage::HUGETLB>, false>( keys ),
+                                timeDrain<StorageHeapAdapter<MinMaxStorage::NUMA_NODE>, false>( keys ) };
+        double mixed[5] = { timeMixed<StorageHeapAdapter<MinMaxStorage::DEFAULT> >( keys ), timeMixed<StorageHeapAdapter<MinMaxStorage::ALIGNED> >( keys ),
+                            timeMixed<StorageHeapAdapter<MinMaxStorage::HUGE_PAGES> >( keys ), timeMixed<StorageHeapAdapter<MinMaxStorage::HUGETLB> >( keys ),
+                            timeMixed<StorageHeapAdapter<MinMaxStorage::NUMA_NODE> >( keys ) };
+
+        printStorageRow( aSize, "build", build );
+        printStorageRow( aSize, "deleteMin", deleteMin );
+        printStorageRow( aSize, "mixed", mixed );
+    }
+
+    /**
+    * Every thread inserts its share of aKeys, popping the minimum and the maximum after every second
+    * insert, so the container stays about half as large as the number of keys inserted so far
+    * @return Millions of operations per second over all threads
+    */
+    template <class Adapter>
+    double timeConcurrent( Adapter& aContainer, const std::vector<long>& aKeys, long aThreads )
+    {
+        std::vector<std::thread> threads;
+        std::vector<long> sums( aThreads, 0 );
+        long perThread = static_cast<long>( aKeys.size() ) / aThreads;
+        std::chrono::steady_clock::time_point start = std::chrono::steady_clock::now();
+
+        for( long t = 0; t < aThreads; t++ )
+        {
+            threads.push_back( std::thread( [&aContainer, &aKeys, &sums, perThread, t]()
+            {
+                long value = 0;
+
+                for( long i = t * perThread; i < ( t + 1 ) * perThread; i++ )
+                {
+                    aContainer.insert( aKeys[i] );
+
+                    if( i & 1 )
+                    {
+                        sums[t] += aContainer.tryPopMin( value ) ? value : 0;
+                        sums[t] += aContainer.tryPopMax( value ) ? value : 0;
+                    }
+                }
+            } ) );
+        }
+
+        for( size_t t = 0; t < threads.size(); t++ )
+        {
+            threads[t].join();
+            sChecksum += sums[t];
+        }
+
+        return 2.0 * static_cast<double>( perThread * aThreads ) / secondsSince( start ) / 1e6;
+    }
+
+    template <class Adapter>
+    double timeConcurrent( const std::vector<long>& aKeys, long aThreads )
+    {
+        Adapter container;
+        return timeConcurrent( container, aKeys, aThreads );
+    }
+
+    void runConcurrent( long aSize )
+    {
+        std::vector<long> keys = makeKeys( RANDOM, aSize, 54321u );
+        long hardwareThreads = std::max( 1L, static_cast<long>( std::thread::hardware_concurrency() ) );
+
+        std::printf( "\nmillions of operations per second, %ld keys\n", aSize );
+        std::printf( "%8s %11s %11s %11s %11s %11s\n", "threads", LockedHeapAdapter::name(), ShardedAdapter<ShardedMinMaxHeap<long>::RELAXED>::name(), ShardedAdapter<ShardedMinMaxHeap<long>::EXACT>::name(), FlatCombiningAdapter::name(), "rank error" );
+
+        for( long threads = 1; threads <= 4 * hardwareThreads; threads *= 2 )
+        {
+            ShardedAdapter<ShardedMinMaxHeap<long>::RELAXED> sharded;
+            double locked = timeConcurrent<LockedHeapAdapter>( keys, threads );
+            double relaxed = timeConcurrent( sharded, keys, threads );
+            double exact = timeConcurrent<ShardedAdapter<ShardedMinMaxHeap<long>::EXACT> >( keys, threads );
+            double combining = timeConcurrent<FlatCombiningAdapter>( keys, threads );
+            std::printf( "%8ld %11.2f %11.2f %11.2f %11.2f %11.2f\n", threads, locked, relaxed, exact, combining, sharded.meanRankError() );
+        }
+    }
+}
+
+// The sizes step from 1K longs (8 KB, L1) through 16K (L2) and 256K (2 MB, around the LLC of small parts)
+// to 4M (32 MB, beyond most LLCs), each size is 16 times the previous one
+int main( int argc, char* argv[] )
+{
+    long largestSize = ( argc > 1 ) ? std::atol( argv[1] ) : ( 1L << 22 );
+    const Workload workloads[] = { RANDOM, SORTED, REVERSE, DUPLICATES };
+
+    std::printf( "nanoseconds per value\n" );
+    std::printf( "%-8s %10s  %-12s %11s %11s %11s\n", "keys", "size", "operation", MinMaxHeapAdapter::name(), PriorityQueuePairAdapter::name(), MultisetAdapter::name() );
+
+    for( size_t w = 0; w < sizeof( workloads ) / sizeof( workloads[0] ); w++ )
+    {
+        for( long size = 1L << 10; size <= largestSize; size <<= 4 )
+        {
+            runSize( workloads[w], size );
+        }
+    }
+
+    std::printf( "\nnanoseconds per value by arity\n" );
+    std::printf( "%-8s %10s  %-12s %11s %11s %11s\n", "keys", "size", "operation", MinMaxHeapAdapter::name(), DaryHeapAdapter<4>::name(), DaryHeapAdapter<8>::name() );
+
+    for( long size = 1L << 10; size <= largestSize; size <<= 4 )
+    {
+        runArity( size );
+    }
+
+    std::printf( "\nnanoseconds per value by storage, random keys\n" );
+    std::printf( "%10s  %-12s %11s %11s %11s %11s %11s\n", "size", "operation", "default", "aligned", "huge pages", "hugetlb", "numa 0" );
+
+    for( long size = 1L << 14; size <= largestSize; size <<= 4 )
+    {
+        runStorage( size );
+    }
+
+    runConcurrent( std::min( largestSize, 1L << 20 ) );
+
+    std::printf( "\nnanoseconds per value by engine\n" );
+    std::printf( "%-8s %10s  %-12s %11s %11s\n", "keys", "size", "operation", MinMaxHeapAdapter::name(), IntervalHeapAdapter::name() );
+
+    for( size_t w = 0; w < sizeof( workloads ) / sizeof( workloads[0] ); w++ )
+    {
+        for( long size = 1L << 10; size <= largestSize; size <<= 4 )
+        {
+            runEngine( workloads[w], size );
+        }
+    }
+
+    std::printf( "\nnanoseconds per value, a fresh heap of size random keys per round\n" );
+    std::printf( "%10s %11s %11s\n", "size", "MinMaxHeap", "small 64" );
+
+    for( long size = 8; size <= 64; size <<= 1 )
+    {
+        runSmall( size );
+    }
+
+    std::printf( "\nnanoseconds per value inserted, 30%% cancelled by key, random keys\n" );
+    std::printf( "%10s %11s %11s %11s\n", "size", LazyEraseAdapter::name(), PriorityQueuePairAdapter::name(), MultisetAdapter::name() );
+
+    for( long size = 1L << 10; size <= largestSize; size <<= 4 )
+    {
+        runCancel( size );
+    }
+
+    std::printf( "\nnanoseconds per entry, insert then deleteMin, random keys with a 48 byte payload\n" );
+    std::printf( "%10s %11s %11s\n", "size", KeyedHeapAdapter::name(), StructHeapAdapter::name() );
+
+    for( long size = 1L << 10; size <= largestSize; size <<= 4 )
+    {
+        runKeyed( size );
+    }
+
+    std::printf( "checksum %ld\n", sChecksum );
+    return 0;
+}
@@ -1,42 +1,34 @@
 #include <iostream>
-#include <fstream>
 #include "MinMaxHeap.h"
+#include "MinMaxHeapLoader.h"
 
 long getChoice();
-void menuLoop( MinMaxHeap& minMaxHeap );
-void insertItem( MinMaxHeap& minMaxHeap );
-void deletemax( MinMaxHeap& minMaxHeap );
-void deletemin( MinMaxHeap& minMaxHeap );
-void printLevelOrder( MinMaxHeap& minMaxHeap );
+void menuLoop( MinMaxHeap<long>& minMaxHeap );
+void insertItem( MinMaxHeap<long>& minMaxHeap );
+void deletemax( MinMaxHeap<long>& minMaxHeap );
+void deletemin( MinMaxHeap<long>& minMaxHeap );
+void printLevelOrder( MinMaxHeap<long>& minMaxHeap );
 
 int main()
 {
-    long anInteger;
-    std::ifstream fileReader( "data.txt" );
+    MinMaxHeap<long> minMaxHeap( 200 );
 
-    if( fileReader.is_open() )
+    try
     {
-        Queue<long> readValues;
-
-        while( fileReader >> anInteger )
-        {
-            readValues.enqueue( anInteger );
-        }
-
-        MinMaxHeap minMaxHeap( 200, readValues );
-
-        menuLoop( minMaxHeap );
-        fileReader.close();
+        loadIntegers( "data.txt", minMaxHeap );
     }
-    else
+    catch( PrecondViolatedExcep& e )
     {
         std::cout << "Error reading file\n";
+        return 0;
     }
 
+    menuLoop( minMaxHeap );
+
     return 0;
 }
 
-void menuLoop( MinMaxHeap& minMaxHeap )
+void menuLoop( MinMaxHeap<long>& minMaxHeap )
 {
     long choice = 0;
 
@@ -87,7 +79,7 @@ long getChoice()
     return choice;
 }
 
-void insertItem( MinMaxHeap& minMaxHeap )
+void insertItem( MinMaxHeap<long>& minMaxHeap )
 {
     std::cout << "Choose a number to be added to the heap\n";
     long number;
@@ -95,23 +87,31 @@ void insertItem( MinMaxHeap& minMaxHeap )
     minMaxHeap.insert( number );
 }
 
-void deletemin( MinMaxHeap& minMaxHeap )
+void deletemin( MinMaxHeap<long>& minMaxHeap )
 {
-    if( minMaxHeap.deleteMin() == -1 )
+    if( minMaxHeap.isEmpty() )
     {
         std::cout << "The heap is empty\n";
     }
+    else
+    {
+        minMaxHeap.deleteMin();
+    }
 }
 
-void deletemax( MinMaxHeap& minMaxHeap )
+void deletemax( MinMaxHeap<long>& minMaxHeap )
 {
-    if( minMaxHeap.deleteMax() == -1 )
+    if( minMaxHeap.isEmpty() )
     {
         std::cout << "The heap is empty\n";
     }
+    else
+    {
+        minMaxHeap.deleteMax();
+    }
 }
 
-void printLevelOrder( MinMaxHeap& minMaxHeap )
+void printLevelOrder( MinMaxHeap<long>& minMaxHeap )
 {
     std::cout << "Level Order:\n";
     minMaxHeap.levelOrderDisplay();